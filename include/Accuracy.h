@@ -0,0 +1,105 @@
+/* -------- Accuracy.h -----------
+
+   Accuracy Regression Harness Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   The harness sweeps random and adversarial inputs through every
+   registered implementation of an operation and reports the error
+   (in ULPs) against an extended precision reference, side by side
+   with the throughput of each implementation.
+
+   Each suite has a fixed input and output layout (scalars per sample):
+
+      ACCURACY_NORM     in: x y z                  out: x y z
+      ACCURACY_ROTATE   in: d1.xyz d2.xyz          out: upper 3x3 of setRotate(d1, d2)
+      ACCURACY_INVERSE  in: 4x4 row major          out: 4x4 row major
+      ACCURACY_ANGLE    in: d1.xyz d2.xyz          out: angle
+
+   The error of a sample is the largest coordinate error divided by
+   the ULP of the largest reference coordinate, so coordinates that
+   should be zero do not blow up the figures.
+
+*/
+
+#ifndef ACCURACY_H
+#define ACCURACY_H
+
+#include <stdio.h>
+#include <Vector.h>
+
+enum AccuracySuite {
+   ACCURACY_NORM,
+   ACCURACY_ROTATE,
+   ACCURACY_INVERSE,
+   ACCURACY_ANGLE,
+   ACCURACY_SUITES
+   } ;
+
+			/// An implementation under test: n samples from in to out.
+typedef void (*AccuracyKernel)(scalar const* in, scalar* out, int n) ;
+
+class AccuracyResult {
+   public:
+      AccuracySuite suite ;
+      const char*   variant ;
+      const char*   inputs ;     // "random" or "adversarial"
+      long          count ;
+      long          nonFinite ;  // non-finite results where the reference is finite
+      double        maxUlp ;
+      double        meanUlp ;
+      double        mops ;       // millions of samples per second
+   } ;
+
+class AccuracyHarness {
+   public:
+      enum { MAX_VARIANTS = 32, MAX_RESULTS = 2*MAX_VARIANTS } ;
+
+			/// Create a harness of n samples per test from seed s, with the library implementations (and their float versions) registered.
+      AccuracyHarness(int n = 100000, unsigned long s = 1) ;
+
+			/// Register an implementation. If single, errors are counted in float ULPs.
+      bool addVariant(AccuracySuite suite, const char* name,
+                      AccuracyKernel kernel, bool single = false) ;
+			/// Run every variant over random and adversarial inputs. Print a table to out unless NULL.
+      int run(FILE* out = stdout) ;
+
+			/// Number of results produced by the last run().
+      int resultCount() const { return nResults ; }
+			/// Result i of the last run(). (0 <= i < resultCount())
+      AccuracyResult const& result(int i) const { return results[i] ; }
+
+			/// Name of a suite.
+      static const char* suiteName(AccuracySuite suite) ;
+			/// Distance between two doubles in units in the last place.
+      static double ulps(double a, double b) ;
+			/// Size of one unit in the last place at x, in double or float precision.
+      static double ulp(double x, bool single = false) ;
+
+   private:
+      class Variant {
+         public:
+            AccuracySuite  suite ;
+            const char*    name ;
+            AccuracyKernel kernel ;
+            bool           single ;
+         } ;
+
+      int            samples ;
+      unsigned long  seed ;
+      int            nVariants ;
+      Variant        variants[MAX_VARIANTS] ;
+      int            nResults ;
+      AccuracyResult results[MAX_RESULTS] ;
+
+      void measure(Variant const& v, const char* inputs, scalar const* in,
+                   long double const* ref, int n) ;
+   } ;
+
+#endif
@@ -0,0 +1,164 @@
+/* -------- Animation.h -----------
+
+   Keyframe Animation Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   A track is a list of keyframes: increasing times and a value at
+   each. Sampling between two keys interpolates (linearly for vectors,
+   by slerp for rotations); before the first key or after the last
+   the end value holds.
+
+   Finding the keys around t is what costs. Each sample() takes a
+   cursor - the segment found last time - and looks there and at the
+   next segment before searching, so playing forward (or holding
+   still) is O(1) per sample, and only a jump costs a binary search.
+
+      TransformTrack track ;             // translation, rotation, scale
+      TrackCursor cursor ;
+      for (scalar t = 0 ; ... ; t += dt)
+         mx = track.sample(t, cursor) ;
+
+   sampleTracks() does the same for many objects at once, in
+   parallel, straight into an array of Transforms.
+
+   A Transform blended entry by entry (operator+, scalar operator*)
+   is not a rotation any more. A Decomposition splits one back into
+   the scale, rotation and translation Transform::set() builds it
+   from, so two of them blend part by part, as the tracks do:
+
+      Decomposition open(mx0), close(mx1) ;
+      interpolateBatch(open, close, times, xforms, n) ;   // motion blur
+
+*/
+
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <vector>
+#include <Vector.h>
+
+			/// The segment i with times[i] <= t < times[i+1], starting at cursor. (-1 before the first key.)
+int findSegment(scalar const* times, int n, scalar t, int& cursor) ;
+
+class Vector3Track {
+   public:
+      std::vector<scalar>  times ;
+      std::vector<Vector3> values ;
+
+			/// Append a key. (Times must increase.)
+      void add(scalar t, Vector3 const& v) { times.push_back(t) ; values.push_back(v) ; }
+			/// The value at t (linear interpolation). With no keys, the default.
+      Vector3 sample(scalar t, int& cursor, Vector3 const& none = Vector3()) const ;
+   } ;
+
+class RotationTrack {
+   public:
+      std::vector<scalar>     times ;
+      std::vector<Quaternion> values ;
+
+			/// Append a key. (Times must increase.)
+      void add(scalar t, Quaternion const& q) { times.push_back(t) ; values.push_back(q) ; }
+			/// The rotation at t (slerp). With no keys, the identity.
+      Quaternion sample(scalar t, int& cursor) const ;
+   } ;
+
+			/// Where the last samples of a TransformTrack were found.
+class TrackCursor {
+   public:
+      int translation ;
+      int rotation ;
+      int scale ;
+
+      constexpr TrackCursor() : translation(0), rotation(0), scale(0) { }
+   } ;
+
+/*------------------------------------------------------------
+ * Scale, then rotate, then translate: the order Transform::set()
+ * composes them in. Channels without keys are the identity.
+ */
+class TransformTrack {
+   public:
+      Vector3Track  translation ;
+      RotationTrack rotation ;
+      Vector3Track  scale ;
+
+			/// The transform at t.
+      Transform sample(scalar t, TrackCursor& cursor) const ;
+   } ;
+
+			/// out[i] = tracks[i].sample(t, cursors[i]) for 0 <= i < n, in parallel.
+void sampleTracks(TransformTrack const* tracks, TrackCursor* cursors,
+                  int n, scalar t, Transform* out) ;
+			/// out[i] = tracks[i].sample(times[i], cursors[i]) for 0 <= i < n, in parallel.
+void sampleTracks(TransformTrack const* tracks, TrackCursor* cursors,
+                  int n, scalar const* times, Transform* out) ;
+
+/*------------------------------------------------------------
+ * The parts of Transform::set(): scale (x, y, z, and w, the
+ * homogeneous divisor), rotation and translation. Shear has no
+ * part; the rotation of a sheared transform is the nearest one
+ * and the scale the lengths of its rows.
+ */
+class Decomposition {
+   public:
+      Vector3    translation ;
+      Quaternion rotation ;
+      Vector4    scale ;
+
+			/// Create the identity.
+      constexpr Decomposition() : translation(), rotation(), scale(1, 1, 1, 1) { }
+			/// Create from the parts.
+      constexpr Decomposition(Vector3 const& t, Quaternion const& q, Vector4 const& s)
+         : translation(t), rotation(q), scale(s) { }
+			/// Decompose mx. (Assumed affine but for xform[3][3].)
+      explicit Decomposition(Transform const& mx) ;
+
+			/// The rotation as the directions Transform::set() takes.
+      void directions(Direction& rx, Direction& ry, Direction& rz) const ;
+			/// The transform of the parts (as Transform::set() makes it).
+      constexpr Transform transform() const ;
+   } ;
+
+			/// Blend a (t=0) to b (t=1): scale and translation linearly, rotation by slerp.
+Decomposition interpolate(Decomposition const& a, Decomposition const& b, scalar t) ;
+			/// out[i] = interpolate(a, b, times[i]).transform() for 0 <= i < n.
+void interpolateBatch(Decomposition const& a, Decomposition const& b,
+                      scalar const* times, Transform* out, int n) ;
+
+			/// The transform that scales by s, rotates by q, then translates by t.
+constexpr Transform compose(Vector3 const& s, Quaternion const& q, Vector3 const& t) ;
+
+/* -----------------------------------------------------------
+ *  Inline definitions
+ */
+
+constexpr Transform compose(Vector3 const& s, Quaternion const& q, Vector3 const& t) {
+   Transform mx = q.transform() ;
+   for (int c = 0 ; c < 3 ; c++) {
+      mx.xform[0][c] *= s.x ;
+      mx.xform[1][c] *= s.y ;
+      mx.xform[2][c] *= s.z ;
+      }
+   mx.xform[3][0] = t.x ;
+   mx.xform[3][1] = t.y ;
+   mx.xform[3][2] = t.z ;
+   return mx ;
+   }
+
+			// compose() has w = 1; set() divides row 3 by scale.w.
+constexpr Transform Decomposition::transform() const {
+   Transform mx = compose(Vector3(scale.x, scale.y, scale.z), rotation, translation) ;
+   const scalar d = (scale.w != 0) ? 1/scale.w : 0 ;
+   for (int c = 0 ; c < 4 ; c++)
+      mx.xform[3][c] *= d ;
+   return mx ;
+   }
+
+#endif
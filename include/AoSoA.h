@@ -0,0 +1,355 @@
+/* -------- AoSoA.h -----------
+
+   Blocked Vector Array Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   An array of Position (AoS) keeps each vector's coordinates
+   together but puts the x's of neighbours 24 bytes apart, so a
+   loop over it cannot use vector loads; a Vector3SoA batch (SoA,
+   Batch.h) is the reverse. A Vector3Array is between the two:
+   blocks of AOSOA_LANES vectors, each block stored as AOSOA_LANES
+   x's, then the y's, then the z's. A block is one SIMD loop of
+   fixed width, and a whole vector is still within one block.
+
+      Vector3Array<Position> points(n) ;
+      points[i] = p ;                       // per element, as before
+      points[i].x += 1 ;
+      Position q = points[i] ;
+      points.transform(mx) ;                // a block at a time
+      points.forBlocks([&](Vector3SoA const& v, int count) {
+         normalizeBatch(v, v, count) ;      // any batch kernel
+         }) ;
+
+   Element access goes through a proxy, Vector3Ref, which converts
+   to and from the element type and has x, y and z members (scalar
+   references), so code written for Position arrays keeps
+   compiling. The lanes past the last vector start out zero; the
+   bulk operations compute on them too (and resize() clears them).
+
+*/
+
+#ifndef AOSOA_H
+#define AOSOA_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <iterator>
+#include <new>
+#include <Batch.h>
+
+			// Vectors per block: 8 fills an AVX-512 register with doubles.
+#ifndef AOSOA_LANES
+#define AOSOA_LANES 8
+#endif
+
+			/// AOSOA_LANES vectors, coordinate by coordinate.
+class Vector3Block {
+   public:
+      scalar x[AOSOA_LANES] ;
+      scalar y[AOSOA_LANES] ;
+      scalar z[AOSOA_LANES] ;
+
+			/// The block as a batch of count vectors.
+      Vector3SoA lanes() { return Vector3SoA(x, y, z) ; }
+   } ;
+
+			/// The element type T made from coordinates.
+template <class T> inline T vector3Value(scalar a, scalar b, scalar c) { return T(a, b, c) ; }
+template <> inline Direction vector3Value<Direction>(scalar a, scalar b, scalar c) { return Direction::Unit(a, b, c) ; }
+
+/*------------------------------------------------------------
+ * A reference to one vector of a Vector3Array: x, y and z refer
+ * to its lanes. Assigning to the proxy stores into the array.
+ */
+template <class T>
+class Vector3Ref {
+   public:
+      scalar& x ;
+      scalar& y ;
+      scalar& z ;
+
+      Vector3Ref(Vector3Block& b, int lane) : x(b.x[lane]), y(b.y[lane]), z(b.z[lane]) { }
+      Vector3Ref(Vector3Ref const& r) = default ;
+
+			/// The vector referred to.
+      operator T() const { return vector3Value<T>(x, y, z) ; }
+      T value() const { return vector3Value<T>(x, y, z) ; }
+
+			/// Store v (or another element's value).
+      Vector3Ref& operator=(T const& v) { x = v.x ; y = v.y ; z = v.z ; return *this ; }
+      Vector3Ref& operator=(Vector3Ref const& r) { return *this = r.value() ; }
+			/// Move by v.
+      Vector3Ref& operator+=(Vector3 const& v) { x += v.x ; y += v.y ; z += v.z ; return *this ; }
+      Vector3Ref& operator-=(Vector3 const& v) { x -= v.x ; y -= v.y ; z -= v.z ; return *this ; }
+			/// Scale by s.
+      Vector3Ref& operator*=(scalar s) { x *= s ; y *= s ; z *= s ; return *this ; }
+   } ;
+
+			/// Swap the vectors two proxies refer to (for std::sort and the like).
+template <class T>
+inline void swap(Vector3Ref<T> a, Vector3Ref<T> b) {
+   const T t = a ;
+   a = b ;
+   b = t ;
+   }
+
+template <class T>
+class Vector3Array {
+   public:
+			/// A random access iterator over the elements of an A (Vector3Array or Vector3Array const);
+			/// dereferencing gives an R (a Vector3Ref, or for a const array the value).
+      template <class A, class R>
+      class Iterator {
+         public:
+            typedef std::random_access_iterator_tag iterator_category ;
+            typedef T                               value_type ;
+            typedef ptrdiff_t                       difference_type ;
+            typedef R                               reference ;
+			/// What operator-> gives: holds the element proxy, so it->x works.
+            class pointer {
+               public:
+                  explicit pointer(R const& r) : ref(r) { }
+                  R const* operator->() const { return &ref ; }
+               private:
+                  R ref ;
+               } ;
+
+            Iterator(A* a = 0, int i = 0) : array(a), index(i) { }
+			/// A const_iterator from an iterator.
+            template <class B, class S>
+            Iterator(Iterator<B, S> const& o) : array(o.array), index(o.index) { }
+
+            reference operator*() const { return (*array)[index] ; }
+            pointer   operator->() const { return pointer((*array)[index]) ; }
+            reference operator[](difference_type d) const { return (*array)[index + (int)d] ; }
+            Iterator& operator++() { index++ ; return *this ; }
+            Iterator& operator--() { index-- ; return *this ; }
+            Iterator  operator++(int) { Iterator r(*this) ; index++ ; return r ; }
+            Iterator  operator--(int) { Iterator r(*this) ; index-- ; return r ; }
+            Iterator& operator+=(difference_type d) { index += (int)d ; return *this ; }
+            Iterator& operator-=(difference_type d) { index -= (int)d ; return *this ; }
+            Iterator  operator+ (difference_type d) const { return Iterator(array, index + (int)d) ; }
+            Iterator  operator- (difference_type d) const { return Iterator(array, index - (int)d) ; }
+            friend Iterator operator+(difference_type d, Iterator const& i) { return i + d ; }
+            difference_type operator-(Iterator const& o) const { return index - o.index ; }
+            bool operator==(Iterator const& o) const { return index == o.index ; }
+            bool operator!=(Iterator const& o) const { return index != o.index ; }
+            bool operator< (Iterator const& o) const { return index <  o.index ; }
+            bool operator> (Iterator const& o) const { return index >  o.index ; }
+            bool operator<=(Iterator const& o) const { return index <= o.index ; }
+            bool operator>=(Iterator const& o) const { return index >= o.index ; }
+
+         private:
+            template <class B, class S> friend class Iterator ;
+            A*  array ;
+            int index ;
+         } ;
+      typedef Iterator<Vector3Array, Vector3Ref<T> > iterator ;
+      typedef Iterator<Vector3Array const, T>        const_iterator ;
+
+			/// Create n zero vectors.
+      explicit Vector3Array(int n = 0) : blocks(0), memory(0), count(0), capacity(0) { resize(n) ; }
+			/// Create from n vectors.
+      Vector3Array(T const* v, int n) : Vector3Array(n) { load(v, n) ; }
+      Vector3Array(Vector3Array const& a) : Vector3Array(a.count) { copy(a) ; }
+      Vector3Array& operator=(Vector3Array const& a) { if (this != &a) { resize(a.count) ; copy(a) ; } return *this ; }
+      ~Vector3Array() { free(memory) ; }
+
+			/// Number of vectors.
+      int size() const { return count ; }
+			/// Number of blocks.
+      int blockCount() const { return (count + AOSOA_LANES - 1)/AOSOA_LANES ; }
+			/// Block b (vectors AOSOA_LANES*b on).
+      Vector3Block&       block(int b)       { return blocks[b] ; }
+      Vector3Block const& block(int b) const { return blocks[b] ; }
+			/// Change the number of vectors. New vectors are zero.
+      void resize(int n) ;
+
+			/// Element i.
+      Vector3Ref<T> operator[](int i) { return Vector3Ref<T>(blocks[i/AOSOA_LANES], i % AOSOA_LANES) ; }
+      T operator[](int i) const {
+         Vector3Block const& b = blocks[i/AOSOA_LANES] ;
+         const int k = i % AOSOA_LANES ;
+         return vector3Value<T>(b.x[k], b.y[k], b.z[k]) ;
+         }
+      iterator       begin()        { return iterator(this, 0) ; }
+      iterator       end()          { return iterator(this, count) ; }
+      const_iterator begin()  const { return const_iterator(this, 0) ; }
+      const_iterator end()    const { return const_iterator(this, count) ; }
+      const_iterator cbegin() const { return begin() ; }
+      const_iterator cend()   const { return end() ; }
+
+			/// Copy in n vectors (AoS), from element 0.
+      void load(T const* v, int n) ;
+			/// Copy out n vectors (AoS), from element 0.
+      void store(T* v, int n) const ;
+			/// Copy in n vectors of a batch.
+      void load(Vector3SoA const& v, int n) ;
+			/// Copy out n vectors to a batch.
+      void store(Vector3SoA const& v, int n) const ;
+
+			/// body(lanes, n) for each block, n its vectors in use. The body may also work on all AOSOA_LANES lanes.
+      template <class F> void forBlocks(F const& body) ;
+
+			/// Transform every element by mx, as T * mx: positions with the translation, directions normalized again. (mx affine.)
+      void transform(Transform const& mx) ;
+			/// Normalize every element (zero stays zero).
+      void normalize() ;
+			/// out[i] = element i dot v for 0 <= i < size().
+      void dot(Vector3 const& v, scalar* out) const ;
+
+   private:
+      Vector3Block* blocks ;     // SIMD_ALIGN aligned, in memory
+      void*         memory ;
+      int           count ;
+      int           capacity ;   // blocks
+
+      void copy(Vector3Array const& a) { memcpy(blocks, a.blocks, a.blockCount()*sizeof(Vector3Block)) ; }
+      static constexpr bool affine() { return false ; }
+      static constexpr bool unit() { return false ; }
+   } ;
+
+/* -----------------------------------------------------------
+ *  Inline definitions
+ */
+
+template <class T>
+void Vector3Array<T>::resize(int n) {
+   const int old = count ;
+   const int need = (n + AOSOA_LANES - 1)/AOSOA_LANES ;
+   if (need > capacity) {
+      void* m = malloc(need*sizeof(Vector3Block) + SIMD_ALIGN) ;
+      if (!m)
+         throw std::bad_alloc() ;
+      Vector3Block* b = (Vector3Block*)(((uintptr_t)m + SIMD_ALIGN - 1) & ~(uintptr_t)(SIMD_ALIGN - 1)) ;
+      if (blocks)
+         memcpy(b, blocks, blockCount()*sizeof(Vector3Block)) ;
+      free(memory) ;
+      memory = m ;
+      blocks = b ;
+      capacity = need ;
+      }
+   count = n ;
+			// Zero what is new, and the unused lanes of the last block.
+   for (int i = MIN(old, n) ; i < need*AOSOA_LANES ; i++) {
+      Vector3Block& b = blocks[i/AOSOA_LANES] ;
+      const int k = i % AOSOA_LANES ;
+      b.x[k] = b.y[k] = b.z[k] = 0 ;
+      }
+   }
+
+template <class T>
+void Vector3Array<T>::load(T const* v, int n) {
+   for (int i = 0 ; i < n ; i++)
+      (*this)[i] = v[i] ;
+   }
+
+template <class T>
+void Vector3Array<T>::store(T* v, int n) const {
+   for (int i = 0 ; i < n ; i++)
+      v[i] = (*this)[i] ;
+   }
+
+template <class T>
+void Vector3Array<T>::load(Vector3SoA const& v, int n) {
+   for (int i = 0 ; i < n ; i++) {
+      Vector3Block& b = blocks[i/AOSOA_LANES] ;
+      const int k = i % AOSOA_LANES ;
+      b.x[k] = v.x[i] ;
+      b.y[k] = v.y[i] ;
+      b.z[k] = v.z[i] ;
+      }
+   }
+
+template <class T>
+void Vector3Array<T>::store(Vector3SoA const& v, int n) const {
+   for (int i = 0 ; i < n ; i++) {
+      Vector3Block const& b = blocks[i/AOSOA_LANES] ;
+      const int k = i % AOSOA_LANES ;
+      v.x[i] = b.x[k] ;
+      v.y[i] = b.y[k] ;
+      v.z[i] = b.z[k] ;
+      }
+   }
+
+template <class T> template <class F>
+void Vector3Array<T>::forBlocks(F const& body) {
+   const int nb = blockCount() ;
+   for (int b = 0 ; b < nb ; b++)
+      body(blocks[b].lanes(), MIN(AOSOA_LANES, count - b*AOSOA_LANES)) ;
+   }
+
+			// Only positions take the translation; directions stay unit, as Direction * Transform.
+template <> constexpr bool Vector3Array<Position>::affine() { return true ; }
+template <> constexpr bool Vector3Array<Direction>::unit() { return true ; }
+
+/** -----------------------------------------------------------
+ * The bulk operations run over every lane of every block, the
+ * padding included (it stays zero, or becomes the translation,
+ * which nothing reads), so the inner loops have a fixed width
+ * and no remainder.
+ **/
+template <class T>
+void Vector3Array<T>::transform(Transform const& mx) {
+   const scalar m00 = mx.xform[0][0], m01 = mx.xform[0][1], m02 = mx.xform[0][2] ;
+   const scalar m10 = mx.xform[1][0], m11 = mx.xform[1][1], m12 = mx.xform[1][2] ;
+   const scalar m20 = mx.xform[2][0], m21 = mx.xform[2][1], m22 = mx.xform[2][2] ;
+   const scalar t = affine() ? 1 : 0 ;
+   const scalar m30 = t*mx.xform[3][0], m31 = t*mx.xform[3][1], m32 = t*mx.xform[3][2] ;
+
+   const int nb = blockCount() ;
+   for (int b = 0 ; b < nb ; b++) {
+      Vector3Block& v = blocks[b] ;
+      SIMD_LOOP
+      for (int k = 0 ; k < AOSOA_LANES ; k++) {
+         const scalar x = v.x[k], y = v.y[k], z = v.z[k] ;
+         v.x[k] = x*m00 + y*m10 + z*m20 + m30 ;
+         v.y[k] = x*m01 + y*m11 + z*m21 + m31 ;
+         v.z[k] = x*m02 + y*m12 + z*m22 + m32 ;
+         }
+      }
+   if (unit())
+      normalize() ;
+   }
+
+template <class T>
+void Vector3Array<T>::normalize() {
+   const int nb = blockCount() ;
+   for (int b = 0 ; b < nb ; b++) {
+      Vector3Block& v = blocks[b] ;
+      SIMD_LOOP
+      for (int k = 0 ; k < AOSOA_LANES ; k++) {
+         const scalar x = v.x[k], y = v.y[k], z = v.z[k] ;
+         const scalar l = sqrt(x*x + y*y + z*z) ;
+         const scalar inv = (l > 0) ? 1/l : 0 ;
+         v.x[k] = x*inv ;
+         v.y[k] = y*inv ;
+         v.z[k] = z*inv ;
+         }
+      }
+   }
+
+template <class T>
+void Vector3Array<T>::dot(Vector3 const& d, scalar* out) const {
+   const int nb = blockCount() ;
+   for (int b = 0 ; b < nb ; b++) {
+      Vector3Block const& v = blocks[b] ;
+      scalar r[AOSOA_LANES] ;
+      SIMD_LOOP
+      for (int k = 0 ; k < AOSOA_LANES ; k++)
+         r[k] = v.x[k]*d.x + v.y[k]*d.y + v.z[k]*d.z ;
+      const int m = MIN(AOSOA_LANES, count - b*AOSOA_LANES) ;
+      for (int k = 0 ; k < m ; k++)
+         out[b*AOSOA_LANES + k] = r[k] ;
+      }
+   }
+
+#endif
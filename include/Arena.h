@@ -0,0 +1,154 @@
+/* -------- Arena.h -----------
+
+   Arena (Bump) Allocator Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   An arena hands out memory by bumping a pointer through large
+   blocks obtained from malloc(), and gives it all back at once:
+
+      Arena& arena = Arena::thread() ;       // this thread's arena
+      ...
+      Position* p = arena.array<Position>(n) ;
+      Vector3SoA d = arena.soa(n) ;
+      std::vector<Transform, ArenaAllocator<Transform> > v(arena) ;
+      ...
+      arena.reset() ;                          // end of frame
+
+   Nothing is freed individually; reset() (or an ArenaScope going
+   out of scope) releases everything allocated since. The blocks are
+   kept, so after the first frame the global heap is not touched.
+   Every allocation is aligned to SIMD_ALIGN unless asked otherwise.
+
+   Objects are not destroyed, so only types with trivial destructors
+   (all the vector and transform types) may be put in an arena.
+   An arena is not thread safe; use one per thread.
+
+*/
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <new>
+#include <type_traits>
+#include <Batch.h>
+
+class Arena {
+   public:
+			/// A point to release() back to.
+      class Marker {
+         public:
+            void*  block ;
+            size_t used ;
+         } ;
+
+			/// Create an empty arena. Blocks are allocated blockSize bytes at a time (or larger).
+      Arena(size_t blockSize = 1 << 20) ;
+      ~Arena() ;
+
+			/// Allocate bytes, aligned to align (a power of 2). Throws std::bad_alloc.
+      void* allocate(size_t bytes, size_t align = SIMD_ALIGN) ;
+			/// An aligned array of n default constructed T's.
+      template <class T> T* array(int n) ;
+			/// An aligned batch of n (uninitialized) vectors.
+      Vector3SoA soa(int n) ;
+
+			/// The current position, for release().
+      Marker mark() const ;
+			/// Release everything allocated since the marker was taken.
+      void release(Marker const& m) ;
+			/// Release everything. (The blocks are kept for reuse.)
+      void reset() ;
+			/// Free the blocks that are not in use.
+      void trim() ;
+
+			/// Bytes allocated (including alignment padding) since the last reset().
+      size_t used() const ;
+			/// Bytes held in blocks.
+      size_t capacity() const ;
+
+			/// The calling thread's arena.
+      static Arena& thread() ;
+
+   private:
+      class Block {
+         public:
+            Block* next ;
+            size_t size ;
+            // data follows
+         } ;
+
+      size_t blockSize ;
+      Block* first ;      // blocks, in order of use
+      Block* current ;    // block being allocated from
+      size_t offset ;     // bytes used in current
+
+      static char* data(Block* b) { return (char*)(b + 1) ; }
+
+      Arena(Arena const&) ;              // not copyable
+      Arena& operator=(Arena const&) ;
+   } ;
+
+/*------------------------------------------------------------
+ * Release everything allocated in the arena during the scope.
+ */
+class ArenaScope {
+   public:
+      Arena& arena ;
+
+      ArenaScope(Arena& a = Arena::thread()) : arena(a), marker(a.mark()) { }
+      ~ArenaScope() { arena.release(marker) ; }
+
+   private:
+      Arena::Marker marker ;
+
+      ArenaScope(ArenaScope const&) ;
+      ArenaScope& operator=(ArenaScope const&) ;
+   } ;
+
+/*------------------------------------------------------------
+ * STL allocator adapter. deallocate() does nothing; the memory
+ * comes back when the arena is reset.
+ */
+template <class T>
+class ArenaAllocator {
+   public:
+      typedef T value_type ;
+
+      Arena* arena ;
+
+      ArenaAllocator(Arena& a = Arena::thread()) : arena(&a) { }
+      template <class U>
+      ArenaAllocator(ArenaAllocator<U> const& a) : arena(a.arena) { }
+
+      T* allocate(size_t n) { return (T*)arena->allocate(n*sizeof(T), alignof(T) > SIMD_ALIGN ? alignof(T) : SIMD_ALIGN) ; }
+      void deallocate(T*, size_t) { }
+
+      template <class U>
+      bool operator==(ArenaAllocator<U> const& a) const { return arena == a.arena ; }
+      template <class U>
+      bool operator!=(ArenaAllocator<U> const& a) const { return arena != a.arena ; }
+   } ;
+
+/* -----------------------------------------------------------
+   Inline definitions
+ */
+
+template <class T>
+T* Arena::array(int n) {
+   static_assert(std::is_trivially_destructible<T>::value,
+                 "arena objects are never destroyed") ;
+   T* p = (T*)allocate(n*sizeof(T), alignof(T) > SIMD_ALIGN ? alignof(T) : SIMD_ALIGN) ;
+   for (int i = 0 ; i < n ; i++)
+      new (p + i) T ;
+   return p ;
+   }
+
+#endif
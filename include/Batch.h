@@ -0,0 +1,164 @@
+/* -------- Batch.h -----------
+
+   Batch (Structure of Arrays) Vector Library Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   A batch is n vectors stored as separate coordinate arrays
+   (x[0..n-1], y[0..n-1], ...). The SoA classes below do not own
+   their arrays; they just carry the pointers. Each batch function
+   computes the same thing as the scalar member function it is named
+   after, element by element, with the loop vectorized.
+
+*/
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <Vector.h>
+#include <Simd.h>
+
+class Vector3SoA {
+   public:
+      scalar* x ;
+      scalar* y ;
+      scalar* z ;
+
+			/// Create an empty (NULL) batch.
+      Vector3SoA() : x(0), y(0), z(0) { }
+			/// Create a batch over three coordinate arrays.
+      Vector3SoA(scalar* sx, scalar* sy, scalar* sz) : x(sx), y(sy), z(sz) { }
+
+			/// Element i as a vector.
+      Vector3   vector(int i) const { return Vector3(x[i], y[i], z[i]) ; }
+			/// Element i as a position.
+      Position  position(int i) const { return Position(x[i], y[i], z[i]) ; }
+			/// Element i as a unit/direction vector. (Assumed to be unit length already.)
+      Direction direction(int i) const { return Direction::Unit(x[i], y[i], z[i]) ; }
+			/// Store a vector (position, direction) in element i.
+      void set(int i, scalar a, scalar b, scalar c) { x[i] = a ; y[i] = b ; z[i] = c ; }
+      void set(int i, Vector3 const& v) { set(i, v.x, v.y, v.z) ; }
+      void set(int i, Position const& p) { set(i, p.x, p.y, p.z) ; }
+      void set(int i, Direction const& d) { set(i, d.x, d.y, d.z) ; }
+			/// The batch starting at element i.
+      Vector3SoA operator+(int i) const { return Vector3SoA(x+i, y+i, z+i) ; }
+   } ;
+
+class Vector2SoA {
+   public:
+      scalar* x ;
+      scalar* y ;
+
+			/// Create an empty (NULL) batch.
+      Vector2SoA() : x(0), y(0) { }
+			/// Create a batch over two coordinate arrays.
+      Vector2SoA(scalar* sx, scalar* sy) : x(sx), y(sy) { }
+
+			/// Element i as a vector.
+      Vector2 vector(int i) const { return Vector2(x[i], y[i]) ; }
+			/// Store a vector in element i.
+      void set(int i, scalar a, scalar b) { x[i] = a ; y[i] = b ; }
+      void set(int i, Vector2 const& v) { set(i, v.x, v.y) ; }
+			/// The batch starting at element i.
+      Vector2SoA operator+(int i) const { return Vector2SoA(x+i, y+i) ; }
+   } ;
+
+class Vector4SoA {
+   public:
+      scalar* x ;
+      scalar* y ;
+      scalar* z ;
+      scalar* w ;
+
+			/// Create an empty (NULL) batch.
+      Vector4SoA() : x(0), y(0), z(0), w(0) { }
+			/// Create a batch over four coordinate arrays.
+      Vector4SoA(scalar* sx, scalar* sy, scalar* sz, scalar* sw) : x(sx), y(sy), z(sz), w(sw) { }
+
+			/// Element i as a homogeneous vector.
+      Vector4 vector(int i) const { return Vector4(x[i], y[i], z[i], w[i]) ; }
+			/// Store a homogeneous vector in element i.
+      void set(int i, scalar a, scalar b, scalar c, scalar d) { x[i] = a ; y[i] = b ; z[i] = c ; w[i] = d ; }
+      void set(int i, Vector4 const& v) { set(i, v.x, v.y, v.z, v.w) ; }
+			/// The batch starting at element i.
+      Vector4SoA operator+(int i) const { return Vector4SoA(x+i, y+i, z+i, w+i) ; }
+   } ;
+
+	   // 2D operations.
+	   // The output batch may be the same as an input batch (in place)
+	   // but must not otherwise overlap it.
+
+			/// out[i] = p[i] * mx for 0 <= i < n.
+void transformBatch(Vector2SoA const& p, Transform2 const& mx,
+                    Vector2SoA const& out, int n) ;
+			/// out[i] = mx.linear(v[i]) for 0 <= i < n.
+void linearBatch(Vector2SoA const& v, Transform2 const& mx,
+                 Vector2SoA const& out, int n) ;
+			/// out[i] = v1[i].dot(v2[i]) for 0 <= i < n.
+void dotBatch(Vector2SoA const& v1, Vector2SoA const& v2,
+              scalar* out, int n) ;
+			/// out[i] = v[i] * s for 0 <= i < n.
+void scaleBatch(Vector2SoA const& v, scalar s,
+                Vector2SoA const& out, int n) ;
+			/// out[i] = v1[i] * v2[i] (coordinate by coordinate) for 0 <= i < n.
+void mulBatch(Vector2SoA const& v1, Vector2SoA const& v2,
+              Vector2SoA const& out, int n) ;
+
+	   // 3D operations. In place or not, as the 2D ones. These go
+	   // through the kernels of the widest instruction set the CPU
+	   // has (Dispatch.h).
+
+			/// out[i] = p[i] * mx for 0 <= i < n. (Positions; mx affine.)
+void transformBatch(Vector3SoA const& p, Transform const& mx,
+                    Vector3SoA const& out, int n) ;
+			/// out[i] = v[i] * mx without the translation (or normalizing) for 0 <= i < n. (Vectors, directions.)
+void linearBatch(Vector3SoA const& v, Transform const& mx,
+                 Vector3SoA const& out, int n) ;
+			/// out[i] = v1[i].dot(v2[i]) for 0 <= i < n.
+void dotBatch(Vector3SoA const& v1, Vector3SoA const& v2,
+              scalar* out, int n) ;
+			/// out[i] = v1[i].cross(v2[i]) for 0 <= i < n.
+void crossBatch(Vector3SoA const& v1, Vector3SoA const& v2,
+                Vector3SoA const& out, int n) ;
+			/// out[i] = v[i] normalized (zero stays zero) for 0 <= i < n; its former length to len[i] unless len is NULL.
+void normalizeBatch(Vector3SoA const& v, Vector3SoA const& out,
+                    int n, scalar* len = 0) ;
+
+	   // Rotation builders.
+	   // out[i] receives the same matrix the Transform member function
+	   // would build from element i of the input batches (to within
+	   // rounding). The d1 and d2 batches must hold unit vectors.
+
+			/// out[i].setRotate(d1[i], d2[i]) for 0 <= i < n.
+void setRotateBatch(Vector3SoA const& d1, Vector3SoA const& d2,
+                    Transform* out, int n) ;
+			/// out[i].setRotateGimbal(d1[i], d2[i]) for 0 <= i < n.
+void setRotateGimbalBatch(Vector3SoA const& d1, Vector3SoA const& d2,
+                          Transform* out, int n) ;
+			/// out[i].setRotate(axis[i], radians[i]) for 0 <= i < n. (Unit axes.)
+void setRotateBatch(Vector3SoA const& axis, scalar const* radians,
+                    Transform* out, int n) ;
+
+	   // Rotations about the coordinate axes, concatenated in place.
+	   // The sines and cosines come from VMath.h.
+
+			/// out[i].rotateX(radians[i]) for 0 <= i < n.
+void rotateXBatch(Transform* out, scalar const* radians, int n) ;
+			/// out[i].rotateY(radians[i]) for 0 <= i < n.
+void rotateYBatch(Transform* out, scalar const* radians, int n) ;
+			/// out[i].rotateZ(radians[i]) for 0 <= i < n.
+void rotateZBatch(Transform* out, scalar const* radians, int n) ;
+
+	   // Measurement.
+
+			/// out[i] = d1[i].angle(d2[i]) for 0 <= i < n.
+void angleBatch(Vector3SoA const& d1, Vector3SoA const& d2,
+                scalar* out, int n) ;
+
+#endif
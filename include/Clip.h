@@ -0,0 +1,107 @@
+/* -------- Clip.h -----------
+
+   Polygon Clipping Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   Sutherland-Hodgman clipping of triangles in homogeneous (clip)
+   space, after the vertex stage of Projection.h. Clipping before the
+   divide by w is what keeps vertices behind the eye from wrapping
+   around; the intersections are linear in clip space, so the vertex
+   attributes (colors, texture coordinates, 1/w is NOT one of them)
+   are interpolated with the same parameter.
+
+   The vertices live in a ClipMesh: clip space positions and an
+   interleaved attribute array over storage the caller owns, with
+   room to spare. Clipping appends the new vertices to it and writes
+   index triples, so nothing is allocated per triangle:
+
+      ClipMesh mesh(clip, attributes, 5, vertexCount, capacity) ;
+      int n = clipTriangles(mesh, codes, triangles, count, out, outCapacity) ;
+      ... divideBatch(mesh.clip + first, ...) the new vertices
+
+   Triangles inside every plane are passed through with their
+   indices; triangles outside one plane are dropped. Where triangles
+   share an edge, the vertex made on it is computed the same way for
+   both (from the inside end), so there are no cracks.
+
+*/
+
+#ifndef CLIP_H
+#define CLIP_H
+
+#include <Projection.h>
+
+/*------------------------------------------------------------
+ * The plane a x + b y + c z + d w = 0 of homogeneous space; the
+ * inside is where that is >= 0. For a plane of 3D space (w = 1),
+ * (a, b, c) is the normal, pointing inside.
+ */
+class Plane {
+   public:
+      scalar a ;
+      scalar b ;
+      scalar c ;
+      scalar d ;
+
+			/// Create the plane a x + b y + c z + d w = 0.
+      constexpr Plane(scalar sa = 0, scalar sb = 0, scalar sc = 1, scalar sd = 0) : a(sa), b(sb), c(sc), d(sd) { }
+			/// Create the plane through point with unit normal (pointing inside).
+      constexpr Plane(Direction const& normal, Position const& point)
+         : a(normal.x), b(normal.y), c(normal.z), d(-normal.dot(Vector(point))) { }
+
+			/// Signed distance (times the normal's length) of homogeneous h.
+      constexpr scalar distance(Vector4 const& h) const { return a*h.x + b*h.y + c*h.z + d*h.w ; }
+			/// Signed distance (times the normal's length) of p.
+      constexpr scalar distance(Position const& p) const { return a*p.x + b*p.y + c*p.z + d ; }
+			/// THIS plane in the space mx maps to (p on THIS  <=>  p * mx on the result).
+      Plane transform(Transform const& mx) const ;
+   } ;
+
+			/// The clip space plane of outcode bit CLIP_LEFT ... CLIP_FAR.
+constexpr Plane frustumPlane(int bit) ;
+			/// Most vertices a convex polygon of count vertices can have clipped by the frustum and planeCount planes.
+constexpr int clipVertices(int count, int planeCount) { return count + 6 + planeCount ; }
+
+/*------------------------------------------------------------
+ * Vertex storage for clipping: vertex i is clip[i] with
+ * attributes[attributeCount*i .. attributeCount*(i+1)-1].
+ */
+class ClipMesh {
+   public:
+      Vector4SoA clip ;
+      scalar*    attributes ;
+      int        attributeCount ;
+      int        vertices ;      // in use
+      int        capacity ;
+
+      ClipMesh(Vector4SoA const& c, scalar* attr, int attrCount, int used, int cap)
+         : clip(c), attributes(attr), attributeCount(attrCount), vertices(used), capacity(cap) { }
+   } ;
+
+			/// Clip n triangles (index triples) against the frustum and planes[0..planeCount-1]. Returns the triangles written to out, or -1 if out or the mesh fills (the mesh is then as it was: grow both and call again).
+int clipTriangles(ClipMesh& mesh, unsigned char const* codes,
+                  int const* triangles, int n, int* out, int outCapacity,
+                  Plane const* planes = 0, int planeCount = 0) ;
+			/// Clip one convex polygon of count vertex indices. Writes the clipped polygon's indices to out (room for clipVertices(count, planeCount)) and returns its size; 0 if nothing is left, -1 if the new vertices do not fit in the mesh (none are added).
+int clipPolygon(ClipMesh& mesh, int const* polygon, int count, int* out,
+                int mask = CLIP_LEFT | CLIP_RIGHT | CLIP_BOTTOM | CLIP_TOP | CLIP_NEAR | CLIP_FAR,
+                Plane const* planes = 0, int planeCount = 0) ;
+
+/* -----------------------------------------------------------
+ *  Inline definitions
+ */
+
+constexpr Plane frustumPlane(int bit) {
+   return (bit == CLIP_LEFT)   ? Plane( 1, 0, 0, 1) : (bit == CLIP_RIGHT) ? Plane(-1, 0, 0, 1)
+        : (bit == CLIP_BOTTOM) ? Plane( 0, 1, 0, 1) : (bit == CLIP_TOP)   ? Plane( 0,-1, 0, 1)
+        : (bit == CLIP_NEAR)   ? Plane( 0, 0, 1, 1) :                       Plane( 0, 0,-1, 1) ;
+   }
+
+#endif
@@ -0,0 +1,99 @@
+/* -------- Color.h -----------
+
+   Color and Spectrum Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   ColorN<T,N> is N samples of radiance of type T: RGB when N is 3,
+   a spectrum at N fixed wavelengths otherwise. Arithmetic is channel
+   by channel over a fixed length array, which the compiler turns
+   into SIMD instructions (a float RGB or an 8 sample spectrum is a
+   single vector operation), where a Vector3 used as a color is three
+   scalar doubles.
+
+      Color  c(.5, .2, .1) ;               // double RGB
+      Colorf f(c) ;                        // float RGB
+      Spectrum s ;                         // SPECTRUM_SAMPLES floats
+
+   Film.h accumulates colors into an image.
+
+*/
+
+#ifndef COLOR_H
+#define COLOR_H
+
+#include <Vector.h>
+
+			// Wavelengths in a Spectrum.
+#ifndef SPECTRUM_SAMPLES
+#define SPECTRUM_SAMPLES 8
+#endif
+
+template <class T, int N>
+class ColorN {
+   public:
+      T c[N] ;
+
+			/// Create black.
+      constexpr ColorN() : c() { }
+			/// Create the gray level v in every channel.
+      constexpr explicit ColorN(T v) : c() { for (int i = 0 ; i < N ; i++) c[i] = v ; }
+			/// Create an RGB color. (N == 3)
+      constexpr ColorN(T r, T g, T b) : c() {
+         static_assert(N == 3, "ColorN(r, g, b) is RGB only") ;
+         c[0] = r ; c[1] = g ; c[2] = b ;
+         }
+			/// Create an RGB color from the coordinates of v. (N == 3)
+      constexpr explicit ColorN(Vector3 const& v) : ColorN(T(v.x), T(v.y), T(v.z)) { }
+			/// Convert between float and double.
+      template <class U>
+      constexpr explicit ColorN(ColorN<U,N> const& o) : c() { for (int i = 0 ; i < N ; i++) c[i] = T(o.c[i]) ; }
+
+      constexpr T&       operator[](int i)       { return c[i] ; }
+      constexpr T const& operator[](int i) const { return c[i] ; }
+
+			/// Channel by channel sum, difference, product and quotient.
+      constexpr ColorN  operator+ (ColorN const& o) const { ColorN r(*this) ; return r += o ; }
+      constexpr ColorN  operator- (ColorN const& o) const { ColorN r(*this) ; return r -= o ; }
+      constexpr ColorN  operator* (ColorN const& o) const { ColorN r(*this) ; return r *= o ; }
+      constexpr ColorN  operator/ (ColorN const& o) const { ColorN r(*this) ; return r /= o ; }
+      constexpr ColorN& operator+=(ColorN const& o) { for (int i = 0 ; i < N ; i++) c[i] += o.c[i] ; return *this ; }
+      constexpr ColorN& operator-=(ColorN const& o) { for (int i = 0 ; i < N ; i++) c[i] -= o.c[i] ; return *this ; }
+      constexpr ColorN& operator*=(ColorN const& o) { for (int i = 0 ; i < N ; i++) c[i] *= o.c[i] ; return *this ; }
+      constexpr ColorN& operator/=(ColorN const& o) { for (int i = 0 ; i < N ; i++) c[i] /= o.c[i] ; return *this ; }
+			/// Scale every channel by s.
+      constexpr ColorN  operator* (T s) const { ColorN r(*this) ; return r *= s ; }
+      constexpr ColorN  operator/ (T s) const { ColorN r(*this) ; return r *= 1/s ; }
+      constexpr ColorN& operator*=(T s) { for (int i = 0 ; i < N ; i++) c[i] *= s ; return *this ; }
+      friend constexpr ColorN operator*(T s, ColorN const& o) { return o * s ; }
+
+			/// Rec. 709 luminance of RGB; the average of a spectrum (a flat response).
+      constexpr T luminance() const ;
+			/// Mean of the channels.
+      constexpr T average() const { T s = 0 ; for (int i = 0 ; i < N ; i++) s += c[i] ; return s/N ; }
+			/// Largest channel.
+      constexpr T maxCoord() const { T m = c[0] ; for (int i = 1 ; i < N ; i++) m = MAX(m, c[i]) ; return m ; }
+			/// True if every channel is 0.
+      constexpr bool black() const { for (int i = 0 ; i < N ; i++) if (c[i] != 0) return false ; return true ; }
+   } ;
+
+typedef ColorN<scalar,3>                 Color ;
+typedef ColorN<float,3>                  Colorf ;
+typedef ColorN<float,SPECTRUM_SAMPLES>   Spectrum ;
+
+/* -----------------------------------------------------------
+ *  Inline definitions
+ */
+
+template <class T, int N>
+constexpr T ColorN<T,N>::luminance() const {
+   return (N == 3) ? T(.2126)*c[0] + T(.7152)*c[1 % N] + T(.0722)*c[2 % N] : average() ;
+   }
+
+#endif
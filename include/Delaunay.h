@@ -0,0 +1,49 @@
+/* -------- Delaunay.h -----------
+
+   Delaunay Triangulation Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   The Delaunay triangulation of points in the plane, built by
+   inserting the points one at a time (Bowyer-Watson): find the
+   triangle the point falls in by walking from the last one made,
+   remove the triangles whose circumcircles hold it, and join the
+   point to the edges of the hole.
+
+   The points are inserted in the order of a Hilbert curve over their
+   bounding box, so each lands near the previous one and the walk is
+   a few steps. The outside of the hull is covered by "ghost"
+   triangles to a vertex at infinity, so there is no super triangle
+   whose corners would have to be far enough away.
+
+   orient2d() and incircle() (Predicates.h) make the result exactly
+   Delaunay; where four points are cocircular either diagonal may
+   be chosen. Repeated points are used once.
+
+      std::vector<int> triangles ;
+      int count = delaunay(points, n, triangles) ;
+
+*/
+
+#ifndef DELAUNAY_H
+#define DELAUNAY_H
+
+#include <stdio.h>
+#include <vector>
+#include <Vector.h>
+
+			/// Triangles as point index triples, counterclockwise. Returns the count (0 if all collinear).
+int delaunay(Vector2 const* points, int n, std::vector<int>& triangles) ;
+			/// The order of a Hilbert curve through the bounding box of the points.
+void hilbertOrder(Vector2 const* points, int n, std::vector<int>& order) ;
+
+			/// Time delaunay() on n uniform random points; print the rate to out.
+void delaunayBenchmark(int n, FILE* out = stdout) ;
+
+#endif
@@ -0,0 +1,76 @@
+/* -------- Dispatch.h -----------
+
+   Runtime Instruction Set Dispatch Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   One build of the library for machines of different generations.
+   The 3D bulk kernels of Batch.h (transformBatch, linearBatch,
+   dotBatch, crossBatch, normalizeBatch) and the batch decompositions
+   of Matrix3.h (eigenBatch, svdBatch) are compiled several times,
+   once per instruction set, into the same library; the first call
+   picks the widest set the CPU supports (CPUID) and every later call
+   goes through that table of kernels.
+
+      VECTORLIB_ISA=sse2 ./app        force a narrower set (sse2, avx2, avx512)
+      dispatchBenchmark() ;           each variant's throughput, and the one in use
+
+   A set the CPU lacks is never chosen, whatever VECTORLIB_ISA says.
+   The library itself must be compiled for the oldest machine (no
+   -march=native): the baseline variant gets the compiler's default
+   target, the others their own. On anything but x86 with GCC or
+   Clang only the baseline exists.
+
+*/
+
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include <stdio.h>
+#include <Batch.h>
+#include <Matrix3.h>
+
+enum SimdIsa {
+   ISA_SSE2,       // the baseline: the compiler's default target
+   ISA_AVX2,       // AVX2 and FMA
+   ISA_AVX512,     // AVX-512F
+   ISA_COUNT
+   } ;
+
+			/// One variant of each dispatched kernel, as declared in Batch.h and Matrix3.h.
+class BatchKernels {
+   public:
+      SimdIsa isa ;
+      void (*transform)(Vector3SoA const& p, Transform const& mx, Vector3SoA const& out, int n) ;
+      void (*linear)(Vector3SoA const& v, Transform const& mx, Vector3SoA const& out, int n) ;
+      void (*dot)(Vector3SoA const& v1, Vector3SoA const& v2, scalar* out, int n) ;
+      void (*cross)(Vector3SoA const& v1, Vector3SoA const& v2, Vector3SoA const& out, int n) ;
+      void (*normalize)(Vector3SoA const& v, Vector3SoA const& out, scalar* len, int n) ;
+      void (*eigen)(Matrix3SoA const& a, Vector3SoA const& values, Matrix3SoA const& vectors, int n) ;
+      void (*svd)(Matrix3SoA const& a, Matrix3SoA const& u, Vector3SoA const& s, Matrix3SoA const& v, int n) ;
+   } ;
+
+			/// The widest instruction set this CPU (and OS) supports.
+SimdIsa detectIsa() ;
+			/// Is isa compiled in and supported here?
+bool isaSupported(SimdIsa isa) ;
+			/// Name of isa: "sse2", "avx2" or "avx512".
+const char* isaName(SimdIsa isa) ;
+
+			/// The kernels in use: detectIsa()'s, or VECTORLIB_ISA's if it is set and supported.
+BatchKernels const& kernels() ;
+			/// The kernels compiled for isa. (isaSupported(isa) says if they can run.)
+BatchKernels const& kernels(SimdIsa isa) ;
+			/// Use isa's kernels from now on. Returns false, changing nothing, if unsupported.
+bool setIsa(SimdIsa isa) ;
+
+			/// Time each supported variant of each kernel over n elements and print the throughput. (Arrays larger than the cache time the memory instead.)
+void dispatchBenchmark(int n = 1 << 10, FILE* out = stdout) ;
+
+#endif
@@ -0,0 +1,108 @@
+/* -------- Film.h -----------
+
+   Film (Image Accumulator) Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   A film collects weighted color samples per pixel and resolves them
+   into an image. It is stored tile by tile - FILM_TILE x FILM_TILE
+   pixels, contiguous, from a SIMD_ALIGN (cache line) aligned base -
+   so that a thread rendering one tile works in its own block of
+   memory and never shares a cache line with another.
+
+   Two ways in:
+
+   add()    for the thread that owns the pixel's tile (camera rays
+            traced tile by tile, as forTiles() hands them out). The
+            running sums are compensated (Kahan), so a progressive
+            render of many thousands of passes does not lose its small
+            late contributions to rounding. Not thread safe across a tile.
+   splat()  from any thread to any pixel (light paths landing anywhere
+            on the image), with lock-free atomic adds in float.
+
+      Film film(width, height) ;
+      film.forTiles([&](int x0, int y0, int x1, int y1) {
+         for (...) film.add(x, y, radiance) ;
+         }) ;
+      film.resolve(image) ;
+
+   Compensated summation depends on the rounding of each addition;
+   it must not be compiled with -ffast-math (or -fassociative-math).
+
+*/
+
+#ifndef FILM_H
+#define FILM_H
+
+#include <atomic>
+#include <functional>
+#include <vector>
+#include <Color.h>
+#include <Simd.h>
+
+			// Width and height of a tile, in pixels.
+#ifndef FILM_TILE
+#define FILM_TILE 16
+#endif
+
+class Film {
+   public:
+      int width ;
+      int height ;
+
+			/// Create a black film of w x h pixels.
+      Film(int w, int h) ;
+      ~Film() ;
+
+			/// Add sample c with weight to pixel (x, y). (Owner of the tile only.)
+      void   add(int x, int y, Color const& c, scalar weight = 1) ;
+			/// Add c to pixel (x, y) from any thread. Splats are not weighted.
+      void   splat(int x, int y, Colorf const& c) ;
+
+			/// Number of tiles.
+      int    tiles() const { return tilesX*tilesY ; }
+			/// The pixels x0 <= x < x1, y0 <= y < y1 of tile i.
+      void   tile(int i, int& x0, int& y0, int& x1, int& y1) const ;
+			/// Call body(x0, y0, x1, y1) once for each tile, tiles in parallel.
+      void   forTiles(std::function<void(int, int, int, int)> const& body) ;
+
+			/// Sum of added samples / sum of weights, plus splatScale times the splats.
+      Color  pixel(int x, int y, scalar splatScale = 1) const ;
+			/// All of pixel(), row by row into width*height colors.
+      void   resolve(Color* out, scalar splatScale = 1) const ;
+			/// Make every pixel black.
+      void   clear() ;
+
+   private:
+			// Kahan sums of weighted color and of weight: one cache line.
+      class Pixel {
+         public:
+            Color  sum ;
+            Color  comp ;
+            scalar weight ;
+            scalar weightComp ;
+         } ;
+			// Then a tile is whole cache lines, and an aligned base aligns every tile.
+      static_assert((FILM_TILE*FILM_TILE*sizeof(Pixel)) % SIMD_ALIGN == 0,
+                    "a tile of pixels must be a whole number of SIMD_ALIGN blocks") ;
+
+      int                 tilesX ;
+      int                 tilesY ;
+      int                 count ;     // pixels, whole tiles
+      Pixel*              pixels ;    // tile by tile, each row by row; SIMD_ALIGN aligned, in memory
+      void*               memory ;
+      std::vector<std::atomic<float> > splats ;   // 3 per pixel, same order
+
+      int index(int x, int y) const ;
+
+      Film(Film const&) ;              // not copyable
+      Film& operator=(Film const&) ;
+   } ;
+
+#endif
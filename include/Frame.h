@@ -0,0 +1,124 @@
+/* -------- Frame.h -----------
+
+   Orthonormal Frame Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   A right handed orthonormal basis (s, t, n): s x t = n. Built from
+   a unit normal alone, it is the local shading frame, with the
+   normal as z:
+
+      Frame f(normal) ;
+      Vector3 local = f.toLocal(v) ;      // (v.s, v.t, v.n)
+      Vector3 world = f.toWorld(local) ;  // x s + y t + z n
+
+   The construction is that of Duff et al., "Building an Orthonormal
+   Basis, Revisited": one copysign, one division and no branch or
+   normalization, where majorAxis()/minorAxis() and two cross products
+   need branches and square roots. Changing basis costs three dot
+   products; there is no fourth row and no translation as there would
+   be with a Transform.
+
+*/
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <Batch.h>
+
+class Frame {
+   public:
+      Direction s ;      // tangent
+      Direction t ;      // bitangent
+      Direction n ;      // normal
+
+			/// Create the standard basis (x, y, z).
+      constexpr Frame() : s(XAXIS), t(YAXIS), n(ZAXIS) { }
+			/// Create a frame about the unit normal.
+      explicit Frame(Direction const& normal) ;
+			/// Create a frame from three orthonormal directions. (Not checked.)
+      constexpr Frame(Direction const& ds, Direction const& dt, Direction const& dn)
+         : s(ds), t(dt), n(dn) { }
+
+			/// Coordinates of world vector v in THIS frame.
+      constexpr Vector3   toLocal(Vector3 const& v) const ;
+      constexpr Direction toLocal(Direction const& d) const ;
+			/// World vector of coordinates v in THIS frame.
+      constexpr Vector3   toWorld(Vector3 const& v) const ;
+      constexpr Direction toWorld(Direction const& d) const ;
+
+			/// The rotation taking local to world (rows s, t, n); its transpose goes back.
+      constexpr Transform transform() const ;
+   } ;
+
+	   // Batches. The output batch may be the same as the input batch.
+
+			/// Tangents and bitangents of the frames about unit normals[i].
+void frameBatch(Vector3SoA const& normals, Vector3SoA const& s,
+                Vector3SoA const& t, int n) ;
+			/// out[i] = frame.toLocal(v[i]) for 0 <= i < n.
+void toLocalBatch(Frame const& frame, Vector3SoA const& v,
+                  Vector3SoA const& out, int n) ;
+			/// out[i] = frame.toWorld(v[i]) for 0 <= i < n.
+void toWorldBatch(Frame const& frame, Vector3SoA const& v,
+                  Vector3SoA const& out, int n) ;
+			/// out[i] = Frame(normals[i]).toLocal(v[i]) for 0 <= i < n.
+void toLocalBatch(Vector3SoA const& normals, Vector3SoA const& v,
+                  Vector3SoA const& out, int n) ;
+			/// out[i] = Frame(normals[i]).toWorld(v[i]) for 0 <= i < n.
+void toWorldBatch(Vector3SoA const& normals, Vector3SoA const& v,
+                  Vector3SoA const& out, int n) ;
+
+/* -----------------------------------------------------------
+ *  Inline definitions
+ */
+
+/** -----------------------------------------------------------
+ * With sign the sign of n.z, a = -1/(sign + n.z) and
+ * b = n.x n.y a, the two tangents are
+ *   s = (1 + sign n.x^2 a, sign b, -sign n.x)
+ *   t = (b, sign + n.y^2 a, -n.y)
+ * exactly unit length for unit n. The only singularity, n.z = -0
+ * against sign = 1, is removed by copysign (which sees -0).
+ **/
+inline Frame::Frame(Direction const& normal)
+   : n(normal) {
+   const scalar sign = copysign((scalar)1, normal.z) ;
+   const scalar a = -1/(sign + normal.z) ;
+   const scalar b = normal.x*normal.y*a ;
+   s = Direction::Unit(1 + sign*normal.x*normal.x*a, sign*b, -sign*normal.x) ;
+   t = Direction::Unit(b, sign + normal.y*normal.y*a, -normal.y) ;
+   }
+
+constexpr Vector3 Frame::toLocal(Vector3 const& v) const {
+   return Vector3(s.dot(v), t.dot(v), n.dot(v)) ;
+   }
+
+constexpr Direction Frame::toLocal(Direction const& d) const {
+   return Direction::Unit(s.dot(d), t.dot(d), n.dot(d)) ;
+   }
+
+constexpr Vector3 Frame::toWorld(Vector3 const& v) const {
+   return s*v.x + t*v.y + n*v.z ;
+   }
+
+constexpr Direction Frame::toWorld(Direction const& d) const {
+   const Vector3 v = s*d.x + t*d.y + n*d.z ;
+   return Direction::Unit(v.x, v.y, v.z) ;
+   }
+
+constexpr Transform Frame::transform() const {
+   Transform mx ;
+   mx.xform[0][0] = s.x ; mx.xform[0][1] = s.y ; mx.xform[0][2] = s.z ;
+   mx.xform[1][0] = t.x ; mx.xform[1][1] = t.y ; mx.xform[1][2] = t.z ;
+   mx.xform[2][0] = n.x ; mx.xform[2][1] = n.y ; mx.xform[2][2] = n.z ;
+   return mx ;
+   }
+
+#endif
@@ -0,0 +1,46 @@
+/* -------- Hull.h -----------
+
+   Convex Hull Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   The convex hull of a set of positions by Quickhull (Barber, Dobkin
+   and Huhdanpaa): start from a tetrahedron of extreme points, give
+   each face the points outside it, and repeatedly replace the faces
+   seen from the farthest outside point by a cone to that point.
+
+   Which side of a face a point lies on is decided by orient3d()
+   (Predicates.h), so the hull is correct for degenerate input too.
+   Points on the plane of a face count as inside: the hull has no
+   vertices in the middle of its faces or edges, but coplanar faces
+   are left as separate triangles.
+
+   Large sets are split into one part per thread (Parallel.h); the
+   parts' hulls are found in parallel and the hull of their vertices
+   is the hull of the set.
+
+      std::vector<int> triangles ;
+      int faces = convexHull(points, n, triangles) ;
+
+*/
+
+#ifndef HULL_H
+#define HULL_H
+
+#include <stdio.h>
+#include <vector>
+#include <Vector.h>
+
+			/// Hull faces as point index triples, counterclockwise seen from outside. Returns the count (0 if all coplanar).
+int convexHull(Position const* points, int n, std::vector<int>& triangles) ;
+
+			/// Time convexHull() on n points in a ball and on a sphere; print the rates to out.
+void hullBenchmark(int n, FILE* out = stdout) ;
+
+#endif
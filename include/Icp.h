@@ -0,0 +1,80 @@
+/* -------- Icp.h -----------
+
+   Point Cloud Registration Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   Iterative closest point (Besl & McKay): the rigid Transform that
+   carries a source scan onto a target scan. Each iteration pairs
+   every moved source point with its nearest target point (KdTree.h,
+   in parallel), then finds the rigid motion that best fits the
+   pairs:
+
+      point to point   the closed form of Horn ("Closed-form solution
+                       of absolute orientation using unit quaternions")
+                       from the 3x3 covariance of the pairs
+      point to plane   the linearized least squares of Chen & Medioni
+                       on the distances to the target's tangent planes;
+                       needs target normals, converges in fewer steps
+
+   The sums over the pairs are accumulated a SIMD block at a time,
+   in fixed chunks, so the result does not depend on the thread count.
+
+      KdTree tree(target, m) ;
+      IcpResult r = icp(source, n, tree, normals, guess) ;
+      r.report(stdout) ;                   // iterations, error, throughput
+
+   The initial guess must be close enough for nearest points to be
+   mostly right; ICP finds a local minimum.
+
+*/
+
+#ifndef ICP_H
+#define ICP_H
+
+#include <stdio.h>
+#include <vector>
+#include <KdTree.h>
+
+class IcpOptions {
+   public:
+      int    iterations ;     // most iterations
+      scalar tolerance ;      // stop when the rms error improves by less than this fraction
+      scalar maxDistance ;    // pairs farther apart are left out
+      bool   pointToPlane ;   // minimize distances to the target's planes (normals needed)
+
+      IcpOptions() : iterations(50), tolerance(1e-6), maxDistance(HUGE_VAL), pointToPlane(false) { }
+   } ;
+
+class IcpResult {
+   public:
+      Transform           xform ;       // source to target (rigid)
+      int                 iterations ;
+      bool                converged ;   // stopped by the tolerance, not the iteration limit
+      scalar              rms ;         // rms distance of the last pairs (point or plane)
+      int                 pairs ;       // pairs in the last iteration
+      std::vector<scalar> history ;     // rms per iteration
+      double              seconds ;
+      long                queries ;     // nearest point searches made
+
+      IcpResult() : iterations(0), converged(false), rms(0), pairs(0), seconds(0), queries(0) { }
+
+			/// Print the convergence and the throughput.
+      void report(FILE* out = stdout) const ;
+   } ;
+
+			/// Register n source points to the tree's points, starting from initial. normals (per target point) may be NULL for point to point.
+IcpResult icp(Position const* source, int n, KdTree const& target,
+              Direction const* normals, Transform const& initial = Transform(),
+              IcpOptions const& options = IcpOptions()) ;
+
+			/// Register a moved copy of an n point surface, both ways, and print the results.
+void icpBenchmark(int n, FILE* out = stdout) ;
+
+#endif
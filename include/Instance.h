@@ -0,0 +1,116 @@
+/* -------- Instance.h -----------
+
+   Instanced Geometry Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   Many copies of the same geometry, each placed by its own
+   Transform. The geometry is built once (a TriangleMesh, or any
+   Traceable); an instance holds only a pointer to it, the transform
+   and its inverse, computed once. A ray is not traced against moved
+   geometry but moved itself, into the object's space, by the
+   inverse.
+
+   An InstanceTree is a bounding volume hierarchy over the instances'
+   world bounds - the top level over the objects' own hierarchies -
+   and is itself Traceable, so trees of trees work too:
+
+      InstanceTree scene ;
+      for (...)
+         scene.add(mesh, placement) ;
+      scene.build() ;
+      scene.intersect(ray, hit) ;      // hit.instance, hit.triangle
+
+   hit.instance is the index in the tree traced, the top level: in a
+   tree of trees the index the inner tree set is replaced by that of
+   the instance holding it, so only the outermost level is reported.
+
+   Hit distances are world distances. The transforms must be affine
+   and invertible. Objects must outlive the tree and not change
+   after build().
+
+*/
+
+#ifndef INSTANCE_H
+#define INSTANCE_H
+
+#include <vector>
+#include <Ray.h>
+
+			// Most instances in a leaf of an InstanceTree.
+#ifndef INSTANCE_LEAF
+#define INSTANCE_LEAF 4
+#endif
+
+class Instance {
+   public:
+      Traceable const* object ;
+      Transform        xform ;      // object to world
+      Transform        inverse ;    // world to object
+      Bounds           box ;        // world bounds
+
+			/// Create object placed by mx.
+      Instance(Traceable const& obj, Transform const& mx) ;
+
+			/// ray moved into object space. Returns the object distance per world distance.
+      scalar toObject(Ray const& ray, Ray& out) const ;
+   } ;
+
+class InstanceTree : public Traceable {
+   public:
+			/// A BVH node. A leaf holds count instances: order[child .. child+count-1].
+      class Node {
+         public:
+            Bounds box ;
+            int    child ;   // interior: first of two children; leaf: first in order
+            int    count ;   // instances in a leaf, 0 for an interior node
+            int    axis ;    // interior: the axis the children were split on
+         } ;
+
+      InstanceTree() { }
+
+			/// Add object placed by mx. Returns the instance index. (Call build() after adding.)
+      int add(Traceable const& object, Transform const& mx) ;
+			/// Build the hierarchy over the instances added.
+      void build() ;
+			/// Remove all instances.
+      void clear() ;
+
+			/// Number of instances.
+      int instanceCount() const { return (int)instances.size() ; }
+			/// Instance i.
+      Instance const& instance(int i) const { return instances[i] ; }
+			/// Number of BVH nodes. Node 0 is the root.
+      int nodeCount() const { return (int)nodes.size() ; }
+
+      using Traceable::intersect ;
+      using Traceable::occluded ;
+
+			/// Find the closest hit along ray: sets hit.instance (in THIS tree) too.
+      bool intersect(Ray const& ray, Hit& hit) const ;
+			/// Is there any hit along ray?
+      bool occluded(Ray const& ray) const ;
+      Bounds bounds() const ;
+			/// Packet traversal: the packet visits a node if any of its rays enters the node's box, and goes to the objects as a packet.
+      void intersectPacket(Ray const* rays, Hit* hits, int n,
+                           PacketStats* stats = 0) const ;
+      void occludedPacket(Ray const* rays, bool* blocked, int n,
+                          PacketStats* stats = 0) const ;
+
+   private:
+      std::vector<Instance> instances ;
+      std::vector<int>      order ;
+      std::vector<Node>     nodes ;
+
+      void split(int index, int begin, int end, std::vector<Position> const& centroid) ;
+      void tracePacket(Ray const* rays, Hit* hits, bool* blocked, int n,
+                       PacketStats* stats) const ;
+   } ;
+
+#endif
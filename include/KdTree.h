@@ -0,0 +1,82 @@
+/* -------- KdTree.h -----------
+
+   Nearest Neighbour Search Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   A k-d tree over a set of positions: the nearest point, or the k
+   nearest, to a query. Each node splits its points at the median of
+   the axis along which they spread most; the leaves hold up to
+   KD_LEAF points, stored coordinate by coordinate in tree order so a
+   leaf is scanned by one SIMD loop.
+
+      KdTree tree(points, n) ;
+      scalar d2 ;
+      int i = tree.nearest(q, d2) ;         // points[i], d2 = squared distance
+      int k = tree.nearest(q, 8, idx, d2s) ;
+      tree.nearestBatch(queries, m, idx, d2s) ;   // in parallel
+
+   Indices are those of the points given to build(); the tree keeps
+   its own copy of them.
+
+*/
+
+#ifndef KDTREE_H
+#define KDTREE_H
+
+#include <vector>
+#include <Vector.h>
+
+			// Most points in a leaf.
+#ifndef KD_LEAF
+#define KD_LEAF 16
+#endif
+
+class KdTree {
+   public:
+      class Node {
+         public:
+            scalar split ;    // interior: the splitting coordinate
+            int    axis ;     // interior: 0, 1, 2; leaf: -1
+            int    child ;    // interior: first of two children; leaf: first point (tree order)
+            int    count ;    // leaf: points
+         } ;
+
+      KdTree() { }
+			/// Create the tree of n points.
+      KdTree(Position const* points, int n) { build(points, n) ; }
+
+			/// (Re)build THIS tree over n points.
+      void build(Position const* points, int n) ;
+
+			/// Number of points.
+      int size() const { return (int)index.size() ; }
+			/// Point i (as given to build()).
+      Position point(int i) const { const int k = slot[i] ; return Position(x[k], y[k], z[k]) ; }
+
+			/// The point nearest q within sqrt(maxDist2), and its squared distance; -1 if none.
+      int nearest(Position const& q, scalar& dist2, scalar maxDist2 = HUGE_VAL) const ;
+			/// The (up to) k points nearest q, nearest first. Returns how many were found.
+      int nearest(Position const& q, int k, int* indices, scalar* dist2,
+                  scalar maxDist2 = HUGE_VAL) const ;
+			/// indices[i] = nearest(queries[i], dist2[i], maxDist2) for 0 <= i < n, in parallel.
+      void nearestBatch(Position const* queries, int n, int* indices, scalar* dist2,
+                        scalar maxDist2 = HUGE_VAL) const ;
+
+   private:
+      std::vector<scalar> x, y, z ;   // points in tree order
+      std::vector<int>    index ;     // tree order to point index
+      std::vector<int>    slot ;      // point index to tree order
+      std::vector<Node>   nodes ;
+
+      void split(int node, int begin, int end) ;
+      static constexpr int MAX_DEPTH = 64 ;
+   } ;
+
+#endif
@@ -0,0 +1,272 @@
+/* -------- Matrix3.h -----------
+
+   3x3 Matrix Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   A plain 3x3 matrix for the small linear algebra around the vector
+   classes: covariances, normal equations, inertia tensors. Unlike
+   Transform it is an ordinary matrix: m[r][c] is row r, column c,
+   A * v takes v as a column and eigenvectors and singular vectors
+   are columns. Matrix3(mx) is the upper 3x3 of a Transform, so
+
+      v * Matrix3(mx)  ==  the linear part of  v * mx
+
+   The symmetric eigen decomposition and the SVD are by Jacobi
+   rotations (cyclic for the eigen problem, one-sided for the SVD),
+   accurate to about machine precision relative to the largest
+   eigen or singular value.
+
+   The batch functions work on many matrices stored as nine arrays
+   (Matrix3SoA), a lane per matrix: eigenBatch() and svdBatch() run a
+   fixed number of Jacobi sweeps without branches, solveBatch() is
+   Cramer's rule. The first two are compiled once per instruction
+   set and picked at run time (Dispatch.h): their straight-line
+   bodies only pay for themselves in wide vectors.
+
+*/
+
+#ifndef MATRIX3_H
+#define MATRIX3_H
+
+#include <stdio.h>
+#include <Batch.h>
+
+class Matrix3 {
+   public:
+      scalar m[3][3] ;
+
+			/// Create the identity.
+      constexpr Matrix3() ;
+			/// Create from three rows.
+      constexpr Matrix3(Vector3 const& r0, Vector3 const& r1, Vector3 const& r2) ;
+			/// Create from the upper 3x3 of mx.
+      constexpr explicit Matrix3(Transform const& mx) ;
+
+			/// The Transform with THIS as its upper 3x3 and translation t.
+      constexpr Transform transform(Vector3 const& t = Vector3()) const ;
+			/// Extract row r of THIS. (0 <= r <= 2)
+      constexpr Vector3 row(int r) const ;
+			/// Extract column c of THIS. (0 <= c <= 2)
+      constexpr Vector3 col(int c) const ;
+			/// Return the transpose of THIS.
+      constexpr Matrix3 transpose() const ;
+			/// Sum of the diagonal of THIS.
+      constexpr scalar  trace() const ;
+			/// Determinant of THIS.
+      constexpr scalar  det() const ;
+			/// Return the inverse of THIS. (Assumed to be well-conditioned.)
+      constexpr Matrix3 inverse() const ;
+
+			/// Add THIS matrix and another. (THIS + a)
+      constexpr Matrix3  operator+ (Matrix3 const& a) const ;
+			/// Add another matrix to THIS. (THIS <- THIS + a)
+      constexpr Matrix3& operator+=(Matrix3 const& a) ;
+			/// Subtract another matrix from THIS. (THIS - a)
+      constexpr Matrix3  operator- (Matrix3 const& a) const ;
+			/// Multiply THIS matrix times another. (THIS * a)
+      constexpr Matrix3  operator* (Matrix3 const& a) const ;
+			/// Multiply THIS matrix by a scalar value. (THIS * s)
+      constexpr Matrix3  operator* (scalar s) const ;
+			/// Multiply THIS matrix by a scalar value. (s * THIS)
+      friend constexpr Matrix3 operator*(scalar s, Matrix3 const& a) ;
+			/// Multiply THIS matrix times a column vector. (THIS * v)
+      constexpr Vector3  operator* (Vector3 const& v) const ;
+			/// Multiply a row vector times THIS matrix. (v * THIS)
+      friend constexpr Vector3 operator*(Vector3 const& v, Matrix3 const& a) ;
+			/// The outer product a b' (column a times row b).
+      friend constexpr Matrix3 outer(Vector3 const& a, Vector3 const& b) ;
+
+			/// The x with THIS * x = b by Cramer's rule. (0 if THIS is singular.)
+      constexpr Vector3 solve(Vector3 const& b) const ;
+			/// The x with THIS * x = b by LU with partial pivoting. False if THIS is singular.
+      bool solveLU(Vector3 const& b, Vector3& x) const ;
+
+			/// THIS (symmetric) = V diag(values) V', eigenvalues decreasing, eigenvectors the columns of V.
+      void eigen(Vector3& values, Matrix3& vectors) const ;
+			/// THIS = U diag(s) V', singular values decreasing and >= 0, U and V orthogonal.
+      void svd(Matrix3& u, Vector3& s, Matrix3& v) const ;
+   } ;
+
+/*------------------------------------------------------------
+ * n matrices as nine arrays, as the Batch.h classes store
+ * vectors: entry (r,c) of matrix i is m[r][c][i].
+ */
+class Matrix3SoA {
+   public:
+      scalar* m[3][3] ;
+
+			/// Create an empty (NULL) batch.
+      Matrix3SoA() : m() { }
+			/// Create a batch over 9 n scalars: entry (r,c) of matrix i at data[(3r + c) n + i].
+      Matrix3SoA(scalar* data, int n) : m() {
+         for (int e = 0 ; e < 9 ; e++)
+            m[e/3][e%3] = data + e*n ;
+         }
+
+			/// Element i as a matrix.
+      Matrix3 matrix(int i) const {
+         Matrix3 a ;
+         for (int e = 0 ; e < 9 ; e++)
+            a.m[e/3][e%3] = m[e/3][e%3][i] ;
+         return a ;
+         }
+			/// Store a matrix in element i.
+      void set(int i, Matrix3 const& a) const {
+         for (int e = 0 ; e < 9 ; e++)
+            m[e/3][e%3][i] = a.m[e/3][e%3] ;
+         }
+			/// The batch starting at element i.
+      Matrix3SoA operator+(int i) const {
+         Matrix3SoA b ;
+         for (int e = 0 ; e < 9 ; e++)
+            b.m[e/3][e%3] = m[e/3][e%3] + i ;
+         return b ;
+         }
+   } ;
+
+			/// eigen() of n symmetric matrices (only the upper triangles are read).
+void eigenBatch(Matrix3SoA const& a, Vector3SoA const& values,
+                Matrix3SoA const& vectors, int n) ;
+			/// svd() of n matrices: a[i] = u[i] diag(s[i]) v[i]'.
+void svdBatch(Matrix3SoA const& a, Matrix3SoA const& u, Vector3SoA const& s,
+              Matrix3SoA const& v, int n) ;
+			/// x[i] = a[i].solve(b[i]) for 0 <= i < n.
+void solveBatch(Matrix3SoA const& a, Vector3SoA const& b,
+                Vector3SoA const& x, int n) ;
+
+			/// Time the scalar and batch decompositions and solves on n random matrices and print the rates.
+void matrix3Benchmark(int n = 1<<16, FILE* out = stdout) ;
+
+/* -----------------------------------------------------------
+ *  Inline definitions
+ */
+
+constexpr Matrix3::Matrix3()
+   : m() {
+   m[0][0] = m[1][1] = m[2][2] = 1 ;
+   }
+
+constexpr Matrix3::Matrix3(Vector3 const& r0, Vector3 const& r1, Vector3 const& r2)
+   : m() {
+   m[0][0] = r0.x ;  m[0][1] = r0.y ;  m[0][2] = r0.z ;
+   m[1][0] = r1.x ;  m[1][1] = r1.y ;  m[1][2] = r1.z ;
+   m[2][0] = r2.x ;  m[2][1] = r2.y ;  m[2][2] = r2.z ;
+   }
+
+constexpr Matrix3::Matrix3(Transform const& mx)
+   : m() {
+   for (int r = 0 ; r < 3 ; r++)
+      for (int c = 0 ; c < 3 ; c++)
+         m[r][c] = mx.xform[r][c] ;
+   }
+
+constexpr Transform Matrix3::transform(Vector3 const& t) const {
+   Transform mx ;
+   for (int r = 0 ; r < 3 ; r++)
+      for (int c = 0 ; c < 3 ; c++)
+         mx.xform[r][c] = m[r][c] ;
+   mx.xform[3][0] = t.x ;
+   mx.xform[3][1] = t.y ;
+   mx.xform[3][2] = t.z ;
+   return mx ;
+   }
+
+constexpr Vector3 Matrix3::row(int r) const {
+   return Vector3(m[r][0], m[r][1], m[r][2]) ;
+   }
+
+constexpr Vector3 Matrix3::col(int c) const {
+   return Vector3(m[0][c], m[1][c], m[2][c]) ;
+   }
+
+constexpr Matrix3 Matrix3::transpose() const {
+   return Matrix3(col(0), col(1), col(2)) ;
+   }
+
+constexpr scalar Matrix3::trace() const {
+   return m[0][0] + m[1][1] + m[2][2] ;
+   }
+
+constexpr scalar Matrix3::det() const {
+   return ::det(col(0), col(1), col(2)) ;
+   }
+
+			// The adjugate (transposed cofactors) over the determinant.
+constexpr Matrix3 Matrix3::inverse() const {
+   const Vector3 r0 = row(0), r1 = row(1), r2 = row(2) ;
+   const Vector3 c0 = r1.cross(r2), c1 = r2.cross(r0), c2 = r0.cross(r1) ;
+   const scalar d = 1/r0.dot(c0) ;
+   return Matrix3(c0, c1, c2).transpose() * d ;
+   }
+
+constexpr Matrix3 Matrix3::operator+(Matrix3 const& a) const {
+   Matrix3 s ;
+   for (int r = 0 ; r < 3 ; r++)
+      for (int c = 0 ; c < 3 ; c++)
+         s.m[r][c] = m[r][c] + a.m[r][c] ;
+   return s ;
+   }
+
+constexpr Matrix3& Matrix3::operator+=(Matrix3 const& a) {
+   for (int r = 0 ; r < 3 ; r++)
+      for (int c = 0 ; c < 3 ; c++)
+         m[r][c] += a.m[r][c] ;
+   return *this ;
+   }
+
+constexpr Matrix3 Matrix3::operator-(Matrix3 const& a) const {
+   Matrix3 s ;
+   for (int r = 0 ; r < 3 ; r++)
+      for (int c = 0 ; c < 3 ; c++)
+         s.m[r][c] = m[r][c] - a.m[r][c] ;
+   return s ;
+   }
+
+constexpr Matrix3 Matrix3::operator*(Matrix3 const& a) const {
+   Matrix3 p ;
+   for (int r = 0 ; r < 3 ; r++)
+      for (int c = 0 ; c < 3 ; c++)
+         p.m[r][c] = m[r][0]*a.m[0][c] + m[r][1]*a.m[1][c] + m[r][2]*a.m[2][c] ;
+   return p ;
+   }
+
+constexpr Matrix3 Matrix3::operator*(scalar s) const {
+   Matrix3 p ;
+   for (int r = 0 ; r < 3 ; r++)
+      for (int c = 0 ; c < 3 ; c++)
+         p.m[r][c] = m[r][c]*s ;
+   return p ;
+   }
+
+constexpr Matrix3 operator*(scalar s, Matrix3 const& a) {
+   return a*s ;
+   }
+
+constexpr Vector3 Matrix3::operator*(Vector3 const& v) const {
+   return Vector3(row(0).dot(v), row(1).dot(v), row(2).dot(v)) ;
+   }
+
+constexpr Vector3 operator*(Vector3 const& v, Matrix3 const& a) {
+   return Vector3(v.dot(a.col(0)), v.dot(a.col(1)), v.dot(a.col(2))) ;
+   }
+
+constexpr Matrix3 outer(Vector3 const& a, Vector3 const& b) {
+   return Matrix3(b*a.x, b*a.y, b*a.z) ;
+   }
+
+constexpr Vector3 Matrix3::solve(Vector3 const& b) const {
+   const Vector3 c0 = col(0), c1 = col(1), c2 = col(2) ;
+   const scalar d = ::det(c0, c1, c2) ;
+   if (d == 0)
+      return Vector3() ;
+   return Vector3(::det(b, c1, c2), ::det(c0, b, c2), ::det(c0, c1, b)) * (1/d) ;
+   }
+
+#endif
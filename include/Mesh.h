@@ -0,0 +1,117 @@
+/* -------- Mesh.h -----------
+
+   Triangle Mesh Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   A triangle mesh prepared for ray intersection. Each triangle is
+   stored as the affine map into its unit triangle space (Woop,
+   "A Ray Tracing Hardware Architecture for Dynamic Scenes"):
+
+      v0 -> (0,0,0)    v1 -> (1,0,0)    v2 -> (0,1,0)    normal -> (0,0,1)
+
+   so a ray test is three dot products and a divide, with no edges
+   or cross products computed per ray. The maps are packed
+   TRIANGLE_PACK triangles at a time, coordinate by coordinate
+   (Wald's SoA layout), and one pack is tested per SIMD loop. The
+   packs are the leaves of a bounding volume hierarchy.
+
+   The mesh copies what it needs; the vertex and index arrays can
+   be freed after build(). Degenerate (zero area) triangles are
+   kept but never hit.
+
+*/
+
+#ifndef MESH_H
+#define MESH_H
+
+#include <vector>
+#include <Ray.h>
+#include <Simd.h>
+
+			// Triangles tested together: a multiple of the widest vector width.
+#ifndef TRIANGLE_PACK
+#define TRIANGLE_PACK 8
+#endif
+
+class TriangleMesh : public Traceable {
+   public:
+			/// TRIANGLE_PACK triangles, each as the rows of its world to unit triangle map.
+      class Pack {
+         public:
+            scalar m[12][TRIANGLE_PACK] ;   // u: m[0..3], v: m[4..7], w: m[8..11] (x y z 1)
+            int    id[TRIANGLE_PACK] ;      // triangle index, -1 for an unused lane
+            char   pad[SIMD_ALIGN - (12*sizeof(scalar) + sizeof(int))*TRIANGLE_PACK % SIMD_ALIGN] ;   // up to a multiple of SIMD_ALIGN
+         } ;
+
+			// Packs are stored back to back, so the padding keeps each one (and each row of m) aligned.
+      static_assert(sizeof(Pack) % SIMD_ALIGN == 0, "a Pack must be a whole number of SIMD_ALIGN blocks") ;
+
+			/// A BVH node. A leaf holds one pack.
+      class Node {
+         public:
+            Bounds box ;
+            int    child ;   // interior: first of two children; leaf: pack index
+            int    count ;   // triangles in a leaf, 0 for an interior node
+            int    axis ;    // interior: the axis the children were split on
+         } ;
+
+      TriangleMesh() ;
+			/// Create the mesh of nTriangles triangles; triangle i is vertices[indices[3i .. 3i+2]].
+      TriangleMesh(Position const* vertices, int const* indices, int nTriangles) ;
+      ~TriangleMesh() ;
+
+			/// (Re)build THIS mesh from vertex and index arrays.
+      void build(Position const* vertices, int const* indices, int nTriangles) ;
+
+			/// Number of triangles.
+      int triangleCount() const { return nTriangles ; }
+			/// Number of triangle packs.
+      int packCount() const { return nPacks ; }
+			/// Number of BVH nodes. Node 0 is the root.
+      int nodeCount() const { return (int)nodes.size() ; }
+			/// Node i of the BVH.
+      Node const& node(int i) const { return nodes[i] ; }
+			/// Pack i.
+      Pack const& pack(int i) const { return packs[i] ; }
+
+      using Traceable::intersect ;
+      using Traceable::occluded ;
+
+			/// Find the closest hit along ray: distance and barycentrics.
+      bool intersect(Ray const& ray, Hit& hit) const ;
+			/// Is there any hit along ray?
+      bool occluded(Ray const& ray) const ;
+      Bounds bounds() const ;
+			/// Packet traversal: the packet visits a node if any of its rays enters the node's box.
+      void intersectPacket(Ray const* rays, Hit* hits, int n,
+                           PacketStats* stats = 0) const ;
+      void occludedPacket(Ray const* rays, bool* blocked, int n,
+                          PacketStats* stats = 0) const ;
+
+			/// Closest hit among the triangles of pack p with tmin < t < hit.t. Returns true if hit was updated.
+      static bool intersect(Pack const& p, Ray const& ray, Hit& hit) ;
+			/// Is any triangle of pack p hit with tmin < t < tmax?
+      static bool occluded(Pack const& p, Ray const& ray) ;
+
+   private:
+      int               nTriangles ;
+      int               nPacks ;
+      Pack*             packs ;       // SIMD_ALIGN aligned, in memory
+      void*             memory ;
+      std::vector<Node> nodes ;
+
+      void tracePacket(Ray const* rays, Hit* hits, bool* blocked, int n,
+                       PacketStats* stats) const ;
+
+      TriangleMesh(TriangleMesh const&) ;              // not copyable
+      TriangleMesh& operator=(TriangleMesh const&) ;
+   } ;
+
+#endif
@@ -0,0 +1,60 @@
+/* -------- Motion.h -----------
+
+   Motion Blur Transform Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   An object moving while the shutter is open: a transform at the
+   start time and one at the end, decomposed once (Animation.h) and
+   blended part by part at each ray's time. Before the start or
+   after the end the end transform holds.
+
+      AnimatedTransform motion(open, 0, close, 1) ;
+      motion.at(rayTimes, xforms, n) ;          // one per ray
+      Bounds swept = motion.motionBounds(mesh.bounds()) ;
+
+   The swept bounds contain the object at every time in between,
+   rotation included; they are what goes into an acceleration
+   structure over moving objects.
+
+*/
+
+#ifndef MOTION_H
+#define MOTION_H
+
+#include <Animation.h>
+#include <Ray.h>
+
+class AnimatedTransform {
+   public:
+      Transform     start ;
+      Transform     end ;
+      Decomposition startParts ;
+      Decomposition endParts ;
+      scalar        startTime ;
+      scalar        endTime ;
+      bool          animated ;     // start and end differ
+
+			/// Create a transform that does not move.
+      AnimatedTransform(Transform const& mx = Transform()) ;
+			/// Create the motion from mx0 at t0 to mx1 at t1. (t0 <= t1)
+      AnimatedTransform(Transform const& mx0, scalar t0, Transform const& mx1, scalar t1) ;
+
+			/// The transform at time.
+      Transform at(scalar time) const ;
+			/// out[i] = at(times[i]) for 0 <= i < n.
+      void at(scalar const* times, Transform* out, int n) const ;
+			/// Bounds of b carried by the motion, over every time from start to end.
+      Bounds motionBounds(Bounds const& b) const ;
+
+   private:
+      scalar fraction(scalar time) const ;
+   } ;
+
+#endif
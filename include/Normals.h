@@ -0,0 +1,50 @@
+/* -------- Normals.h -----------
+
+   Point Cloud Normal Estimation Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   The normal at a point of a scanned surface, by principal component
+   analysis of its neighbourhood: the covariance of the k nearest
+   points (KdTree.h), whose eigenvector of the smallest eigenvalue is
+   the direction the neighbourhood is thinnest in. Its sign is chosen
+   so the normal faces the viewpoint (the scanner).
+
+      KdTree tree(points, n) ;
+      estimateNormals(tree, 16, scanner, normals) ;
+
+   The points are split into chunks done in parallel (Parallel.h);
+   within a chunk the covariances are gathered a block at a time and
+   decomposed by eigenBatch() (Matrix3.h).
+
+   The curvature, if asked for, is the surface variation of Pauly et
+   al.: the smallest eigenvalue over their sum, 0 on a plane and 1/3
+   for points scattered evenly in all directions.
+
+*/
+
+#ifndef NORMALS_H
+#define NORMALS_H
+
+#include <KdTree.h>
+
+			// Most neighbours used per point.
+#ifndef NORMAL_MAX_K
+#define NORMAL_MAX_K 64
+#endif
+
+			/// Normals (and optionally curvatures) of the tree's points from their k nearest (within maxDistance). A point with fewer than 3 gets a 0 normal.
+void estimateNormals(KdTree const& tree, int k, Position const& viewpoint,
+                     Direction* normals, scalar* curvature = 0,
+                     scalar maxDistance = HUGE_VAL) ;
+			/// Normals of n points, building the tree.
+void estimateNormals(Position const* points, int n, int k, Position const& viewpoint,
+                     Direction* normals, scalar* curvature = 0) ;
+
+#endif
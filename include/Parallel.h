@@ -0,0 +1,38 @@
+/* -------- Parallel.h -----------
+
+   Parallel Loop Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   Splits a loop over [0, n) into chunks of grain iterations and
+   hands the chunks out to threadCount() threads (the caller is one
+   of them). Each chunk is a contiguous range, so the body can run
+   a vectorized kernel over it.
+
+      parallelFor(n, 4096, [&](int begin, int end) {
+         kernel(in + begin, out + begin, end - begin) ;
+         }) ;
+
+   The body must not throw.
+
+*/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional>
+
+			/// Threads parallelFor() uses. (0: one per hardware thread, the default.)
+void setThreadCount(int n) ;
+			/// Threads parallelFor() will use.
+int  threadCount() ;
+			/// Call body(begin, end) over chunks of [0, n) of grain iterations, in parallel.
+void parallelFor(int n, int grain, std::function<void(int, int)> const& body) ;
+
+#endif
@@ -0,0 +1,62 @@
+/* -------- Predicates.h -----------
+
+   Robust Geometric Predicates Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   Orientation and in-circle/in-sphere tests whose SIGN is always
+   right, after Shewchuk, "Adaptive Precision Floating-Point Arithmetic
+   and Fast Robust Geometric Predicates". det() rounds; when the points
+   are (nearly) collinear, coplanar or cocircular the rounding can flip
+   its sign, and a convex hull or Delaunay triangulation built on it
+   falls apart.
+
+   Each predicate first evaluates the determinant in plain floating
+   point together with a bound on its rounding error. Nearly always
+   the value is further from 0 than the bound and is returned at once,
+   at about the cost of det(). Otherwise it is evaluated again exactly,
+   in expansion arithmetic (sums of nonoverlapping doubles); the input
+   differences that were exact to begin with stay short, so the exact
+   stage costs in proportion to how much precision the case needs.
+
+   The value returned is the determinant (approximate, but with the
+   exact determinant's sign). Requires scalar to be double, with
+   round-to-even arithmetic (no x87 extended precision).
+
+*/
+
+#ifndef PREDICATES_H
+#define PREDICATES_H
+
+#include <Batch.h>
+
+			/// Positive if a, b, c turn counterclockwise, negative if clockwise, 0 if collinear.
+scalar orient2d(Vector2 const& a, Vector2 const& b, Vector2 const& c) ;
+			/// Positive if d is below the plane of a, b, c (which then appear counterclockwise from above), 0 if coplanar.
+scalar orient3d(Position const& a, Position const& b, Position const& c, Position const& d) ;
+			/// Positive if d is inside the circle through counterclockwise a, b, c, 0 if on it.
+scalar incircle(Vector2 const& a, Vector2 const& b, Vector2 const& c, Vector2 const& d) ;
+			/// Positive if e is inside the sphere through a, b, c, d (orient3d(a,b,c,d) > 0), 0 if on it.
+scalar insphere(Position const& a, Position const& b, Position const& c,
+                Position const& d, Position const& e) ;
+
+	   // Batches: out[i] is the predicate of element i of each input.
+	   // The floating point filter runs vectorized over the whole batch;
+	   // the few elements it cannot decide are then redone exactly.
+
+void orient2dBatch(Vector2SoA const& a, Vector2SoA const& b, Vector2SoA const& c,
+                   scalar* out, int n) ;
+void orient3dBatch(Vector3SoA const& a, Vector3SoA const& b, Vector3SoA const& c,
+                   Vector3SoA const& d, scalar* out, int n) ;
+void incircleBatch(Vector2SoA const& a, Vector2SoA const& b, Vector2SoA const& c,
+                   Vector2SoA const& d, scalar* out, int n) ;
+void insphereBatch(Vector3SoA const& a, Vector3SoA const& b, Vector3SoA const& c,
+                   Vector3SoA const& d, Vector3SoA const& e, scalar* out, int n) ;
+
+#endif
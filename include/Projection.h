@@ -0,0 +1,102 @@
+/* -------- Projection.h -----------
+
+   Projection (Vertex Stage) Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   The vertex stage of a rasterizer over batches of positions:
+
+      clip   = (p, 1) * projection               (homogeneous, Vector4SoA)
+      code   = outcode(clip)                     (which frustum planes it is outside)
+      screen = viewport(clip.xyz / clip.w)       (pixels, and depth in [zNear, zFar])
+
+   Clip space is the OpenGL one: a vertex is inside when
+   -w <= x, y, z <= w. perspective() builds a matching projection
+   for the row vector convention (camera looking down -z).
+
+   projectBatch() does all of it in one pass. The divide multiplies
+   by 1/w, which is also returned for perspective correct
+   interpolation; it is computed without a branch, 0 when w is 0
+   (where stdz() would leave the vector alone). Screen coordinates
+   are only meaningful for outcode 0; triangles with other outcodes
+   go to the clipper (Clip.h) first.
+
+*/
+
+#ifndef PROJECTION_H
+#define PROJECTION_H
+
+#include <Batch.h>
+
+			// Outcode bits: the clip space planes a vertex is outside of.
+enum {
+   CLIP_LEFT   = 1,       // x < -w
+   CLIP_RIGHT  = 2,       // x >  w
+   CLIP_BOTTOM = 4,       // y < -w
+   CLIP_TOP    = 8,       // y >  w
+   CLIP_NEAR   = 16,      // z < -w
+   CLIP_FAR    = 32       // z >  w
+   } ;
+
+/*------------------------------------------------------------
+ * Normalized device coordinates to the screen: x right and y
+ * DOWN in pixels from (x0, y0), the top left corner, and depth
+ * from zNear (z = -1) to zFar (z = 1).
+ */
+class Viewport {
+   public:
+      scalar x0 ;
+      scalar y0 ;
+      scalar width ;
+      scalar height ;
+      scalar zNear ;
+      scalar zFar ;
+
+			/// Create a width x height viewport with depth from 0 to 1.
+      constexpr Viewport(scalar w, scalar h, scalar x = 0, scalar y = 0, scalar n = 0, scalar f = 1)
+         : x0(x), y0(y), width(w), height(h), zNear(n), zFar(f) { }
+
+			/// Screen position of normalized device coordinates ndc.
+      constexpr Position map(Position const& ndc) const {
+         return Position(x0 + .5*width*(ndc.x + 1), y0 + .5*height*(1 - ndc.y),
+                         zNear + .5*(zFar - zNear)*(ndc.z + 1)) ;
+         }
+   } ;
+
+			/// A perspective projection: vertical field of view (radians), width/height, zNear and zFar distances.
+Transform perspective(scalar fovy, scalar aspect, scalar zNear, scalar zFar) ;
+			/// The outcode of a clip space vector.
+constexpr int outcode(Vector4 const& clip) ;
+
+	   // Batches. The outputs must not overlap the inputs.
+
+			/// clip[i] = (p[i], 1) * mx for 0 <= i < n.
+void transformBatch(Vector3SoA const& p, Transform const& mx,
+                    Vector4SoA const& clip, int n) ;
+			/// codes[i] = outcode(clip[i]) for 0 <= i < n.
+void outcodeBatch(Vector4SoA const& clip, unsigned char* codes, int n) ;
+			/// screen[i] = vp.map(clip[i].xyz / clip[i].w) and invW[i] = 1/clip[i].w for 0 <= i < n.
+void divideBatch(Vector4SoA const& clip, Viewport const& vp,
+                 Vector3SoA const& screen, scalar* invW, int n) ;
+			/// All three in one pass. Returns the AND of the outcodes (nonzero: all outside one plane).
+int  projectBatch(Vector3SoA const& p, Transform const& mx, Viewport const& vp,
+                  Vector4SoA const& clip, unsigned char* codes,
+                  Vector3SoA const& screen, scalar* invW, int n) ;
+
+/* -----------------------------------------------------------
+ *  Inline definitions
+ */
+
+constexpr int outcode(Vector4 const& clip) {
+   return (clip.x < -clip.w ? CLIP_LEFT   : 0) | (clip.x > clip.w ? CLIP_RIGHT : 0)
+        | (clip.y < -clip.w ? CLIP_BOTTOM : 0) | (clip.y > clip.w ? CLIP_TOP   : 0)
+        | (clip.z < -clip.w ? CLIP_NEAR   : 0) | (clip.z > clip.w ? CLIP_FAR   : 0) ;
+   }
+
+#endif
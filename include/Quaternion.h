@@ -0,0 +1,167 @@
+/* -------- Quaternion.h -----------
+
+   Quaternion Class Library Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   w + xi + yj + zk. A unit quaternion is a rotation; it rotates the
+   same way as the Transform setRotate() builds from the same axis and
+   angle (counterclockwise looking down the axis), so
+
+      v * q.transform()  ==  q.rotate(v)
+
+*/
+
+#ifndef QUATERNION_H
+#define QUATERNION_H
+
+class Quaternion {
+   public:
+      scalar w ;
+      scalar x ;
+      scalar y ;
+      scalar z ;
+
+			/// Create the identity rotation (1,0,0,0).
+      constexpr Quaternion() ;
+			/// Create w + xi + yj + zk.
+      constexpr Quaternion(scalar sw, scalar sx, scalar sy, scalar sz) ;
+			/// Create a rotation about axis by radians.
+      Quaternion(Direction const& axis, scalar radians) ;
+			/// Create the rotation of the upper 3x3 of mx. (Assumed orthonormal.)
+      explicit Quaternion(Transform const& mx) ;
+
+			/// Add THIS plus q.
+      constexpr Quaternion  operator+ (Quaternion const& q) const ;
+			/// Subtract THIS minus q.
+      constexpr Quaternion  operator- (Quaternion const& q) const ;
+			/// Negate THIS. (The same rotation.)
+      constexpr Quaternion  operator- () const ;
+			/// Quaternion product: THIS * q rotates by q, then by THIS.
+      constexpr Quaternion  operator* (Quaternion const& q) const ;
+			/// Scale THIS: THIS * s.
+      constexpr Quaternion  operator* (scalar s) const ;
+			/// Scale THIS: s * THIS.
+      friend constexpr Quaternion operator* (scalar s, Quaternion const& q) ;
+			/// Dot product of THIS and q (as 4-vectors).
+      constexpr scalar      dot       (Quaternion const& q) const ;
+			/// Conjugate of THIS. (The inverse rotation of a unit quaternion.)
+      constexpr Quaternion  conj      () const ;
+
+			/// Get the length of THIS.
+      scalar len() const ;
+			/// Normalize THIS (to unit quaternion), return former length.
+      scalar norm() ;
+
+			/// Rotate v by THIS unit quaternion.
+      constexpr Vector3   rotate(Vector3 const& v) const ;
+			/// Rotate a position about the origin by THIS unit quaternion.
+      constexpr Position  rotate(Position const& p) const ;
+			/// Rotate a direction by THIS unit quaternion.
+      constexpr Direction rotate(Direction const& d) const ;
+			/// The rotation matrix of THIS unit quaternion.
+      constexpr Transform transform() const ;
+
+			/// Spherical linear interpolation from a (t=0) to b (t=1) the short way round.
+      friend Quaternion slerp(Quaternion const& a, Quaternion const& b, scalar t) ;
+			/// Normalized linear interpolation: cheaper than slerp, not constant speed.
+      friend Quaternion nlerp(Quaternion const& a, Quaternion const& b, scalar t) ;
+   } ;
+
+/* -----------------------------------------------------------
+ *  Inline definitions
+ */
+
+constexpr Quaternion::Quaternion()
+   : w(1), x(0), y(0), z(0) {
+   }
+
+constexpr Quaternion::Quaternion(scalar sw, scalar sx, scalar sy, scalar sz)
+   : w(sw), x(sx), y(sy), z(sz) {
+   }
+
+constexpr Quaternion Quaternion::operator+(Quaternion const& q) const {
+   return Quaternion(w+q.w, x+q.x, y+q.y, z+q.z) ;
+   }
+
+constexpr Quaternion Quaternion::operator-(Quaternion const& q) const {
+   return Quaternion(w-q.w, x-q.x, y-q.y, z-q.z) ;
+   }
+
+constexpr Quaternion Quaternion::operator-() const {
+   return Quaternion(-w, -x, -y, -z) ;
+   }
+
+constexpr Quaternion Quaternion::operator*(Quaternion const& q) const {
+   return Quaternion(w*q.w - x*q.x - y*q.y - z*q.z,
+                     w*q.x + x*q.w + y*q.z - z*q.y,
+                     w*q.y - x*q.z + y*q.w + z*q.x,
+                     w*q.z + x*q.y - y*q.x + z*q.w) ;
+   }
+
+constexpr Quaternion Quaternion::operator*(scalar s) const {
+   return Quaternion(w*s, x*s, y*s, z*s) ;
+   }
+
+constexpr Quaternion operator*(scalar s, Quaternion const& q) {
+   return Quaternion(s*q.w, s*q.x, s*q.y, s*q.z) ;
+   }
+
+constexpr scalar Quaternion::dot(Quaternion const& q) const {
+   return w*q.w + x*q.x + y*q.y + z*q.z ;
+   }
+
+constexpr Quaternion Quaternion::conj() const {
+   return Quaternion(w, -x, -y, -z) ;
+   }
+
+/** -----------------------------------------------------------
+ * v + 2w (u x v) + 2 u x (u x v), u the vector part: the
+ * expansion of q v q* without the full products.
+ **/
+constexpr Vector3 Quaternion::rotate(Vector3 const& v) const {
+   const Vector3 u(x, y, z) ;
+   const Vector3 c = u.cross(v) * 2 ;
+   return v + c*w + u.cross(c) ;
+   }
+
+constexpr Position Quaternion::rotate(Position const& p) const {
+   return Position(rotate(Vector(p))) ;
+   }
+
+constexpr Direction Quaternion::rotate(Direction const& d) const {
+   const Vector3 v = rotate(Vector(d)) ;
+   return Direction::Unit(v.x, v.y, v.z) ;
+   }
+
+/** -----------------------------------------------------------
+ * The matrix of q v q* for row vectors (the transpose of the
+ * usual column vector form).
+ **/
+constexpr Transform Quaternion::transform() const {
+   Transform mx ;
+   const scalar xx = x*x, yy = y*y, zz = z*z ;
+   const scalar xy = x*y, xz = x*z, yz = y*z ;
+   const scalar wx = w*x, wy = w*y, wz = w*z ;
+
+   mx.xform[0][0] = 1 - 2*(yy + zz) ;
+   mx.xform[0][1] = 2*(xy + wz) ;
+   mx.xform[0][2] = 2*(xz - wy) ;
+
+   mx.xform[1][0] = 2*(xy - wz) ;
+   mx.xform[1][1] = 1 - 2*(xx + zz) ;
+   mx.xform[1][2] = 2*(yz + wx) ;
+
+   mx.xform[2][0] = 2*(xz + wy) ;
+   mx.xform[2][1] = 2*(yz - wx) ;
+   mx.xform[2][2] = 1 - 2*(xx + yy) ;
+   return mx ;
+   }
+
+#endif
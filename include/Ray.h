@@ -0,0 +1,224 @@
+/* -------- Ray.h -----------
+
+   Ray, Hit and Bounds Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   The common currency of the ray tracing modules. A ray is the set
+   of positions origin + t * direction for tmin < t < tmax. Anything
+   a ray can be traced against (a TriangleMesh, a ray stream's target,
+   an instance) implements Traceable.
+
+*/
+
+#ifndef RAY_H
+#define RAY_H
+
+#include <Vector.h>
+
+			// Most rays traced together as one packet.
+#ifndef RAY_PACKET
+#define RAY_PACKET 16
+#endif
+
+class Ray {
+   public:
+      Position  origin ;
+      Direction direction ;
+      scalar    tmin ;
+      scalar    tmax ;
+
+			/// Create a NULL ray.
+      constexpr Ray() : origin(), direction(), tmin(0), tmax(HUGE_VAL) { }
+			/// Create a ray from o in direction d, for tmin < t < tmax.
+      constexpr Ray(Position const& o, Direction const& d,
+                    scalar t0 = 0, scalar t1 = HUGE_VAL)
+         : origin(o), direction(d), tmin(t0), tmax(t1) { }
+
+			/// The position at distance t along THIS ray.
+      constexpr Position at(scalar t) const { return origin + direction*t ; }
+   } ;
+
+class Hit {
+   public:
+      scalar t ;           // distance along the ray
+      scalar u ;           // barycentric coordinates: the hit is
+      scalar v ;           //    (1-u-v)*v0 + u*v1 + v*v2
+      int    triangle ;    // triangle index, -1 for a miss
+      int    instance ;    // instance index in the outermost InstanceTree, -1 if not instanced
+
+			/// Create a miss.
+      constexpr Hit() : t(HUGE_VAL), u(0), v(0), triangle(-1), instance(-1) { }
+
+			/// Did the ray hit anything?
+      constexpr bool hit() const { return triangle >= 0 ; }
+   } ;
+
+class Bounds {
+   public:
+      Position lo ;
+      Position hi ;
+
+			/// Create empty bounds (lo > hi).
+      constexpr Bounds() : lo(HUGE_VAL, HUGE_VAL, HUGE_VAL), hi(-HUGE_VAL, -HUGE_VAL, -HUGE_VAL) { }
+			/// Create bounds from two corners.
+      constexpr Bounds(Position const& a, Position const& b) : lo(a), hi(b) { }
+
+			/// Do THESE bounds contain nothing?
+      constexpr bool empty() const { return lo.x > hi.x || lo.y > hi.y || lo.z > hi.z ; }
+			/// Grow THESE bounds to contain p.
+      constexpr Bounds& extend(Position const& p) ;
+			/// Grow THESE bounds to contain b.
+      constexpr Bounds& extend(Bounds const& b) ;
+			/// Center of THESE bounds.
+      constexpr Position center() const { return (lo + (hi - lo)*.5) ; }
+			/// Size of THESE bounds along each axis.
+      constexpr Vector3 extent() const { return hi - lo ; }
+			/// Surface area of THESE bounds.
+      constexpr scalar area() const ;
+			/// Does the ray pass through THESE bounds between tmin and tmax? invDir is 1/direction.
+      bool intersect(Position const& origin, Vector3 const& invDir,
+                     scalar tmin, scalar tmax) const ;
+			/// The bounds of THESE bounds transformed by mx.
+      Bounds transform(Transform const& mx) const ;
+   } ;
+
+/*------------------------------------------------------------
+ * Counters for packet tracing. Each time a packet visits a node
+ * of an acceleration structure, slots grows by the packet size
+ * and lanes by the number of its rays still in the node; lanes /
+ * slots is the fraction of the SIMD width doing useful work.
+ */
+class PacketStats {
+   public:
+      long rays ;
+      long packets ;
+      long visits ;
+      long slots ;
+      long lanes ;
+
+      constexpr PacketStats() : rays(0), packets(0), visits(0), slots(0), lanes(0) { }
+
+			/// Fraction of packet lanes active per node visit (1 if nothing was visited).
+      constexpr double utilization() const { return slots ? (double)lanes/slots : 1 ; }
+			/// Add another set of counts to THESE.
+      constexpr PacketStats& operator+=(PacketStats const& s) ;
+   } ;
+
+/*------------------------------------------------------------
+ * Something rays can be traced against. The batch versions
+ * loop over the single ray versions unless overridden.
+ */
+class Traceable {
+   public:
+      virtual ~Traceable() { }
+
+			/// Find the closest hit along ray. Sets hit and returns true if there is one.
+      virtual bool intersect(Ray const& ray, Hit& hit) const = 0 ;
+			/// Is there any hit along ray? (Shadow rays: stops at the first.)
+      virtual bool occluded(Ray const& ray) const = 0 ;
+			/// Bounds of everything that can be hit.
+      virtual Bounds bounds() const = 0 ;
+
+			/// intersect(rays[i], hits[i]) for 0 <= i < n.
+      virtual void intersect(Ray const* rays, Hit* hits, int n) const ;
+			/// blocked[i] = occluded(rays[i]) for 0 <= i < n.
+      virtual void occluded(Ray const* rays, bool* blocked, int n) const ;
+			/// Trace n coherent rays together (n <= RAY_PACKET), as intersect(). Counts into stats unless NULL.
+      virtual void intersectPacket(Ray const* rays, Hit* hits, int n,
+                                   PacketStats* stats = 0) const ;
+			/// Trace n coherent shadow rays together (n <= RAY_PACKET), as occluded().
+      virtual void occludedPacket(Ray const* rays, bool* blocked, int n,
+                                  PacketStats* stats = 0) const ;
+   } ;
+
+/*------------------------------------------------------------
+ * The rays of a packet lane by lane, and the BVH traversal the
+ * packet tracers share. A node is entered if any live lane's
+ * interval passes through its box; in[] marks those lanes. The
+ * children are visited in the order of the first lane in; in a
+ * coherent packet it suits them all. A leaf callback shortens
+ * t1 as hits are found and clears live when a lane is done.
+ */
+class RayPacket {
+   public:
+      scalar ox[RAY_PACKET], oy[RAY_PACKET], oz[RAY_PACKET] ;   // origins
+      scalar ix[RAY_PACKET], iy[RAY_PACKET], iz[RAY_PACKET] ;   // 1/direction
+      scalar t0[RAY_PACKET], t1[RAY_PACKET] ;                   // intervals
+      bool   live[RAY_PACKET] ;
+      bool   in[RAY_PACKET] ;
+      int    size ;
+
+			/// Load n rays. Resets hits (to misses at tmax) or blocked, whichever is not NULL, and counts the packet into stats.
+      RayPacket(Ray const* rays, int n, Hit* hits, bool* blocked, PacketStats* stats) ;
+
+			/// Set in[] to the live lanes that pass through b. Returns how many; counts the visit into stats.
+      int enter(Bounds const& b, PacketStats* stats) ;
+			/// Visit the BVH nodes[0..count-1] (with box, child, count and axis), calling leaf(node) for each leaf entered.
+      template <class Node, class Leaf>
+      void traverse(Node const* nodes, int count, PacketStats* stats, Leaf const& leaf) ;
+			/// Set t of the lanes that hit nothing to HUGE_VAL.
+      void finish(Hit* hits) const ;
+   } ;
+
+/* -----------------------------------------------------------
+   Inline definitions
+ */
+
+template <class Node, class Leaf>
+void RayPacket::traverse(Node const* nodes, int count, PacketStats* stats, Leaf const& leaf) {
+   int stack[64], top = 0 ;
+   if (count)
+      stack[top++] = 0 ;
+   while (top) {
+      Node const& node = nodes[stack[--top]] ;
+      if (!enter(node.box, stats))
+         continue ;
+      if (node.count) {
+         leaf(node) ;
+         continue ;
+         }
+
+      int first = 0 ;
+      while (!in[first])
+         first++ ;
+      const scalar inv = (node.axis == 0) ? ix[first] : (node.axis == 1) ? iy[first] : iz[first] ;
+      const bool negative = inv < 0 ;
+      stack[top++] = node.child + !negative ;
+      stack[top++] = node.child + negative ;
+      }
+   }
+
+constexpr Bounds& Bounds::extend(Position const& p) {
+   lo.set(MIN(lo.x, p.x), MIN(lo.y, p.y), MIN(lo.z, p.z)) ;
+   hi.set(MAX(hi.x, p.x), MAX(hi.y, p.y), MAX(hi.z, p.z)) ;
+   return *this ;
+   }
+
+constexpr Bounds& Bounds::extend(Bounds const& b) {
+   lo.set(MIN(lo.x, b.lo.x), MIN(lo.y, b.lo.y), MIN(lo.z, b.lo.z)) ;
+   hi.set(MAX(hi.x, b.hi.x), MAX(hi.y, b.hi.y), MAX(hi.z, b.hi.z)) ;
+   return *this ;
+   }
+
+constexpr PacketStats& PacketStats::operator+=(PacketStats const& s) {
+   rays += s.rays ;
+   packets += s.packets ;
+   visits += s.visits ;
+   slots += s.slots ;
+   lanes += s.lanes ;
+   return *this ;
+   }
+
+constexpr scalar Bounds::area() const {
+   const Vector3 e = hi - lo ;
+   return empty() ? 0 : 2*(e.x*e.y + e.y*e.z + e.z*e.x) ;
+   }
+
+#endif
@@ -0,0 +1,81 @@
+/* -------- RayStream.h -----------
+
+   Ray Stream (Coherent Batch Tracing) Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   Secondary rays arrive in no useful order. A ray stream sorts a
+   large batch of them so that neighbours in the sorted order start
+   near each other and head the same way, then traces them packetSize
+   at a time with Traceable::intersectPacket(), and puts the results
+   back in the caller's order.
+
+   The sort key is the ray's direction bin - the axis and sign of the
+   direction's major axis, as Direction::majorAxis() picks it (ties
+   go to x, then y) - followed by a Morton code of where on that
+   cube face the direction points and where the origin lies within
+   the bounds of all the origins.
+
+   Utilization is reported as the fraction of packet lanes still
+   active per node visited (PacketStats); incoherent rays trace
+   correctly but visit many nodes with few lanes.
+
+      RayStream stream ;
+      stream.trace(mesh, origins, directions, hits, n) ;
+      stream.report(stdout) ;       // rays, packets, SIMD utilization
+
+*/
+
+#ifndef RAYSTREAM_H
+#define RAYSTREAM_H
+
+#include <stdio.h>
+#include <vector>
+#include <Ray.h>
+
+class RayStream {
+   public:
+			/// Create a stream that traces packets of packetSize rays. (1 <= packetSize <= RAY_PACKET)
+      RayStream(int packetSize = RAY_PACKET) ;
+
+			/// Closest hits of the rays (origins[i], directions[i]) with tmin < t < tmax.
+      void trace(Traceable const& target, Position const* origins,
+                 Direction const* directions, Hit* hits, int n,
+                 scalar tmin = 0, scalar tmax = HUGE_VAL) ;
+			/// Closest hits of an array of rays.
+      void trace(Traceable const& target, Ray const* rays, Hit* hits, int n) ;
+			/// Shadow rays: blocked[i] is set if anything is hit.
+      void occluded(Traceable const& target, Position const* origins,
+                    Direction const* directions, bool* blocked, int n,
+                    scalar tmin = 0, scalar tmax = HUGE_VAL) ;
+      void occluded(Traceable const& target, Ray const* rays, bool* blocked, int n) ;
+
+			/// Counts accumulated since the stream was created or reset().
+      PacketStats const& stats() const { return counts ; }
+			/// Clear the counts.
+      void reset() { counts = PacketStats() ; }
+			/// Print the counts and SIMD utilization.
+      void report(FILE* out = stdout) const ;
+
+			/// Direction bin of d: 2*axis + (negative), axis as majorAxis() picks it. (0..5)
+      static int octant(Direction const& d) ;
+
+   private:
+      int                     packetSize ;
+      PacketStats             counts ;
+      std::vector<unsigned long long> keys ;   // sort key << 32 | ray index
+      std::vector<Ray>        input ;          // rays built from origin and direction arrays
+      std::vector<Ray>        sorted ;
+
+      void sort(Ray const* rays, int n) ;
+      Ray const* gather(Position const* origins, Direction const* directions,
+                        int n, scalar tmin, scalar tmax) ;
+   } ;
+
+#endif
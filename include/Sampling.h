@@ -0,0 +1,83 @@
+/* -------- Sampling.h -----------
+
+   Monte Carlo Sampling Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   Sample generation in two steps: numbers in [0,1) from a random
+   stream or a low discrepancy sequence, then a warp of pairs of them
+   onto a domain. The warps produce unit vectors by construction, so
+   the output directions are never normalized (compare the Direction
+   constructor); they are written to SoA batches in chunks, with the
+   trigonometry from VMath.h. Hemispheres are turned about the normal
+   with a Frame (Frame.h).
+
+      RandomStream rng(seed) ;
+      rng.uniform(u1, n) ;
+      rng.uniform(u2, n) ;                  // or sobol2D(0, u1, u2, n)
+      sampleHemisphereCosine(normal, u1, u2, dirs, n) ;
+
+   The warps are the area preserving ones, so stratified or low
+   discrepancy input stays well distributed on the domain.
+
+*/
+
+#ifndef SAMPLING_H
+#define SAMPLING_H
+
+#include <Batch.h>
+
+/*------------------------------------------------------------
+ * Counter based random numbers: number i of a stream is a hash
+ * of (seed, i), so any stretch of the stream can be produced by
+ * one vectorized loop and separate streams (per thread, per
+ * pixel) need nothing but different seeds. Resolution is 2^-32.
+ */
+class RandomStream {
+   public:
+      unsigned           seed ;
+      unsigned long long counter ;   // numbers drawn so far
+
+			/// Create stream seed, starting at its first number.
+      RandomStream(unsigned s = 0, unsigned long long start = 0) : seed(s), counter(start) { }
+
+			/// The next n numbers in [0,1).
+      void uniform(scalar* out, int n) ;
+			/// The next number in [0,1).
+      scalar uniform() ;
+   } ;
+
+	   // Sequences. Points index .. index+n-1 of each; the scramble
+	   // is XORed into the bits (0 for the plain sequence).
+
+			/// The first two dimensions of the Sobol sequence.
+void sobol2D(unsigned index, scalar* u1, scalar* u2, int n,
+             unsigned scramble1 = 0, unsigned scramble2 = 0) ;
+			/// The radical inverse of index in base (Halton dimension for a prime base).
+			/// Throws std::invalid_argument if base < 2.
+void halton(int base, unsigned index, scalar* out, int n) ;
+			/// nx * ny jittered points, one in each cell of an nx by ny grid, row by row.
+void stratified(int nx, int ny, RandomStream& rng, scalar* u1, scalar* u2) ;
+
+	   // Warps. (u1[i], u2[i]) in [0,1)^2 to element i of the output.
+
+			/// Uniform on the unit sphere.
+void sampleSphere(scalar const* u1, scalar const* u2,
+                  Vector3SoA const& out, int n) ;
+			/// Uniform on the hemisphere about normal.
+void sampleHemisphere(Direction const& normal, scalar const* u1, scalar const* u2,
+                      Vector3SoA const& out, int n) ;
+			/// Cosine weighted on the hemisphere about normal (density cos(theta)/PI).
+void sampleHemisphereCosine(Direction const& normal, scalar const* u1, scalar const* u2,
+                            Vector3SoA const& out, int n) ;
+			/// Uniform on the unit disk (Shirley's concentric map).
+void sampleDisk(scalar const* u1, scalar const* u2,
+                Vector2SoA const& out, int n) ;
+
+#endif
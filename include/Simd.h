@@ -0,0 +1,87 @@
+/* -------- Simd.h -----------
+
+   SIMD Support Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   The bulk kernels are written as plain loops over structure-of-arrays
+   data with no branches in the loop body, so the compiler turns each
+   iteration into one SIMD lane at whatever width the target allows.
+   These macros tell it that it may. A loop that also sums (or ANDs,
+   ORs, ...) into a scalar must say so with SIMD_REDUCE, not
+   SIMD_LOOP: under OpenMP a reduction needs its clause.
+
+   GCC and Clang will not vectorize a loop that calls sqrt() unless
+   errno need not be set: compile with -O3 -fno-math-errno (and an
+   -m or -march option for the widest instruction set wanted).
+   Without them the kernels are still correct, only slower. The 3D
+   kernels of Batch.h need no -m option: they are compiled for each
+   instruction set and picked at run time (Dispatch.h).
+
+*/
+
+#ifndef SIMD_H
+#define SIMD_H
+
+			// Alignment (bytes) of bulk arrays: one cache line, enough for any vector register.
+#ifndef SIMD_ALIGN
+#define SIMD_ALIGN 64
+#endif
+
+			// Width (bytes) of the widest vector register the target is compiled for.
+#ifndef SIMD_BYTES
+#if defined(__AVX512F__)
+#define SIMD_BYTES 64
+#elif defined(__AVX__)
+#define SIMD_BYTES 32
+#else
+#define SIMD_BYTES 16
+#endif
+#endif
+
+			// Number of scalars per vector register.
+#ifndef SIMD_WIDTH
+#define SIMD_WIDTH ((int)(SIMD_BYTES / sizeof(scalar)))
+#endif
+
+			// Pointer does not alias any other pointer in scope.
+#ifndef RESTRICT
+#if defined(__GNUC__) || defined(_MSC_VER)
+#define RESTRICT __restrict
+#else
+#define RESTRICT
+#endif
+#endif
+
+			// The following loop has no loop-carried dependences; vectorize it.
+#ifndef SIMD_LOOP
+#if defined(_OPENMP)
+#define SIMD_LOOP _Pragma("omp simd")
+#elif defined(__clang__)
+#define SIMD_LOOP _Pragma("clang loop vectorize(enable) interleave(enable)")
+#elif defined(__GNUC__)
+#define SIMD_LOOP _Pragma("GCC ivdep")
+#elif defined(_MSC_VER)
+#define SIMD_LOOP __pragma(loop(ivdep))
+#else
+#define SIMD_LOOP
+#endif
+#endif
+
+			// As SIMD_LOOP, but the loop also reduces the listed variables by op (+, &, |, ...).
+#ifndef SIMD_REDUCE
+#if defined(_OPENMP)
+#define SIMD_PRAGMA(x) _Pragma(#x)
+#define SIMD_REDUCE(op, ...) SIMD_PRAGMA(omp simd reduction(op: __VA_ARGS__))
+#else
+#define SIMD_REDUCE(op, ...) SIMD_LOOP
+#endif
+#endif
+
+#endif
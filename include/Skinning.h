@@ -0,0 +1,130 @@
+/* -------- Skinning.h -----------
+
+   Skinning (Vertex Blending) Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   Each vertex i is moved by up to SKIN_INFLUENCES joints of a
+   palette: joint joints[SKIN_INFLUENCES*i + k] with weight
+   weights[SKIN_INFLUENCES*i + k]. The weights of a vertex should
+   sum to 1; unused influences have weight 0 (and any valid joint).
+
+   Linear blend skinning averages the joint matrices. Dual quaternion
+   skinning (Kavan et al., "Skinning with Dual Quaternions") averages
+   rigid motions instead, so it does not collapse volume at twisting
+   joints, but it cannot carry scale or shear.
+
+   The vertices are split into chunks and the chunks are skinned in
+   parallel (Parallel.h). Normals are optional: pass empty batches to
+   skip them.
+   The outputs must not overlap the inputs.
+
+*/
+
+#ifndef SKINNING_H
+#define SKINNING_H
+
+#include <Batch.h>
+
+			// Joints per vertex.
+#ifndef SKIN_INFLUENCES
+#define SKIN_INFLUENCES 4
+#endif
+
+/*------------------------------------------------------------
+ * An affine transform without the constant last column of a
+ * Transform: rows 0-2 are the linear part, row 3 the translation.
+ * 12 scalars rather than 16 per joint.
+ */
+class Affine3 {
+   public:
+      scalar xform[4][3] ;
+
+			/// Create the identity.
+      constexpr Affine3() ;
+			/// Create from the first three columns of mx. (Assumed affine.)
+      constexpr Affine3(Transform const& mx) ;
+
+			/// Convert THIS to a Transform.
+      constexpr Transform transform() const ;
+   } ;
+
+/*------------------------------------------------------------
+ * A rigid motion: rotation real, then translation t, with
+ * dual = t q / 2 for the pure quaternion t.
+ */
+class DualQuaternion {
+   public:
+      Quaternion real ;
+      Quaternion dual ;
+
+			/// Create the identity.
+      constexpr DualQuaternion() : real(), dual(0, 0, 0, 0) { }
+			/// Create the rotation q followed by the translation t.
+      constexpr DualQuaternion(Quaternion const& q, Vector3 const& t) ;
+			/// Create from the rotation and translation of mx. (Assumed rigid.)
+      explicit DualQuaternion(Transform const& mx) ;
+
+			/// The translation of THIS (unit) dual quaternion.
+      constexpr Vector3  translation() const ;
+			/// Move p by THIS (unit) dual quaternion.
+      constexpr Position transform(Position const& p) const ;
+   } ;
+
+			/// Linear blend skinning with a palette of affine joint transforms.
+void skinLinear(Affine3 const* palette, int const* joints, scalar const* weights,
+                Vector3SoA const& positions, Vector3SoA const& normals,
+                Vector3SoA const& outPositions, Vector3SoA const& outNormals,
+                int n) ;
+			/// Dual quaternion skinning with a palette of rigid joint transforms.
+void skinDualQuaternion(DualQuaternion const* palette, int const* joints,
+                        scalar const* weights,
+                        Vector3SoA const& positions, Vector3SoA const& normals,
+                        Vector3SoA const& outPositions, Vector3SoA const& outNormals,
+                        int n) ;
+
+/* -----------------------------------------------------------
+ *  Inline definitions
+ */
+
+constexpr Affine3::Affine3()
+   : xform() {
+   xform[0][0] = xform[1][1] = xform[2][2] = 1 ;
+   }
+
+constexpr Affine3::Affine3(Transform const& mx)
+   : xform() {
+   for (int r = 0 ; r < 4 ; r++)
+      for (int c = 0 ; c < 3 ; c++)
+         xform[r][c] = mx.xform[r][c] ;
+   }
+
+constexpr Transform Affine3::transform() const {
+   Transform mx ;
+   for (int r = 0 ; r < 4 ; r++)
+      for (int c = 0 ; c < 3 ; c++)
+         mx.xform[r][c] = xform[r][c] ;
+   return mx ;
+   }
+
+constexpr DualQuaternion::DualQuaternion(Quaternion const& q, Vector3 const& t)
+   : real(q), dual(Quaternion(0, t.x, t.y, t.z) * q * .5) {
+   }
+
+			// 2 (dual real*), whose scalar part is 0.
+constexpr Vector3 DualQuaternion::translation() const {
+   const Quaternion t = dual * real.conj() ;
+   return Vector3(2*t.x, 2*t.y, 2*t.z) ;
+   }
+
+constexpr Position DualQuaternion::transform(Position const& p) const {
+   return real.rotate(p) + translation() ;
+   }
+
+#endif
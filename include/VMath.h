@@ -0,0 +1,51 @@
+/* -------- VMath.h -----------
+
+   Vector Math (Bulk Elementary Functions) Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   sin, cos, atan2 and sqrt over arrays, in float and double. The
+   functions are polynomial approximations (Cephes, Moshier) with
+   branch-free range reduction, so each loop vectorizes; the libm
+   function is called one value at a time only for the arguments
+   beyond the reduction's range.
+
+   Error bounds (max over the full range, measured against libm in
+   long double, round-to-nearest):
+
+      vsin, vcos, vsincos   double   2 ULP      |x| < 1e8 (libm beyond)
+                            float    2 ULP      |x| < 8192 (libm beyond)
+      vatan2                double   2 ULP      finite y, x
+                            float    3 ULP      finite y, x
+      vsqrt                 both     correctly rounded (hardware)
+
+   in and out may be the same array. Other arrays must not overlap.
+
+*/
+
+#ifndef VMATH_H
+#define VMATH_H
+
+			/// out[i] = sin(in[i]) for 0 <= i < n.
+void vsin(double const* in, double* out, int n) ;
+void vsin(float const* in, float* out, int n) ;
+			/// out[i] = cos(in[i]) for 0 <= i < n.
+void vcos(double const* in, double* out, int n) ;
+void vcos(float const* in, float* out, int n) ;
+			/// s[i] = sin(in[i]), c[i] = cos(in[i]) for 0 <= i < n.
+void vsincos(double const* in, double* s, double* c, int n) ;
+void vsincos(float const* in, float* s, float* c, int n) ;
+			/// out[i] = atan2(y[i], x[i]) for 0 <= i < n.
+void vatan2(double const* y, double const* x, double* out, int n) ;
+void vatan2(float const* y, float const* x, float* out, int n) ;
+			/// out[i] = sqrt(in[i]) for 0 <= i < n.
+void vsqrt(double const* in, double* out, int n) ;
+void vsqrt(float const* in, float* out, int n) ;
+
+#endif
@@ -51,7 +51,9 @@
 #include <math.h>
 #include <Vector2.h>
 #include <Vector3.h>
-#include <xform.h>
+#include <Xform.h>
+#include <Xform2.h>
+#include <Quaternion.h>
 
 
 #endif
@@ -3,69 +3,12 @@
    2D Vector Class Library Header
    Copyright 1994-2008,2021 Bill Leonard
 
-   The author will not be liable for any bug, error, omission,
-   defect,/*--------- Vector.h ----------------------------------
-
-   Vector Class Library Header
-   Copyright 1994-2008,2021 Bill Leonard
-
    The author will not be liable for any bug, error, omission,
    defect, deficiency, or nonconformity in this software. The author
    also disclaims all implied warranties, including without limitation
    warranties of merchantability, performance, and fitness for a
    particular purpose. This software is provided "as is" and the user
    assumes the entire risk as to its quality and performance.
-*/
-
-#ifndef VECTOR_H
-#define VECTOR_H
-
-#ifndef scalar
-#define scalar double
-#endif
-#ifndef FRACTION
-#define FRACTION(A)     ( (A) - (long)(A) )
-#endif
-#ifndef EPSILON
-#define EPSILON 1e-7
-#endif
-#ifndef INFINITY
-#define INFINITY 1./EPSILON
-#endif
-#ifndef ABS
-#define ABS(a) ((a) < 0 ? -(a) : (a))
-#endif
-#ifndef SGN
-#define SGN(a) ((a) != 0 ? (ABS(a)/(a)) : (0))
-#endif
-#ifndef MAX
-#define MAX(a,b) ((a) > (b) ? (a) : (b))
-#endif
-#ifndef MIN
-#define MIN(a,b) ((a) < (b) ? (a) : (b))
-#endif
-#ifndef PI
-#define PI 3.141592653589793
-#endif
-#ifndef DEGREES
-#define DEGREES(s) ((s) * 180/PI)
-#endif
-#ifndef RADIANS
-#define RADIANS(s) ((s) * PI/180)
-#endif
-
-#include <math.h>
-#include <Vector2.h>
-#include <Vector3.h>
-#include <xform.h>
-
-
-#endif
- deficiency, or nonconformity in this software. The author
-   also disclaims all implied warranties, including without limitation
-   warranties of merchantability, performance, and fitness for a
-   particular purpose. This software is provided "as is" and the user
-   assumes the entire risk as to its quality and performance.
 
  */
 
@@ -77,41 +20,136 @@ class Vector2 {
       scalar x ;
       scalar y ;
 
-      Vector2() ;
-      Vector2(scalar sx, scalar sy) ;
+      constexpr Vector2() ;
+      constexpr Vector2(scalar sx, scalar sy) ;
 
-      Vector2& set(scalar a, scalar b) ;
+      constexpr Vector2& set(scalar a, scalar b) ;
 
 			/// Add THIS plus v: THIS + v.
-      Vector2  operator+ (Vector2 const& v) const ;
+      constexpr Vector2  operator+ (Vector2 const& v) const ;
 			/// Add v to THIS: THIS = THIS + v.
-      Vector2& operator+=(Vector2 const& v) ;
+      constexpr Vector2& operator+=(Vector2 const& v) ;
 			/// Subtract THIS minus v: THIS - v.
-      Vector2  operator- (Vector2 const& v) const ;
+      constexpr Vector2  operator- (Vector2 const& v) const ;
 			/// Subtract v from THIS: THIS = THIS - v.
-      Vector2& operator-=(Vector2 const& v) ;
+      constexpr Vector2& operator-=(Vector2 const& v) ;
 			/// Negate THIS: -THIS;
-      Vector2  operator- () const ;
+      constexpr Vector2  operator- () const ;
 			/// Scale THIS: THIS * s.
-      Vector2  operator* (scalar s) const ;
+      constexpr Vector2  operator* (scalar s) const ;
 			/// Scale THIS: THIS = THIS * s.
-      Vector2& operator*=(scalar s) ;
+      constexpr Vector2& operator*=(scalar s) ;
 			/// Scale THIS: s * THIS.
-      friend Vector2 operator* (scalar s, Vector2 const& v) ;
+      friend constexpr Vector2 operator* (scalar s, Vector2 const& v) ;
 			/// Scale THIS: THIS * 1/s.
-      Vector2  operator/ (scalar s) const ;
+      constexpr Vector2  operator/ (scalar s) const ;
 			/// Scale THIS: THIS = THIS * 1/s.
-      Vector2& operator/=(scalar s) ;
+      constexpr Vector2& operator/=(scalar s) ;
 	        /// Dot Product of THIS and v: THIS dot v.
-      scalar   dot       (Vector2 const& v) const ;
+      constexpr scalar   dot       (Vector2 const& v) const ;
 			/// Coordinate-by-coordinate multiplication: THIS.x * v.x, THIS.y * v.y.
-      Vector2  operator* (Vector2 const& v) const ;
+      constexpr Vector2  operator* (Vector2 const& v) const ;
 			/// Coordinate-by-coordinate multiplication: THIS.x = THIS.x * v.x, etc.
-      Vector2  operator*=(Vector2 const& v) ;         /// coord-by-coord
+      constexpr Vector2  operator*=(Vector2 const& v) ;         /// coord-by-coord
 			/// Smallest magnitude coordinate (absolute value) of THIS.
-      scalar   minCoord() const ;
+      constexpr scalar   minCoord() const ;
 			/// Largest magnitude coordinate (absolute value) of THIS.
-      scalar   maxCoord() const ;
+      constexpr scalar   maxCoord() const ;
    } ;
 
+/* -----------------------------------------------------------
+ *  Inline definitions. Everything here is constexpr so that
+ *  constant vectors are folded at compile time.
+ */
+
+constexpr Vector2::Vector2()
+   : x(0), y(0) {
+   }
+
+constexpr Vector2::Vector2(scalar sx, scalar sy)
+   : x(sx), y(sy) {
+   }
+
+constexpr Vector2& Vector2::set(scalar sx, scalar sy) {
+   x = sx ; y = sy ;
+   return *this ;
+   }
+
+constexpr Vector2 Vector2::operator+(Vector2 const& v) const {
+   return Vector2(x+v.x, y+v.y) ;
+   }
+
+constexpr Vector2& Vector2::operator+=(Vector2 const& v) {
+   x += v.x ;
+   y += v.y ;
+   return *this ;
+   }
+
+constexpr Vector2 Vector2::operator-(Vector2 const& v) const {
+   return Vector2(x-v.x, y-v.y) ;
+   }
+
+constexpr Vector2& Vector2::operator-=(Vector2 const& v) {
+   x -= v.x ;
+   y -= v.y ;
+   return *this ;
+   }
+
+constexpr Vector2 Vector2::operator-() const {
+   return Vector2(-x, -y) ;
+   }
+
+constexpr Vector2 Vector2::operator*(scalar s) const {
+   return Vector2((s*x), (s*y)) ;
+   }
+
+constexpr Vector2& Vector2::operator*=(scalar s) {
+   x *= s ;
+   y *= s ;
+   return *this ;
+   }
+
+constexpr Vector2 Vector2::operator/(scalar s) const {
+   if (s != 0.0) {
+      return Vector2((x/s), (y/s)) ;
+      }
+   else
+      return *this ;
+   }
+
+constexpr Vector2& Vector2::operator/=(scalar s) {
+   if (s != 0.0) {
+      x /= s ;
+      y /= s ;
+      }
+   return *this ;
+   }
+
+constexpr scalar Vector2::dot(Vector2 const& v) const {
+   return x*v.x + y*v.y  ;
+   }
+
+constexpr Vector2 Vector2::operator *(Vector2 const& v) const {
+    return Vector2(x*v.x, y*v.y) ;
+   }
+
+constexpr Vector2 Vector2::operator *=(Vector2 const& v) {
+   x*=v.x ;
+   y*=v.y ;
+   return *this ;
+   }
+
+constexpr Vector2 operator*(scalar s, Vector2 const& v) {
+   return Vector2((s*v.x), (s*v.y)) ;
+   }
+
+constexpr scalar Vector2::maxCoord() const {
+   return MAX(ABS(x),ABS(y));
+   }
+
+constexpr scalar Vector2::minCoord() const {
+   return MIN(ABS(x),ABS(y));
+   }
+
 #endif
+
@@ -16,11 +16,6 @@
 #ifndef VECTOR3_H
 #define VECTOR3_H
 
-#define ORIGIN Position(0,0,0)
-#define XAXIS Direction(1,0,0)
-#define YAXIS Direction(0,1,0)
-#define ZAXIS Direction(0,0,1)
-
 class Position ;
 class Direction ;
 class Transform;
@@ -32,66 +27,66 @@ class Vector3 {
       scalar z ;
 
 			/// Create a vector (0,0,0).
-      Vector3() ;
+      constexpr Vector3() ;
 			/// Create a vector (a,b,c)
-      Vector3(scalar a, scalar b, scalar c) ;
+      constexpr Vector3(scalar a, scalar b, scalar c) ;
 			/// Create a copy of another Vector3.
-      Vector3(Vector3 const& v) ;
+      constexpr Vector3(Vector3 const& v) = default ;
 			/// Create a 3d version of a 2d vector. (z=0).
-      Vector3(Vector2 const& v) ;
+      constexpr Vector3(Vector2 const& v) ;
 
 			/// Coerce THIS vector to a Position.
-      operator Position() const ;
+      constexpr operator Position() const ;
 			/// Coerce THIS vector to a Direction.
       operator Direction() const ;
 
 			/// Assign values to coordinates.
-      Vector3& set(scalar a, scalar b, scalar c) ;
+      constexpr Vector3& set(scalar a, scalar b, scalar c) ;
 			/// Get the length (magnitude) of THIS.
       scalar len() const ;
 			/// Normalize THIS (to unit vector), return former length.
       scalar norm() ;
 
 			/// Add THIS plus v: THIS + v.
-      Vector3  operator+ (Vector3 const& v) const ;   // Addition
+      constexpr Vector3  operator+ (Vector3 const& v) const ;   // Addition
 			/// Add v to THIS: THIS = THIS + v.
-      Vector3& operator+=(Vector3 const& v) ;
+      constexpr Vector3& operator+=(Vector3 const& v) ;
 			/// Subtract THIS minus v: THIS - v.
-      Vector3  operator- (Vector3 const& v) const ;   // Subtraction
+      constexpr Vector3  operator- (Vector3 const& v) const ;   // Subtraction
 			/// Subtract v from THIS: THIS = THIS - v.
-      Vector3& operator-=(Vector3 const& v) ;
+      constexpr Vector3& operator-=(Vector3 const& v) ;
 			/// Negate THIS: -THIS;
-      Vector3  operator- () const ;                   // Negation
+      constexpr Vector3  operator- () const ;                   // Negation
 			/// Scale THIS: THIS * s.
-      Vector3  operator* (scalar s) const ;     // Scale
+      constexpr Vector3  operator* (scalar s) const ;     // Scale
 			/// Scale THIS: THIS = THIS * s.
-      Vector3& operator*=(scalar s) ;
+      constexpr Vector3& operator*=(scalar s) ;
 			/// Scale THIS: s * THIS.
-      friend Vector3 operator* (scalar s, Vector3 const& v) ; // Scale
+      friend constexpr Vector3 operator* (scalar s, Vector3 const& v) ; // Scale
 			/// Scale THIS: THIS * 1/s.
-      Vector3  operator/ (scalar s) const ;
+      constexpr Vector3  operator/ (scalar s) const ;
 			/// Scale THIS: THIS = THIS * 1/s.
-      Vector3& operator/=(scalar s) ;
+      constexpr Vector3& operator/=(scalar s) ;
 			/// Return the cross product of THIS with v.
-      Vector3  cross     (Vector3 const& v) const ;
+      constexpr Vector3  cross     (Vector3 const& v) const ;
 			/// Calculate the dot product of THIS with v.
-      scalar   dot       (Vector3 const& v) const ;
+      constexpr scalar   dot       (Vector3 const& v) const ;
 			/// Calculate the dot product of THIS with a unit/Direction vector d.
-      scalar   dot       (Direction const& v) const ;
+      constexpr scalar   dot       (Direction const& v) const ;
 			/// Coordinate-by-coordinate multiplication: THIS.x * v.x, THIS.y * v.y, THIS.z * v.z.      
-      Vector3  operator* (Vector3 const& v) const ;
+      constexpr Vector3  operator* (Vector3 const& v) const ;
 			/// Coordinate-by-coordinate multiplication: THIS.x = THIS.x * v.x, etc.
-      Vector3& operator*=(Vector3 const& v) ;         // coord-by-coord
+      constexpr Vector3& operator*=(Vector3 const& v) ;         // coord-by-coord
 			/// Smallest magnitude coordinate (absolute value) of THIS.
-      scalar   minCoord  () const ;                   // min coord
+      constexpr scalar   minCoord  () const ;                   // min coord
 			/// Largest magnitude coordinate (absolute value) of THIS.
-      scalar   maxCoord  () const ;                   // max coord
+      constexpr scalar   maxCoord  () const ;                   // max coord
 		  /// The axis of largest magnitude (in case of tie: x, then y, then z)
-	  Direction majorAxis () const;
+	  constexpr Direction majorAxis () const;
 		  /// The axis of smallest magnitude (in case of tie: x, then y, then z)
-	  Direction minorAxis () const;
+	  constexpr Direction minorAxis () const;
 			/// Sum of all 3 coordinates (useful for color representation arithmetic).
-      scalar	sumCoord () const {return (x + y + z);} ;		// sum of coords
+      constexpr scalar	sumCoord () const {return (x + y + z);} ;		// sum of coords
    } ;
 
 class Position {
@@ -101,41 +96,41 @@ class Position {
       scalar z ;
 
 			/// Create a position vector located at the ORIGIN: (0,0,0).
-      Position() ;
+      constexpr Position() ;
 			/// Create a position at (a,b,c).
-      Position(scalar a, scalar b, scalar c) ;
+      constexpr Position(scalar a, scalar b, scalar c) ;
 
 			/// Assign values to coordinates.
-      Position& set(scalar a, scalar b, scalar c);
+      constexpr Position& set(scalar a, scalar b, scalar c);
 
 			/// Convert Position to Vector3
-      friend Vector3 Vector(Position const& p) ;
+      friend constexpr Vector3 Vector(Position const& p) ;
 			/// Add a displacement v to THIS position.
-      Position  operator +  (Vector3 const& v) const ;
+      constexpr Position  operator +  (Vector3 const& v) const ;
 			/// Move THIS position by a displacement v.
-      Position& operator += (Vector3 const& v) ;
+      constexpr Position& operator += (Vector3 const& v) ;
 			/// Subtract a displacement v from THIS position.
-      Position  operator -  (Vector3 const& v) const ;
+      constexpr Position  operator -  (Vector3 const& v) const ;
 			/// Find the displacement between THIS position and position p.
-      Vector3   operator -  (Position const& p) const ;
+      constexpr Vector3   operator -  (Position const& p) const ;
 			/// Move THIS position by subtracting a displacement v.
-      Position& operator -= (Vector3 const& v) ;
+      constexpr Position& operator -= (Vector3 const& v) ;
 			/// Calculate the dot product of THIS position and unit vector d.
-      scalar    dot         (Direction const& d) const ;
+      constexpr scalar    dot         (Direction const& d) const ;
 			/// Calculate the scaled position: THIS * s.
-      Position  operator *  (scalar s) const ;
+      constexpr Position  operator *  (scalar s) const ;
 			/// Calculate the scaled position: THIS * 1/s.
-      Position  operator /  (scalar s) const ;
+      constexpr Position  operator /  (scalar s) const ;
 			/// Calculate the scaled position: s * THIS.
-      friend Position operator* (scalar s, Position const& p) ;  // scale
+      friend constexpr Position operator* (scalar s, Position const& p) ;  // scale
 			/// Smallest magnitude coordinate (absolute value) of THIS.
-      scalar   minCoord  () const ;                   // min coord
+      constexpr scalar   minCoord  () const ;                   // min coord
 			/// Largest magnitude coordinate (absolute value) of THIS.
-      scalar   maxCoord  () const ;                   // max coord
+      constexpr scalar   maxCoord  () const ;                   // max coord
 		  /// The axis of largest magnitude (in case of tie: x, then y, then z)
-	  Direction majorAxis () const;
+	  constexpr Direction majorAxis () const;
 		  /// The axis of smallest magnitude (in case of tie: x, then y, then z)
-	  Direction minorAxis () const;
+	  constexpr Direction minorAxis () const;
 
 } ;
 
@@ -147,15 +142,17 @@ class Direction {
       scalar z ;
 
 			/// Create a NULL unit/direction vector.
-      Direction() ;
+      constexpr Direction() ;
 			/// Create a unit/direction vector: (a,b,c) / |(a,b,c)|.
       Direction(scalar a, scalar b, scalar c) ;
+			/// Create a unit/direction vector from coordinates already of unit length (no normalization).
+      static constexpr Direction Unit(scalar a, scalar b, scalar c) ;
 
 			/// Assign values to coordinates.
       Direction& set(scalar a, scalar b, scalar c) ;
 
 			/// Convert THIS Direction to Vector3
-      friend Vector3 Vector(Direction const& d) ;
+      friend constexpr Vector3 Vector(Direction const& d) ;
 			/// Add THIS plus a unit/direction vector.
       Direction  operator +  (Direction const& d) const ;
 			/// Add a unit/direction vector to THIS unit/direction vector.
@@ -165,27 +162,27 @@ class Direction {
 			/// Subtract a unit/direction from THIS unit/direction vector.
       Direction& operator -= (Direction const& d) ;
 			/// Find the reverse direction of THIS.
-      Direction  operator -  () const ;
+      constexpr Direction  operator -  () const ;
 			/// Calculate the displacement of a distance s in THIS direction or scale THIS unit vector by s.
-      Vector3    operator *  (scalar s) const ;
+      constexpr Vector3    operator *  (scalar s) const ;
 			/// Calculate THIS unit/direction vector scaled by 1/s.
-      Vector3    operator /  (scalar s) const ;
+      constexpr Vector3    operator /  (scalar s) const ;
 			/// Calculate the displacement of a distance s in THIS direction or scale THIS unit vector by s.
-      friend Vector3 operator* (scalar s, Direction const& d) ;
+      friend constexpr Vector3 operator* (scalar s, Direction const& d) ;
 			/// Determine the cross product between THIS unit/direction vector and another.
-      Vector3    cross       (Direction const& d) const ;
+      constexpr Vector3    cross       (Direction const& d) const ;
 			/// Find the projection of THIS unit/direction vector on a vector v.
-      scalar     dot         (Vector3 const& v) const ;
+      constexpr scalar     dot         (Vector3 const& v) const ;
 			/// Find the cosine of the angle between THIS and another unit/direction vector.
-      scalar     dot         (Direction const& v) const ;
+      constexpr scalar     dot         (Direction const& v) const ;
 			/// Get the smallest coordinate magnitude of THIS unit/direction vector.
-      scalar     minCoord    () const ;
+      constexpr scalar     minCoord    () const ;
 			/// Get the largest coordinate magnitude of THIS unit/direction vector.
-      scalar     maxCoord    () const ;
+      constexpr scalar     maxCoord    () const ;
 		  /// The axis of largest magnitude (in case of tie: x, then y, then z)
-	  Direction majorAxis () const;
+	  constexpr Direction majorAxis () const;
 		  /// The axis of smallest magnitude (in case of tie: x, then y, then z)
-	  Direction minorAxis () const;
+	  constexpr Direction minorAxis () const;
 			/// THIS unit/direction vector length can be 1 or 0.
       scalar     len() const ;
 			/// Coerce THIS unit/direction vector to be unit length. Return former length.
@@ -195,8 +192,362 @@ class Direction {
   } ;
 
 			/// Calculate the determinant of a 3x3 matrix.
-scalar det(Vector3 const& v1,		//	| v1.x v2.x v3.x |
+constexpr scalar det(Vector3 const& v1,		//	| v1.x v2.x v3.x |
 					 Vector3 const& v2,		//	| v1.y v2.y v3.y |
 					 Vector3 const& v3) ;	//	| v1.z v2.z v3.z |
 
+/* -----------------------------------------------------------
+ *  Inline definitions. Everything here is constexpr so that
+ *  constant vectors (and the axis constants below) are folded
+ *  at compile time.
+ */
+
+constexpr Position::Position()
+   : x(0), y(0), z(0) {
+   }
+
+constexpr Position::Position(scalar a, scalar b, scalar c)
+   : x(a), y(b), z(c) {
+   }
+
+constexpr Direction::Direction()
+   : x(0), y(0), z(0) {
+   }
+
+constexpr Direction Direction::Unit(scalar a, scalar b, scalar c) {
+   Direction d ;
+   d.x = a ;
+   d.y = b ;
+   d.z = c ;
+   return d ;
+   }
+
+constexpr Position  ORIGIN = Position(0,0,0) ;
+constexpr Direction XAXIS  = Direction::Unit(1,0,0) ;
+constexpr Direction YAXIS  = Direction::Unit(0,1,0) ;
+constexpr Direction ZAXIS  = Direction::Unit(0,0,1) ;
+
+constexpr Vector3::Vector3()
+   : x(0), y(0), z(0) {
+   }
+
+constexpr Vector3::Vector3(scalar a, scalar b, scalar c)
+   : x(a), y(b), z(c) {
+   }
+
+constexpr Vector3::Vector3(Vector2 const& v)
+   : x(v.x), y(v.y), z(0) {
+   }
+
+constexpr Vector3& Vector3::set(scalar a, scalar b, scalar c) {
+   x = a ;
+   y = b ;
+   z = c ;
+   return *this ;
+   }
+
+constexpr Vector3::operator Position() const {
+   return Position(x,y,z) ;
+   }
+
+constexpr Vector3 Vector3::operator+(Vector3 const& v) const {
+   return Vector3(x+v.x, y+v.y, z+v.z) ;
+   }
+
+constexpr Vector3& Vector3::operator+=(Vector3 const& v) {
+   x += v.x ;
+   y += v.y ;
+   z += v.z ;
+   return *this ;
+   }
+
+constexpr Vector3 Vector3::operator-(Vector3 const& v) const {
+   return Vector3(x-v.x, y-v.y, z-v.z) ;
+   }
+
+constexpr Vector3& Vector3::operator-=(Vector3 const& v) {
+   x -= v.x ;
+   y -= v.y ;
+   z -= v.z ;
+   return *this ;
+   }
+
+constexpr Vector3 Vector3::operator-() const {
+   return Vector3(-x, -y, -z) ;
+   }
+
+constexpr Vector3 Vector3::operator*(scalar s) const {
+   return Vector3((s*x), (s*y), (s*z)) ;
+   }
+
+constexpr Vector3& Vector3::operator*=(scalar s) {
+   x *= s ;
+   y *= s ;
+   z *= s ;
+   return *this ;
+   }
+
+constexpr Vector3 Vector3::operator/(scalar s) const {
+   if (s != 0.0) {
+      return Vector3((x/s), (y/s), (z/s)) ;
+      }
+   else
+      return *this ;
+   }
+
+constexpr Vector3& Vector3::operator/=(scalar s) {
+   if (s != 0.0) {
+      x /= s ;
+      y /= s ;
+      z /= s ;
+      }
+   return *this ;
+   }
+
+constexpr scalar Vector3::dot(Vector3 const& v) const {
+   return x*v.x + y*v.y + z*v.z ;
+   }
+
+constexpr Vector3 Vector3::cross(Vector3 const& v) const
+   { return Vector3(y*v.z - z*v.y,
+                    z*v.x - x*v.z,
+                    x*v.y - y*v.x) ; }
+
+constexpr scalar Vector3::dot(Direction const& d) const {
+   return x*d.x + y*d.y + z*d.z ;
+   }
+
+constexpr Vector3 Vector3::operator *(Vector3 const& v) const {
+    return Vector3(x*v.x, y*v.y, z*v.z) ;
+   }
+
+constexpr Vector3& Vector3::operator *=(Vector3 const& v) {
+   x*=v.x ;
+   y*=v.y ;
+   z*=v.z ;
+   return *this ;
+   }
+
+constexpr Vector3 operator*(scalar s, Vector3 const& v)
+   {return Vector3((s*v.x), (s*v.y), (s*v.z)) ; }
+
+constexpr scalar Vector3::maxCoord() const {
+	return (MAX(ABS(x),MAX(ABS(y),ABS(z))));
+   }
+
+constexpr scalar Vector3::minCoord() const {
+	return (MIN(ABS(x),MIN(ABS(y),ABS(z))));
+   }
+
+constexpr Direction Vector3::majorAxis() const {
+	Direction axis;
+	if (ABS(x) >= ABS(y))
+		if (ABS(x) >= ABS(z))
+			axis = XAXIS;
+		else
+			axis = ZAXIS;
+	else
+		if (ABS(y) >= ABS(z))
+			axis = YAXIS;
+		else
+			axis = ZAXIS;
+	return axis;
+}
+
+constexpr Direction Vector3::minorAxis() const {
+	Direction axis;
+	if (ABS(x) <= ABS(y))
+		if (ABS(x) <= ABS(z))
+			axis = XAXIS;
+		else
+			axis = ZAXIS;
+	else
+		if (ABS(y) <= ABS(z))
+			axis = YAXIS;
+		else
+			axis = ZAXIS;
+	return axis;
+}
+
+constexpr Position& Position::set(scalar a, scalar b, scalar c) {
+   x = a ;
+   y = b ;
+   z = c ;
+   return *this ;
+   }
+
+constexpr Vector3 Vector(Position const& p) {
+   return Vector3(p.x,p.y,p.z) ;
+   }
+
+constexpr Position Position::operator + (Vector3 const& v) const {
+   return Position(x + v.x, y + v.y, z + v.z) ;
+   }
+
+constexpr Position& Position::operator += (Vector3 const& v) {
+   x += v.x ;
+   y += v.y ;
+   z += v.z ;
+   return *this ;
+   }
+
+constexpr Position Position::operator - (Vector3 const& v) const {
+   return Position(x - v.x, y - v.y, z - v.z) ;
+   }
+
+constexpr Vector3 Position::operator - (Position const& p) const {
+   return Vector3(x - p.x, y - p.y, z - p.z) ;
+   }
+
+constexpr Position& Position::operator -= (Vector3 const& v) {
+   x -= v.x ;
+   y -= v.y ;
+   z -= v.z ;
+   return *this ;
+   }
+
+constexpr scalar Position::dot(Direction const& d) const {
+   return x*d.x + y*d.y + z*d.z ;
+   }
+
+constexpr Position  Position::operator *  (scalar s) const {
+   return Position(s * x, s * y, s * z) ;
+   }
+
+constexpr Position Position::operator/(scalar s) const {
+   if (s != 0.0) {
+      return Position((x/s), (y/s), (z/s)) ;
+      }
+   else
+      return *this ;
+   }
+
+constexpr Position operator* (scalar s, Position const& p) {
+   return Position(s * p.x, s * p.y, s * p.z) ;
+   }
+
+constexpr scalar Position::maxCoord() const {
+	return (MAX(ABS(x),MAX(ABS(y),ABS(z))));
+   }
+
+constexpr scalar Position::minCoord() const {
+	return (MIN(ABS(x),MIN(ABS(y),ABS(z))));
+   }
+
+constexpr Direction Position::majorAxis() const {
+	Direction axis;
+	if (ABS(x) >= ABS(y))
+		if (ABS(x) >= ABS(z))
+			axis = XAXIS;
+		else
+			axis = ZAXIS;
+	else
+		if (ABS(y) >= ABS(z))
+			axis = YAXIS;
+		else
+			axis = ZAXIS;
+	return axis;
+}
+
+constexpr Direction Position::minorAxis() const {
+	Direction axis;
+	if (ABS(x) <= ABS(y))
+		if (ABS(x) <= ABS(z))
+			axis = XAXIS;
+		else
+			axis = ZAXIS;
+	else
+		if (ABS(y) <= ABS(z))
+			axis = YAXIS;
+		else
+			axis = ZAXIS;
+	return axis;
+}
+
+constexpr Vector3 Vector(const Direction& d) {
+   return Vector3(d.x,d.y,d.z) ;
+   }
+
+constexpr Direction Direction::operator- () const {
+   return Unit(-x, -y, -z) ;
+   }
+
+constexpr scalar Direction::dot(Direction const& d) const {
+   return x*d.x + y*d.y + z*d.z ;
+   }
+
+constexpr Vector3 Direction::cross(Direction const& d) const
+   { return Vector3(y*d.z - z*d.y,
+                    z*d.x - x*d.z,
+                    x*d.y - y*d.x) ; }
+
+constexpr scalar Direction::dot(Vector3 const& v) const {
+   return x*v.x + y*v.y + z*v.z ;
+   }
+
+constexpr scalar Direction::minCoord() const {
+	return MIN(ABS(x),MIN(ABS(y),ABS(z)));
+   }
+
+constexpr scalar Direction::maxCoord() const {
+	return MAX(ABS(x),MAX(ABS(y),ABS(z)));
+   }
+
+constexpr Direction Direction::majorAxis() const {
+	Direction axis;
+	if (ABS(x) >= ABS(y))
+		if (ABS(x) >= ABS(z))
+			axis = XAXIS;
+		else
+			axis = ZAXIS;
+	else
+		if (ABS(y) >= ABS(z))
+			axis = YAXIS;
+		else
+			axis = ZAXIS;
+	return axis;
+}
+
+constexpr Direction Direction::minorAxis() const {
+	Direction axis;
+	if (ABS(x) <= ABS(y))
+		if (ABS(x) <= ABS(z))
+			axis = XAXIS;
+		else
+			axis = ZAXIS;
+	else
+		if (ABS(y) <= ABS(z))
+			axis = YAXIS;
+		else
+			axis = ZAXIS;
+	return axis;
+}
+
+constexpr Vector3 operator* (scalar s, Direction const& d) {
+   return Vector3(s*d.x, s*d.y, s*d.z) ;
+   }
+
+constexpr Vector3 Direction::operator * (scalar s) const {
+   return Vector3(s*x, s*y, s*z) ;
+   }
+
+constexpr Vector3 Direction::operator / (scalar s) const {
+   if (s != 0.0) {
+	   return Vector3(x/s, y/s, z/s) ;
+      }
+   else
+      return Vector3(x,y,z) ;
+   }
+
+constexpr scalar det(Vector3 const& v1,	//	| v1.x v2.x v3.x |
+		   Vector3 const& v2,	//	| v1.y v2.y v3.y |
+		   Vector3 const& v3) { //	| v1.z v2.z v3.z |
+
+	scalar d = v1.x * (v2.y * v3.z - v3.y * v2.z)
+			 - v2.x * (v1.y * v3.z - v3.y * v1.z)
+			 + v3.x * (v1.y * v2.z - v2.y * v1.z) ;
+
+	return d ;
+	}
+
 #endif
@@ -24,101 +24,107 @@ class Vector4 {
       scalar z ;
       scalar w ;
 
-      Vector4() ;
-      Vector4(scalar a, scalar b, scalar c, scalar d) ;
+      constexpr Vector4() ;
+      constexpr Vector4(scalar a, scalar b, scalar c, scalar d) ;
 
 			/// Convert THIS to Vector3 (drop homogeneous coordinate).
-      operator Vector3() const ;
+      constexpr operator Vector3() const ;
 			/// Convert THIS to Position (divide through by homogeneous coordinate).
-      operator Position() const ;
+      constexpr operator Position() const ;
 			/// Convert THIS to Direction (drop homogeneous coordinate, normalize).
       operator Direction() const ;
 
 			/// Assign values to coordinates.
-      Vector4& set(scalar a, scalar b, scalar c, scalar d) ;
+      constexpr Vector4& set(scalar a, scalar b, scalar c, scalar d) ;
 			/// Calculate dot product of THIS vector and another.
-      scalar dot(Vector4 const& v) const ;
+      constexpr scalar dot(Vector4 const& v) const ;
 			/// Standardize THIS (divide through by homogeneous coordinate).
-      Vector4 stdz() ;
+      constexpr Vector4 stdz() ;
 			/// Convert a 3d vector to homogeneous form (w = 0).
-      friend Vector4 VectorH(Vector3 const& v3) ;
+      friend constexpr Vector4 VectorH(Vector3 const& v3) ;
 			/// Convert a Position to Homogeneous form (w = 1).
-      friend Vector4 VectorH(Position const& p) ;
+      friend constexpr Vector4 VectorH(Position const& p) ;
 			/// Convert a Direction to homogeneous form (w = 0).
-      friend Vector4 VectorH(Direction const& d) ;
+      friend constexpr Vector4 VectorH(Direction const& d) ;
 	} ;
 
 class Transform {
    public:
       scalar xform[4][4] ;
 
-      Transform() ;
-      Transform(Transform const& mx) ;
-      Transform(Vector4 const& r0, Vector4 const& r1,
+      constexpr Transform() ;
+      constexpr Transform(Transform const& mx) = default ;
+      constexpr Transform(Vector4 const& r0, Vector4 const& r1,
                 Vector4 const& r2, Vector4 const& r3) ;
-      Transform(Vector3 const& r0, Vector3 const& r1,
+      constexpr Transform(Vector3 const& r0, Vector3 const& r1,
                 Vector3 const& r2, Vector3 const& r3) ;
 
 			/// Set THIS transform matrix to identity.
-      void Identity() ;
+      constexpr void Identity() ;
 			/// Extract column c from THIS transform. (0 <= c <= 3)
-      Vector4 col(int c) const ;
+      constexpr Vector4 col(int c) const ;
 			/// Extract row r from THIS transform. (0 <= r <= 3)
-      Vector4 row(int r) const ;
+      constexpr Vector4 row(int r) const ;
 			/// Set row r of THIS transform from a homogeneous vector v. (0 <= r <= 3)
-	  Transform setRow(int r, Vector4 const& v) ;
+      constexpr Transform setRow(int r, Vector4 const& v) ;
 			/// Set row r of THIS transform from a 3d vector v. (0 <= r <= 3)
-	  Transform setRow(int r, Vector3 const& v) ;
+      constexpr Transform setRow(int r, Vector3 const& v) ;
 			/// Set column c of THIS transform from a homogeneous vector v. (0 <= c <= 3)
-	  Transform setCol(int c, Vector4 const& v) ;
+      constexpr Transform setCol(int c, Vector4 const& v) ;
 			/// Set column c of THIS transform from a 3d vector v. (0 <= c <= 3)
-	  Transform setCol(int c, Vector3 const& v) ;
+      constexpr Transform setCol(int c, Vector3 const& v) ;
 			/// Return the transpose of THIS transform matrix.
-	  Transform transpose() const ;
+      constexpr Transform transpose() const ;
 			/// Return the inverse of THIS transform matrix. (Assumed to be well-conditioned.)
       Transform inverse() const ;
       
 			/// Multiply THIS transform matrix times another. (THIS * mx)
-      Transform operator*(Transform const& mx) const ;
+      constexpr Transform operator*(Transform const& mx) const ;
 			/// Multiply THIS transform matrix times another. Replace THIS. (THIS <- THIS * mx)
-      Transform& operator*=(Transform const& mx) ;
+      constexpr Transform& operator*=(Transform const& mx) ;
 			/// Add THIS transform matrix with another. (THIS + mx)
-      Transform operator+(Transform const& mx) const ;
+      constexpr Transform operator+(Transform const& mx) const ;
 			/// Add THIS transform matrix with another. Replace THIS. (THIS <- THIS + mx)
-      Transform& operator+=(Transform const& mx) ;
+      constexpr Transform& operator+=(Transform const& mx) ;
 
 			/// Multiply THIS transform matrix by a scalar value. (THIS * s)
-      Transform operator*(scalar const& s) const ;
+      constexpr Transform operator*(scalar const& s) const ;
 			/// Multiply THIS transform matrix by a scalar value. Replace THIS. (THIS <- THIS * s)
-      Transform& operator*=(scalar const& s) ;
+      constexpr Transform& operator*=(scalar const& s) ;
 			/// Multiply THIS transform matrix by a scalar value. (s * THIS)
-      friend Transform operator*(scalar const& s, Transform const& mx) ;
+      friend constexpr Transform operator*(scalar const& s, Transform const& mx) ;
 
 			/// Multiply THIS transform matrix times a homogeneous vector. (THIS * v)
-      Vector4 operator*(Vector4 const& v) const ;
+      constexpr Vector4 operator*(Vector4 const& v) const ;
 			/// Multiply THIS transform matrix times a position vector. (THIS * p)
-      Position operator*(Position const& p) const ;
+      constexpr Position operator*(Position const& p) const ;
 			/// Multiply THIS transform matrix times a direction vector. (THIS * d)
       Direction operator*(Direction const& d) const ;
 			/// Multiply a homogeneous vector times THIS transform matrix. (v * THIS)
-      friend Vector4 operator*(Vector4 const& v, Transform const& mx) ;
+      friend constexpr Vector4 operator*(Vector4 const& v, Transform const& mx) ;
 			/// Multiply a position vector times THIS transform matrix. (p * THIS)
-      friend Position operator*(Position const& p, Transform const& mx) ;
+      friend constexpr Position operator*(Position const& p, Transform const& mx) ;
 			/// Multiply a direction vector times THIS transform matrix. (d * THIS)
       friend Direction operator*(Direction const& d, Transform const& mx) ;
 
 	   // Graphics transform constructions.
 	   // These functions concatenate operations.
 			/// Concatenate a translation to THIS transform matrix.
-      Transform& translate(Vector3 const& v) ;
+      constexpr Transform& translate(Vector3 const& v) ;
 			/// Concatenate a scaling operation to THIS.
-      Transform& scale(Vector4 const& s) ;
+      constexpr Transform& scale(Vector4 const& s) ;
 			/// Concatenate a rotation about the X axis.
       Transform& rotateX(scalar radians) ;  // *this is rotated
 			/// Concatenate a rotation about the Y axis.
       Transform& rotateY(scalar radians) ;
 			/// Concatenate a rotation about the Z axis.
       Transform& rotateZ(scalar radians) ;
+			/// Concatenate a rotation of turns * 90 degrees about the X axis. (No trigonometry.)
+      constexpr Transform& rotateX90(int turns) ;
+			/// Concatenate a rotation of turns * 90 degrees about the Y axis. (No trigonometry.)
+      constexpr Transform& rotateY90(int turns) ;
+			/// Concatenate a rotation of turns * 90 degrees about the Z axis. (No trigonometry.)
+      constexpr Transform& rotateZ90(int turns) ;
 
 	   // More Graphics transform constructions.
 	   // These functions DO NOT concatenate operations.
@@ -129,12 +135,424 @@ class Transform {
 			/// Set THIS transform matrix to rotate one direction vector into another about x-, y- and z- axes.
       Transform& setRotateGimbal(Direction const& d1, Direction const& d2) ;
 			
-      Transform& set(Direction const& rx,
+      constexpr Transform& set(Direction const& rx,
                      Direction const& ry,
                      Direction const& rz,
                      Vector4 const& s,
                      Position const& t) ;
 
+   private:
+      friend class Transform2 ;
+			// Cosine and sine of turns * 90 degrees, exactly.
+      static constexpr void quarterTurn(int turns, scalar& c, scalar& s) ;
    } ;
 
+/* -----------------------------------------------------------
+ *  Inline definitions. Everything that needs no trigonometry
+ *  or square root is constexpr, so fixed transforms (axis
+ *  swaps, unit conversions, canonical camera bases) can be
+ *  built at compile time.
+ */
+
+constexpr Vector4::Vector4()
+   : x(0), y(0), z(0), w(0) {
+   }
+
+constexpr Vector4::Vector4(scalar a, scalar b, scalar c, scalar d)
+   : x(a), y(b), z(c), w(d) {
+   }
+
+constexpr Vector4::operator Vector3() const {
+   return Vector3(x,y,z) ;
+   }
+
+constexpr Vector4::operator Position() const {
+   if (w != 0)
+      return Position(x/w,y/w,z/w) ;
+   else
+      return Position(x,y,z) ;
+   }
+
+constexpr Vector4& Vector4::set(scalar a, scalar b,
+                                scalar c, scalar d) {
+   x = a ;
+   y = b ;
+   z = c ;
+   w = d ;
+   return *this ;
+   }
+
+constexpr scalar Vector4::dot(Vector4 const& v) const {
+   return x*v.x + y*v.y + z*v.z + w*v.w ;
+   }
+
+constexpr Vector4 Vector4::stdz() {
+   if (w != 0) {
+      x /= w ;
+      y /= w ;
+      z /= w ;
+      }
+   w = 1 ;
+   return *this ;
+   }
+
+constexpr Vector4 VectorH(Vector3 const& v) {
+   return Vector4(v.x,v.y,v.z,0) ;
+   }
+constexpr Vector4 VectorH(Position const& p) {
+   return Vector4(p.x,p.y,p.z,1) ;
+   }
+constexpr Vector4 VectorH(Direction const& d) {
+   return Vector4(d.x, d.y,d.z,0) ;
+   }
+
+/* -----------------------------------------------------------
+ *  Create an identity transform matrix.
+ */
+constexpr Transform::Transform()
+   : xform() {
+   Identity() ;
+   }
+
+/* -----------------------------------------------------------
+ *  Create a transform matrix from 4 row vectors.
+ */
+constexpr Transform::Transform(Vector4 const& r0, Vector4 const& r1,
+                               Vector4 const& r2, Vector4 const& r3)
+   : xform() {
+   xform[0][0] = r0.x ;
+   xform[0][1] = r0.y ;
+   xform[0][2] = r0.z ;
+   xform[0][3] = r0.w ;
+
+   xform[1][0] = r1.x ;
+   xform[1][1] = r1.y ;
+   xform[1][2] = r1.z ;
+   xform[1][3] = r1.w ;
+
+   xform[2][0] = r2.x ;
+   xform[2][1] = r2.y ;
+   xform[2][2] = r2.z ;
+   xform[2][3] = r2.w ;
+
+   xform[3][0] = r3.x ;
+   xform[3][1] = r3.y ;
+   xform[3][2] = r3.z ;
+   xform[3][3] = r3.w ;
+
+   }
+
+/* -----------------------------------------------------------
+ *  Create a transform matrix from 4 row vectors.
+ */
+constexpr Transform::Transform(Vector3 const& r0, Vector3 const& r1,
+                               Vector3 const& r2, Vector3 const& r3)
+   : xform() {
+   xform[0][0] = r0.x ;
+   xform[0][1] = r0.y ;
+   xform[0][2] = r0.z ;
+   xform[0][3] = 0 ;
+
+   xform[1][0] = r1.x ;
+   xform[1][1] = r1.y ;
+   xform[1][2] = r1.z ;
+   xform[1][3] = 0 ;
+
+   xform[2][0] = r2.x ;
+   xform[2][1] = r2.y ;
+   xform[2][2] = r2.z ;
+   xform[2][3] = 0 ;
+
+   xform[3][0] = r3.x ;
+   xform[3][1] = r3.y ;
+   xform[3][2] = r3.z ;
+   xform[3][3] = 1 ;
+
+   }
+
+/* -----------------------------------------------------------
+ *  Set a transform to an identity matrix.
+ */
+constexpr void Transform::Identity() {
+     for (int i = 0 ; i < 4 ; i++ ) {
+         for (int j = 0 ; j < 4 ; j++ )
+            xform[i][j] = 0 ;
+         xform[i][i] = 1 ;
+         }
+     }
+
+/* -----------------------------------------------------------
+ * Extract a column vector.
+ */
+constexpr Vector4 Transform::col(int c) const {
+   Vector4 v(xform[0][c], xform[1][c], xform[2][c], xform[3][c]) ;
+   return v ;
+   }
+
+/* -----------------------------------------------------------
+ * Extract a row vector.
+ */
+constexpr Vector4 Transform::row(int r) const {
+   return Vector4(xform[r][0],xform[r][1],xform[r][2],xform[r][3]) ;
+   }
+
+/* -----------------------------------------------------------
+ * Set a row vector.
+ */
+constexpr Transform Transform::setRow(int r, Vector4 const& v) {
+	xform[r][0] = v.x ;
+	xform[r][1] = v.y ;
+	xform[r][2] = v.z ;
+	xform[r][3] = v.w ;
+	return *this ;
+}
+constexpr Transform Transform::setRow(int r, Vector3 const& v) {
+	xform[r][0] = v.x ;
+	xform[r][1] = v.y ;
+	xform[r][2] = v.z ;
+	xform[r][3] = 0. ;
+	return *this ;
+}
+/* -----------------------------------------------------------
+ * Set a column vector.
+ */
+constexpr Transform Transform::setCol(int c, Vector4 const& v) {
+	xform[0][c] = v.x ;
+	xform[1][c] = v.y ;
+	xform[2][c] = v.z ;
+	xform[3][c] = v.w ;
+	return *this ;
+}
+constexpr Transform Transform::setCol(int c, Vector3 const& v) {
+	xform[0][c] = v.x ;
+	xform[1][c] = v.y ;
+	xform[2][c] = v.z ;
+	xform[3][c] = 0. ;
+	return *this ;
+}
+
+/** -----------------------------------------------------------
+ * Multiply a transform matrix times a (column) vector.
+ **/
+constexpr Vector4 Transform::operator*(Vector4 const& v) const {
+   Vector4 vrow[4] ;
+   for (int i=0 ; i < 4 ; i++)
+      vrow[i].set(xform[i][0],
+                  xform[i][1],
+                  xform[i][2],
+                  xform[i][3]) ;
+   Vector4 vres(vrow[0].dot(v),vrow[1].dot(v),vrow[2].dot(v),vrow[3].dot(v)) ;
+   return vres ;
+   }
+
+/** -----------------------------------------------------------
+ * Transform a vector. (Multiply a row vector times
+ * a transform matrix.)
+ **/
+constexpr Vector4 operator*(Vector4 const& v, Transform const& mx) {
+   Vector4 vr(v.dot(mx.col(0)),
+               v.dot(mx.col(1)),
+               v.dot(mx.col(2)),
+               v.dot(mx.col(3))) ;
+   return vr ;
+   }
+
+/** -----------------------------------------------------------
+ * Post transform a position vector. (Multiply a transform
+ * matrix times a column vector.) We create a temporary
+ * Vector4 from the position vector where the homogeneous
+ * coordinate is 1.
+ **/
+constexpr Position Transform::operator*(Position const& p) const {
+   return (*this * (VectorH(p))) ;
+   }
+
+/** -----------------------------------------------------------
+ * Transform a position vector. (Multiply a row vector
+ * times a transform matrix.) We create a temporary
+ * Vector4 from the position vector where the homogenous
+ * coordinate is 1.
+ **/
+constexpr Position operator*(Position const& p, Transform const& mx) {
+   return (VectorH(p)*mx) ;
+   }
+
+/* -----------------------------------------------------------
+   Simple transforms - Cumulative
+
+   Source: Graphics Gems, Glassner
+
+ */
+
+// From Graphics Gems I, p478
+constexpr Transform& Transform::translate(Vector3 const& v) {
+   for (int i = 0 ; i < 4 ; i++) {
+       xform[i][0] += xform[i][3] * v.x ;	// 
+       xform[i][1] += xform[i][3] * v.y ;
+       xform[i][2] += xform[i][3] * v.z ;
+       }
+   return *this ;
+   }
+
+// From Graphics Gems I, p478
+constexpr Transform& Transform::scale(Vector4 const& s) {
+   Vector3 s1(s.x*s.w, s.y*s.w, s.z*s.w) ;
+   for (int i = 0 ; i < 4 ; i++) {
+      xform[i][0] *= s1.x ;
+      xform[i][1] *= s1.y ;
+      xform[i][2] *= s1.z ;
+      }
+   return *this ;
+   }
+
+/* -----------------------------------------------------------
+ *  Rotations by multiples of 90 degrees. These are the
+ *  rotateX/Y/Z() concatenations with the sine and cosine
+ *  looked up rather than computed, so they are exact and
+ *  can be evaluated at compile time (axis swaps, camera bases).
+ */
+constexpr void Transform::quarterTurn(int turns, scalar& c, scalar& s) {
+   turns %= 4 ;
+   if (turns < 0)
+      turns += 4 ;
+   c = (turns == 0) ? 1 : (turns == 2) ? -1 : 0 ;
+   s = (turns == 1) ? 1 : (turns == 3) ? -1 : 0 ;
+   }
+
+constexpr Transform& Transform::rotateX90(int turns) {
+   scalar c = 0, s = 0, t = 0 ;
+   quarterTurn(turns, c, s) ;
+   for (int i = 0 ; i < 4 ; i++) {
+	   t = xform[i][1] ;
+	   xform[i][1] = t*c - xform[i][2] * s ;
+	   xform[i][2] = t*s + xform[i][2] * c ;
+	   }
+   return *this ;
+   }
+
+constexpr Transform& Transform::rotateY90(int turns) {
+   scalar c = 0, s = 0, t = 0 ;
+   quarterTurn(turns, c, s) ;
+   for (int i = 0 ; i < 4 ; i++) {
+	   t = xform[i][0] ;
+	   xform[i][0] = t*c + xform[i][2] * s ;
+	   xform[i][2] = xform[i][2] * c - t*s ;
+	   }
+   return *this ;
+   }
+
+constexpr Transform& Transform::rotateZ90(int turns) {
+   scalar c = 0, s = 0, t = 0 ;
+   quarterTurn(turns, c, s) ;
+   for (int i = 0 ; i < 4 ; i++) {
+	   t = xform[i][0] ;
+	   xform[i][0] = t*c - xform[i][1] * s ;
+	   xform[i][1] = t*s + xform[i][1] * c ;
+	   }
+   return *this ;
+   }
+
+/** -----------------------------------------------------------
+ *   Set a transform matrix given rotation vectors, scale vector,
+ *   and a translation vector.
+ *   Use this routine to transform a figure from canonical form
+ *   to an arbitrary position and orientation. The canonical figure
+ *   is scaled and rotated then translated to the desired position.
+ *   The scale multiplies the "size" of the figure (usually unity) to
+ *   the desired size (independently in x, y, z, plus a "global" scale).
+ *   Rotation turns the axes of the figure away from the world axes.
+ *   Translation moves the figure away from the origin.
+ *   rx, ry, and rz should be mutually perpendicular else ????
+ *   (ref: Foley & Van Dam)
+ **/
+constexpr Transform& Transform::set(Direction const& rx,
+                                    Direction const& ry,
+                                    Direction const& rz,
+                                    Vector4 const& s,
+                                    Position const& t) {
+   scalar a = s.x, b = s.y, c = s.z, d = 0 ;
+
+   // The following is equivalent to (S x R) x T
+   // where each is a sparse 4x4 matrix.
+   xform[0][0] = rx.x * a ;
+   xform[1][0] = rx.y * b ;
+   xform[2][0] = rx.z * c ;
+
+   xform[0][1] = ry.x * a ;
+   xform[1][1] = ry.y * b ;
+   xform[2][1] = ry.z * c ;
+
+   xform[0][2] = rz.x * a ;
+   xform[1][2] = rz.y * b ;
+   xform[2][2] = rz.z * c ;
+
+   d = s.w ;
+   if (d != 0)
+      d = 1/d ;
+
+   xform[3][0] = t.x * d ;
+   xform[3][1] = t.y * d ;
+   xform[3][2] = t.z * d ;
+
+   xform[0][3] = xform[1][3] = xform[2][3] = 0 ;
+   xform[3][3] = d ;
+
+   return *this ;
+   }
+
+/*--------------------------------------------------------
+ * Multiply two transform matrices.
+ */
+
+constexpr Transform Transform::operator*(Transform const& mx) const {
+   Transform mr ;
+   for (int i = 0 ; i < 4 ; i++)
+      for (int j = 0 ; j < 4 ; j++ )
+         mr.xform[i][j] = row(i).dot(mx.col(j)) ;
+   return mr ;
+   }
+
+constexpr Transform& Transform::operator*=(Transform const& mx) {
+   *this = *this * mx ;
+   return *this ;
+   }
+
+/*--------------------------------------------------------
+ * Add two transform matrices.
+ */
+
+constexpr Transform Transform::operator+(Transform const& mx) const {
+   Transform mr ;
+   for (int i = 0 ; i < 4 ; i++)
+      for (int j = 0 ; j < 4 ; j++ )
+         mr.xform[i][j] = xform[i][j] + mx.xform[i][j] ;
+   return mr ;
+   }
+
+constexpr Transform& Transform::operator+=(Transform const& mx) {
+   *this = *this + mx ;
+   return *this ;
+   }
+
+constexpr Transform Transform::operator*(scalar const& s) const {
+   Transform mr ;
+   for (int i = 0 ; i < 4 ; i++)
+      for (int j = 0 ; j < 4 ; j++ )
+         mr.xform[i][j] = s * xform[i][j] ;
+   return mr ;
+   }
+
+constexpr Transform& Transform::operator*=(scalar const& s) {
+   *this = *this * s ;
+   return *this ;
+   }
+
+constexpr Transform operator*(scalar const& s, Transform const& mx) {
+   return mx * s;
+   }
+
+constexpr Transform Transform::transpose() const {
+   return (Transform(col(0), col(1), col(2), col(3))) ;
+   }
+
 #endif
@@ -0,0 +1,188 @@
+/* -------- Xform2.h -----------
+
+   2D Transform Class Library Header
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   A 2D affine transform. Like Transform, it multiplies row vectors,
+   p' = p * mx, so it is stored as the three rows of a 3x2 matrix;
+   row 2 is the translation and the third column, (0 0 1), is not
+   stored:
+
+                       | xform[0][0]  xform[0][1]  0 |
+      [x' y' 1] = [x y 1] * | xform[1][0]  xform[1][1]  0 |
+                       | xform[2][0]  xform[2][1]  1 |
+
+*/
+
+#ifndef TRANSFORM2_H
+#define TRANSFORM2_H
+
+class Transform2 {
+   public:
+      scalar xform[3][2] ;
+
+      constexpr Transform2() ;
+      constexpr Transform2(Transform2 const& mx) = default ;
+      constexpr Transform2(Vector2 const& r0, Vector2 const& r1,
+                           Vector2 const& r2) ;
+
+			/// Set THIS transform matrix to identity.
+      constexpr void Identity() ;
+			/// Extract row r from THIS transform. (0 <= r <= 2)
+      constexpr Vector2 row(int r) const ;
+			/// Set row r of THIS transform. (0 <= r <= 2)
+      constexpr Transform2& setRow(int r, Vector2 const& v) ;
+			/// Determinant of the linear (upper 2x2) part.
+      constexpr scalar det() const ;
+			/// Return the inverse of THIS transform matrix. (Assumed to be well-conditioned.)
+      constexpr Transform2 inverse() const ;
+
+			/// Multiply THIS transform matrix times another. (THIS * mx: THIS, then mx)
+      constexpr Transform2 operator*(Transform2 const& mx) const ;
+			/// Multiply THIS transform matrix times another. Replace THIS. (THIS <- THIS * mx)
+      constexpr Transform2& operator*=(Transform2 const& mx) ;
+			/// Transform a position. (p * THIS)
+      friend constexpr Vector2 operator*(Vector2 const& p, Transform2 const& mx) ;
+			/// Transform a vector: the linear part only, no translation.
+      constexpr Vector2 linear(Vector2 const& v) const ;
+
+	   // Graphics transform constructions.
+	   // These functions concatenate operations.
+			/// Concatenate a translation to THIS transform matrix.
+      constexpr Transform2& translate(Vector2 const& v) ;
+			/// Concatenate a scaling operation to THIS.
+      constexpr Transform2& scale(Vector2 const& s) ;
+			/// Concatenate a (counterclockwise) rotation.
+      Transform2& rotate(scalar radians) ;
+			/// Concatenate a rotation of turns * 90 degrees. (No trigonometry.)
+      constexpr Transform2& rotate90(int turns) ;
+   } ;
+
+/* -----------------------------------------------------------
+ *  Inline definitions. As for Transform, everything that
+ *  needs no trigonometry is constexpr.
+ */
+
+constexpr Transform2::Transform2()
+   : xform() {
+   Identity() ;
+   }
+
+/* -----------------------------------------------------------
+ *  Create a transform matrix from its 3 rows. (r2 is the
+ *  translation.)
+ */
+constexpr Transform2::Transform2(Vector2 const& r0, Vector2 const& r1,
+                                 Vector2 const& r2)
+   : xform() {
+   xform[0][0] = r0.x ;
+   xform[0][1] = r0.y ;
+   xform[1][0] = r1.x ;
+   xform[1][1] = r1.y ;
+   xform[2][0] = r2.x ;
+   xform[2][1] = r2.y ;
+   }
+
+constexpr void Transform2::Identity() {
+   xform[0][0] = 1 ; xform[0][1] = 0 ;
+   xform[1][0] = 0 ; xform[1][1] = 1 ;
+   xform[2][0] = 0 ; xform[2][1] = 0 ;
+   }
+
+constexpr Vector2 Transform2::row(int r) const {
+   return Vector2(xform[r][0], xform[r][1]) ;
+   }
+
+constexpr Transform2& Transform2::setRow(int r, Vector2 const& v) {
+   xform[r][0] = v.x ;
+   xform[r][1] = v.y ;
+   return *this ;
+   }
+
+constexpr scalar Transform2::det() const {
+   return xform[0][0]*xform[1][1] - xform[0][1]*xform[1][0] ;
+   }
+
+/** -----------------------------------------------------------
+ * Invert the 2x2 by its adjugate; the translation is the old
+ * translation carried back through the inverse, negated.
+ **/
+constexpr Transform2 Transform2::inverse() const {
+   Transform2 inv ;
+   const scalar d = 1 / det() ;
+
+   inv.xform[0][0] =  xform[1][1] * d ;
+   inv.xform[0][1] = -xform[0][1] * d ;
+   inv.xform[1][0] = -xform[1][0] * d ;
+   inv.xform[1][1] =  xform[0][0] * d ;
+   inv.xform[2][0] = -(xform[2][0]*inv.xform[0][0] + xform[2][1]*inv.xform[1][0]) ;
+   inv.xform[2][1] = -(xform[2][0]*inv.xform[0][1] + xform[2][1]*inv.xform[1][1]) ;
+   return inv ;
+   }
+
+/*--------------------------------------------------------
+ * Multiply two transform matrices.
+ */
+constexpr Transform2 Transform2::operator*(Transform2 const& mx) const {
+   Transform2 mr ;
+   for (int i = 0 ; i < 3 ; i++)
+      for (int j = 0 ; j < 2 ; j++)
+         mr.xform[i][j] = xform[i][0]*mx.xform[0][j] + xform[i][1]*mx.xform[1][j] ;
+   mr.xform[2][0] += mx.xform[2][0] ;
+   mr.xform[2][1] += mx.xform[2][1] ;
+   return mr ;
+   }
+
+constexpr Transform2& Transform2::operator*=(Transform2 const& mx) {
+   *this = *this * mx ;
+   return *this ;
+   }
+
+constexpr Vector2 operator*(Vector2 const& p, Transform2 const& mx) {
+   return Vector2(p.x*mx.xform[0][0] + p.y*mx.xform[1][0] + mx.xform[2][0],
+                  p.x*mx.xform[0][1] + p.y*mx.xform[1][1] + mx.xform[2][1]) ;
+   }
+
+constexpr Vector2 Transform2::linear(Vector2 const& v) const {
+   return Vector2(v.x*xform[0][0] + v.y*xform[1][0],
+                  v.x*xform[0][1] + v.y*xform[1][1]) ;
+   }
+
+/* -----------------------------------------------------------
+   Simple transforms - Cumulative
+   (The 2D cases of Transform's, Graphics Gems I, p478)
+ */
+
+constexpr Transform2& Transform2::translate(Vector2 const& v) {
+   xform[2][0] += v.x ;
+   xform[2][1] += v.y ;
+   return *this ;
+   }
+
+constexpr Transform2& Transform2::scale(Vector2 const& s) {
+   for (int i = 0 ; i < 3 ; i++) {
+      xform[i][0] *= s.x ;
+      xform[i][1] *= s.y ;
+      }
+   return *this ;
+   }
+
+constexpr Transform2& Transform2::rotate90(int turns) {
+   scalar c = 0, s = 0, t = 0 ;
+   Transform::quarterTurn(turns, c, s) ;
+   for (int i = 0 ; i < 3 ; i++) {
+      t = xform[i][0] ;
+      xform[i][0] = t*c - xform[i][1] * s ;
+      xform[i][1] = t*s + xform[i][1] * c ;
+      }
+   return *this ;
+   }
+
+#endif
@@ -0,0 +1,523 @@
+/* -------- Accuracy.cpp -----------
+
+   Accuracy Regression Harness
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <chrono>
+#include <float.h>
+#include <string.h>
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+#include <Accuracy.h>
+#include <Batch.h>
+
+static const int inSize[ACCURACY_SUITES]  = { 3, 6, 16, 6 } ;
+static const int outSize[ACCURACY_SUITES] = { 3, 9, 16, 1 } ;
+
+/*------------------------------------------------------------
+ * A small xorshift generator so that runs are reproducible
+ * across platforms (rand() is not).
+ */
+class Random {
+   public:
+      unsigned long long state ;
+
+      Random(unsigned long long seed) : state(seed ? seed : 0x9E3779B97F4A7C15ull) { }
+
+      unsigned long long next() {
+         state ^= state >> 12 ;
+         state ^= state << 25 ;
+         state ^= state >> 27 ;
+         return state * 0x2545F4914F6CDD1Dull ;
+         }
+			// Uniform in [0,1)
+      double uniform() { return (next() >> 11) * (1.0/9007199254740992.0) ; }
+			// Uniform in [a,b)
+      double uniform(double a, double b) { return a + (b - a)*uniform() ; }
+			// Uniformly distributed unit vector
+      Direction direction() {
+         double z = uniform(-1, 1) ;
+         double r = sqrt(1 - z*z) ;
+         double phi = uniform(0, 2*PI) ;
+         return Direction(r*cos(phi), r*sin(phi), z) ;
+         }
+   } ;
+
+/*------------------------------------------------------------
+ * Extended precision references.
+ */
+static void normRef(scalar const* in, long double* out) {
+   long double m = MAX(fabsl(in[0]), MAX(fabsl(in[1]), fabsl(in[2]))) ;
+   if (m == 0) {
+      out[0] = out[1] = out[2] = 0 ;
+      return ;
+      }
+   long double x = in[0]/m, y = in[1]/m, z = in[2]/m ;
+   long double l = sqrtl(x*x + y*y + z*z) ;
+   out[0] = x/l ; out[1] = y/l ; out[2] = z/l ;
+   }
+
+static void rotateRef(scalar const* in, long double* out) {
+   long double ax = (long double)in[1]*in[5] - (long double)in[2]*in[4] ;
+   long double ay = (long double)in[2]*in[3] - (long double)in[0]*in[5] ;
+   long double az = (long double)in[0]*in[4] - (long double)in[1]*in[3] ;
+   long double s = sqrtl(ax*ax + ay*ay + az*az) ;
+   long double c = (long double)in[0]*in[3] + (long double)in[1]*in[4] + (long double)in[2]*in[5] ;
+   if (s != 0) {
+      ax /= s ; ay /= s ; az /= s ;
+      }
+   long double t = 1 - c ;
+   out[0] = ax*ax + (1 - ax*ax)*c ;
+   out[1] = ax*ay*t + az*s ;
+   out[2] = ax*az*t - ay*s ;
+   out[3] = ax*ay*t - az*s ;
+   out[4] = ay*ay + (1 - ay*ay)*c ;
+   out[5] = ay*az*t + ax*s ;
+   out[6] = ax*az*t + ay*s ;
+   out[7] = ay*az*t - ax*s ;
+   out[8] = az*az + (1 - az*az)*c ;
+   }
+
+			// Gauss-Jordan with partial pivoting. NaN if singular.
+static void inverseRef(scalar const* in, long double* out) {
+   long double a[4][8] ;
+   for (int i = 0 ; i < 4 ; i++)
+      for (int j = 0 ; j < 4 ; j++) {
+         a[i][j] = in[4*i + j] ;
+         a[i][j+4] = (i == j) ;
+         }
+   for (int c = 0 ; c < 4 ; c++) {
+      int p = c ;
+      for (int r = c+1 ; r < 4 ; r++)
+         if (fabsl(a[r][c]) > fabsl(a[p][c]))
+            p = r ;
+      if (a[p][c] == 0) {
+         for (int k = 0 ; k < 16 ; k++)
+            out[k] = NAN ;
+         return ;
+         }
+      for (int k = 0 ; k < 8 ; k++) {
+         long double t = a[c][k] ; a[c][k] = a[p][k] ; a[p][k] = t ;
+         }
+      long double d = 1 / a[c][c] ;
+      for (int k = 0 ; k < 8 ; k++)
+         a[c][k] *= d ;
+      for (int r = 0 ; r < 4 ; r++)
+         if (r != c) {
+            long double f = a[r][c] ;
+            for (int k = 0 ; k < 8 ; k++)
+               a[r][k] -= f*a[c][k] ;
+            }
+      }
+   for (int i = 0 ; i < 4 ; i++)
+      for (int j = 0 ; j < 4 ; j++)
+         out[4*i + j] = a[i][j+4] ;
+   }
+
+static void angleRef(scalar const* in, long double* out) {
+   long double ax = (long double)in[1]*in[5] - (long double)in[2]*in[4] ;
+   long double ay = (long double)in[2]*in[3] - (long double)in[0]*in[5] ;
+   long double az = (long double)in[0]*in[4] - (long double)in[1]*in[3] ;
+   long double c = (long double)in[0]*in[3] + (long double)in[1]*in[4] + (long double)in[2]*in[5] ;
+   out[0] = atan2l(sqrtl(ax*ax + ay*ay + az*az), c) ;
+   }
+
+typedef void (*Reference)(scalar const* in, long double* out) ;
+static const Reference reference[ACCURACY_SUITES] = { normRef, rotateRef, inverseRef, angleRef } ;
+
+/*------------------------------------------------------------
+ * Library implementations.
+ * Directions are loaded member by member: the inputs are
+ * already unit length and the constructor would renormalize.
+ */
+static Direction loadDirection(scalar const* p) {
+   Direction d ;
+   d.x = p[0] ; d.y = p[1] ; d.z = p[2] ;
+   return d ;
+   }
+
+static void normLib(scalar const* in, scalar* out, int n) {
+   for (int i = 0 ; i < n ; i++, in += 3, out += 3) {
+      Direction d(loadDirection(in)) ;
+      d.norm() ;
+      out[0] = d.x ; out[1] = d.y ; out[2] = d.z ;
+      }
+   }
+
+static void rotateLib(scalar const* in, scalar* out, int n) {
+   Transform mx ;
+   for (int i = 0 ; i < n ; i++, in += 6, out += 9) {
+      mx.setRotate(loadDirection(in), loadDirection(in+3)) ;
+      for (int r = 0 ; r < 3 ; r++)
+         for (int c = 0 ; c < 3 ; c++)
+            out[3*r + c] = mx.xform[r][c] ;
+      }
+   }
+
+			// Deinterleave into SoA chunks; the conversion is part of the cost.
+static void rotateBatch(scalar const* in, scalar* out, int n) {
+   const int CHUNK = 256 ;
+   scalar d[6][CHUNK] ;
+   Transform mx[CHUNK] ;
+   Vector3SoA d1(d[0], d[1], d[2]), d2(d[3], d[4], d[5]) ;
+   for (int i = 0 ; i < n ; i += CHUNK) {
+      int m = MIN(CHUNK, n - i) ;
+      for (int j = 0 ; j < m ; j++)
+         for (int k = 0 ; k < 6 ; k++)
+            d[k][j] = in[6*(i+j) + k] ;
+      setRotateBatch(d1, d2, mx, m) ;
+      for (int j = 0 ; j < m ; j++)
+         for (int r = 0 ; r < 3 ; r++)
+            for (int c = 0 ; c < 3 ; c++)
+               out[9*(i+j) + 3*r + c] = mx[j].xform[r][c] ;
+      }
+   }
+
+static void inverseLib(scalar const* in, scalar* out, int n) {
+   Transform mx ;
+   for (int i = 0 ; i < n ; i++, in += 16, out += 16) {
+      memcpy(mx.xform, in, sizeof(mx.xform)) ;
+      Transform inv(mx.inverse()) ;
+      memcpy(out, inv.xform, sizeof(inv.xform)) ;
+      }
+   }
+
+static void angleLib(scalar const* in, scalar* out, int n) {
+   for (int i = 0 ; i < n ; i++, in += 6)
+      out[i] = loadDirection(in).angle(loadDirection(in+3)) ;
+   }
+
+static void angleSoA(scalar const* in, scalar* out, int n) {
+   const int CHUNK = 256 ;
+   scalar d[6][CHUNK] ;
+   Vector3SoA d1(d[0], d[1], d[2]), d2(d[3], d[4], d[5]) ;
+   for (int i = 0 ; i < n ; i += CHUNK) {
+      int m = MIN(CHUNK, n - i) ;
+      for (int j = 0 ; j < m ; j++)
+         for (int k = 0 ; k < 6 ; k++)
+            d[k][j] = in[6*(i+j) + k] ;
+      angleBatch(d1, d2, out + i, m) ;
+      }
+   }
+
+/*------------------------------------------------------------
+ * Single precision versions of the same algorithms - the
+ * "float mode" a fast path would run in.
+ */
+static void normFloat(scalar const* in, scalar* out, int n) {
+   for (int i = 0 ; i < n ; i++, in += 3, out += 3) {
+      float x = (float)in[0], y = (float)in[1], z = (float)in[2] ;
+      float l = sqrtf(x*x + y*y + z*z) ;
+      if (l != 0 && l != 1) {
+         x /= l ; y /= l ; z /= l ;
+         }
+      out[0] = x ; out[1] = y ; out[2] = z ;
+      }
+   }
+
+			// Hardware reciprocal square root estimate plus one Newton step.
+static void normRsqrt(scalar const* in, scalar* out, int n) {
+   for (int i = 0 ; i < n ; i++, in += 3, out += 3) {
+      float x = (float)in[0], y = (float)in[1], z = (float)in[2] ;
+      float l2 = x*x + y*y + z*z ;
+      float r ;
+#ifdef __SSE__
+      r = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(l2))) ;
+#else
+      r = 1/sqrtf(l2) ;
+#endif
+      r = r*(1.5f - 0.5f*l2*r*r) ;
+      if (l2 == 0)
+         r = 1 ;
+      out[0] = x*r ; out[1] = y*r ; out[2] = z*r ;
+      }
+   }
+
+static void rotateFloat(scalar const* in, scalar* out, int n) {
+   for (int i = 0 ; i < n ; i++, in += 6, out += 9) {
+      float x1 = (float)in[0], y1 = (float)in[1], z1 = (float)in[2] ;
+      float x2 = (float)in[3], y2 = (float)in[4], z2 = (float)in[5] ;
+      float ax = y1*z2 - z1*y2, ay = z1*x2 - x1*z2, az = x1*y2 - y1*x2 ;
+      float s = sqrtf(ax*ax + ay*ay + az*az) ;
+      float c = x1*x2 + y1*y2 + z1*z2 ;
+      if (s != 0) {
+         ax /= s ; ay /= s ; az /= s ;
+         }
+      float t = 1 - c ;
+      out[0] = ax*ax + (1 - ax*ax)*c ;
+      out[1] = ax*ay*t + az*s ;
+      out[2] = ax*az*t - ay*s ;
+      out[3] = ax*ay*t - az*s ;
+      out[4] = ay*ay + (1 - ay*ay)*c ;
+      out[5] = ay*az*t + ax*s ;
+      out[6] = ax*az*t + ay*s ;
+      out[7] = ay*az*t - ax*s ;
+      out[8] = az*az + (1 - az*az)*c ;
+      }
+   }
+
+static void inverseFloat(scalar const* in, scalar* out, int n) {
+   for (int i = 0 ; i < n ; i++, in += 16, out += 16) {
+      float m[4][4], v[4][4] ;
+      for (int k = 0 ; k < 16 ; k++)
+         m[k/4][k%4] = (float)in[k] ;
+      v[0][0] =   m[1][1]*m[2][2] - m[1][2]*m[2][1] ;
+      v[1][0] = -(m[1][0]*m[2][2] - m[1][2]*m[2][0]) ;
+      v[2][0] =   m[1][0]*m[2][1] - m[1][1]*m[2][0] ;
+      v[0][1] = -(m[0][1]*m[2][2] - m[0][2]*m[2][1]) ;
+      v[1][1] =   m[0][0]*m[2][2] - m[0][2]*m[2][0] ;
+      v[2][1] = -(m[0][0]*m[2][1] - m[0][1]*m[2][0]) ;
+      v[0][2] =   m[0][1]*m[1][2] - m[0][2]*m[1][1] ;
+      v[1][2] = -(m[0][0]*m[1][2] - m[0][2]*m[1][0]) ;
+      v[2][2] =   m[0][0]*m[1][1] - m[0][1]*m[1][0] ;
+      float d = 1 / (m[0][0]*v[0][0] + m[0][1]*v[1][0] + m[0][2]*v[2][0]) ;
+      for (int r = 0 ; r < 3 ; r++)
+         for (int c = 0 ; c < 3 ; c++)
+            v[r][c] *= d ;
+      for (int c = 0 ; c < 3 ; c++)
+         v[3][c] = -(m[3][0]*v[0][c] + m[3][1]*v[1][c] + m[3][2]*v[2][c]) ;
+      v[0][3] = v[1][3] = v[2][3] = 0 ;
+      v[3][3] = 1 ;
+      for (int k = 0 ; k < 16 ; k++)
+         out[k] = v[k/4][k%4] ;
+      }
+   }
+
+static void angleFloat(scalar const* in, scalar* out, int n) {
+   for (int i = 0 ; i < n ; i++, in += 6) {
+      float x1 = (float)in[0], y1 = (float)in[1], z1 = (float)in[2] ;
+      float x2 = (float)in[3], y2 = (float)in[4], z2 = (float)in[5] ;
+      float ax = y1*z2 - z1*y2, ay = z1*x2 - x1*z2, az = x1*y2 - y1*x2 ;
+      out[i] = atan2f(sqrtf(ax*ax + ay*ay + az*az), x1*x2 + y1*y2 + z1*z2) ;
+      }
+   }
+
+/*------------------------------------------------------------
+ * Input generators. Random inputs are what a well behaved
+ * scene produces; adversarial inputs are the pathological
+ * cases the README warns about.
+ */
+static void store(scalar* p, Direction const& d) {
+   p[0] = d.x ; p[1] = d.y ; p[2] = d.z ;
+   }
+
+static void generate(AccuracySuite suite, bool adversarial, Random& rng,
+                     scalar* in, int n) {
+   for (int i = 0 ; i < n ; i++, in += inSize[suite]) {
+      switch (suite) {
+         case ACCURACY_NORM : {
+            Direction d(rng.direction()) ;
+            double s = rng.uniform(-3, 3) ;
+            if (adversarial) {
+               // Vectors whose squared length underflows or overflows,
+               // and vectors with wildly different coordinate magnitudes.
+               switch (i % 3) {
+                  case 0 : s = -rng.uniform(150, 320) ; break ;
+                  case 1 : s =  rng.uniform(150, 307) ; break ;
+                  case 2 : s = 0 ; d.y *= 1e-12 ; d.z *= 1e-12 ; break ;
+                  }
+               }
+            double m = pow(10., s) ;
+            in[0] = d.x*m ; in[1] = d.y*m ; in[2] = d.z*m ;
+            break ;
+            }
+         case ACCURACY_ROTATE :
+         case ACCURACY_ANGLE : {
+            Direction d1(rng.direction()), d2(rng.direction()) ;
+            if (adversarial) {
+               // d2 a hair away from -d1 (or from d1).
+               Direction e(rng.direction()) ;
+               double eps = pow(10., -rng.uniform(4, 16)) ;
+               double sgn = (i % 4) ? -1 : 1 ;
+               d2.set(sgn*d1.x + eps*e.x, sgn*d1.y + eps*e.y, sgn*d1.z + eps*e.z) ;
+               }
+            store(in, d1) ;
+            store(in+3, d2) ;
+            break ;
+            }
+         case ACCURACY_INVERSE : {
+            // Rotation times scale plus translation. Adversarial scales
+            // spread over up to 12 decades (condition number up to 1e12).
+            Transform mx ;
+            mx.setRotate(rng.direction(), rng.uniform(0, 2*PI)) ;
+            double spread = adversarial ? rng.uniform(0, 12) : rng.uniform(0, 1) ;
+            Vector4 s(pow(10., -spread/2), 1, pow(10., spread/2), 1) ;
+            if (adversarial && (i % 2))
+               s.y = pow(10., -spread) ;
+            Transform sm ;
+            sm.scale(s) ;
+            mx = sm * mx ;
+            mx.translate(Vector3(rng.uniform(-1e3, 1e3), rng.uniform(-1e3, 1e3),
+                                 rng.uniform(-1e3, 1e3))) ;
+            memcpy(in, mx.xform, sizeof(mx.xform)) ;
+            break ;
+            }
+         default :
+            break ;
+         }
+      }
+   }
+
+/*------------------------------------------------------------
+ * The harness.
+ */
+AccuracyHarness::AccuracyHarness(int n, unsigned long s)
+   : samples(n), seed(s), nVariants(0), nResults(0) {
+   addVariant(ACCURACY_NORM,    "Direction::norm",  normLib) ;
+   addVariant(ACCURACY_NORM,    "float",            normFloat,    true) ;
+   addVariant(ACCURACY_NORM,    "float rsqrt",      normRsqrt,    true) ;
+   addVariant(ACCURACY_ROTATE,  "setRotate",        rotateLib) ;
+   addVariant(ACCURACY_ROTATE,  "setRotateBatch",   rotateBatch) ;
+   addVariant(ACCURACY_ROTATE,  "float",            rotateFloat,  true) ;
+   addVariant(ACCURACY_INVERSE, "inverse",          inverseLib) ;
+   addVariant(ACCURACY_INVERSE, "float",            inverseFloat, true) ;
+   addVariant(ACCURACY_ANGLE,   "Direction::angle", angleLib) ;
+   addVariant(ACCURACY_ANGLE,   "angleBatch",       angleSoA) ;
+   addVariant(ACCURACY_ANGLE,   "float",            angleFloat,   true) ;
+   }
+
+bool AccuracyHarness::addVariant(AccuracySuite suite, const char* name,
+                                 AccuracyKernel kernel, bool single) {
+   if (nVariants >= MAX_VARIANTS || suite < 0 || suite >= ACCURACY_SUITES)
+      return false ;
+   Variant& v = variants[nVariants++] ;
+   v.suite = suite ;
+   v.name = name ;
+   v.kernel = kernel ;
+   v.single = single ;
+   return true ;
+   }
+
+const char* AccuracyHarness::suiteName(AccuracySuite suite) {
+   static const char* names[ACCURACY_SUITES] = { "norm", "rotate", "inverse", "angle" } ;
+   return (suite >= 0 && suite < ACCURACY_SUITES) ? names[suite] : "?" ;
+   }
+
+double AccuracyHarness::ulp(double x, bool single) {
+   x = fabs(x) ;
+   if (single) {
+      float f = (float)x ;
+      if (f < FLT_MIN)
+         return FLT_MIN * FLT_EPSILON ;
+      return nextafterf(f, HUGE_VALF) - f ;
+      }
+   if (x < DBL_MIN)
+      return DBL_MIN * DBL_EPSILON ;
+   return nextafter(x, HUGE_VAL) - x ;
+   }
+
+double AccuracyHarness::ulps(double a, double b) {
+   return fabs(a - b) / ulp(MAX(fabs(a), fabs(b))) ;
+   }
+
+int AccuracyHarness::run(FILE* out) {
+   int maxIn = 0, maxOut = 0 ;
+   for (int s = 0 ; s < ACCURACY_SUITES ; s++) {
+      maxIn = MAX(maxIn, inSize[s]) ;
+      maxOut = MAX(maxOut, outSize[s]) ;
+      }
+   scalar* in = new scalar[(size_t)samples * maxIn] ;
+   long double* ref = new long double[(size_t)samples * maxOut] ;
+
+   nResults = 0 ;
+   for (int s = 0 ; s < ACCURACY_SUITES ; s++) {
+      AccuracySuite suite = (AccuracySuite)s ;
+      for (int a = 0 ; a < 2 ; a++) {
+         Random rng(seed + 977*s + a) ;
+         generate(suite, a != 0, rng, in, samples) ;
+         for (int i = 0 ; i < samples ; i++)
+            reference[s](in + (size_t)i*inSize[s], ref + (size_t)i*outSize[s]) ;
+         for (int v = 0 ; v < nVariants ; v++)
+            if (variants[v].suite == suite)
+               measure(variants[v], a ? "adversarial" : "random", in, ref, samples) ;
+         }
+      }
+   delete [] in ;
+   delete [] ref ;
+
+   if (out) {
+      fprintf(out, "%-8s %-18s %-12s %9s %12s %12s %10s %10s\n",
+              "suite", "variant", "inputs", "count", "max ulp", "mean ulp",
+              "nonfinite", "Mops/s") ;
+      for (int i = 0 ; i < nResults ; i++) {
+         AccuracyResult const& r = results[i] ;
+         fprintf(out, "%-8s %-18s %-12s %9ld %12.4g %12.4g %10ld %10.2f\n",
+                 suiteName(r.suite), r.variant, r.inputs, r.count,
+                 r.maxUlp, r.meanUlp, r.nonFinite, r.mops) ;
+         }
+      }
+   return nResults ;
+   }
+
+/*------------------------------------------------------------
+ * Time one variant (repeating until the clock is trustworthy)
+ * and compare its results against the reference.
+ */
+void AccuracyHarness::measure(Variant const& v, const char* inputs,
+                              scalar const* in, long double const* ref, int n) {
+   if (nResults >= MAX_RESULTS)
+      return ;
+   const int no = outSize[v.suite] ;
+   scalar* res = new scalar[(size_t)n * no] ;
+
+   typedef std::chrono::steady_clock Clock ;
+   long runs = 0 ;
+   double seconds = 0 ;
+   Clock::time_point start = Clock::now() ;
+   do {
+      v.kernel(in, res, n) ;
+      runs++ ;
+      seconds = std::chrono::duration<double>(Clock::now() - start).count() ;
+      } while (seconds < 0.05) ;
+
+   AccuracyResult& r = results[nResults++] ;
+   r.suite = v.suite ;
+   r.variant = v.name ;
+   r.inputs = inputs ;
+   r.count = 0 ;
+   r.nonFinite = 0 ;
+   r.maxUlp = r.meanUlp = 0 ;
+   r.mops = seconds > 0 ? runs * (double)n / seconds * 1e-6 : 0 ;
+
+   for (int i = 0 ; i < n ; i++) {
+      long double const* rp = ref + (size_t)i*no ;
+      scalar const* p = res + (size_t)i*no ;
+      long double big = 0 ;
+      bool finite = true ;
+      for (int k = 0 ; k < no ; k++) {
+         finite = finite && isfinite((double)rp[k]) ;
+         big = MAX(big, fabsl(rp[k])) ;
+         }
+      if (!finite)
+         continue ;        // singular input: nothing to compare against
+      double err = 0 ;
+      for (int k = 0 ; k < no ; k++) {
+         if (!isfinite(p[k])) {
+            err = -1 ;
+            break ;
+            }
+         err = MAX(err, (double)fabsl(p[k] - rp[k])) ;
+         }
+      r.count++ ;
+      if (err < 0) {
+         r.nonFinite++ ;
+         continue ;
+         }
+      err /= ulp((double)big, v.single) ;
+      r.maxUlp = MAX(r.maxUlp, err) ;
+      r.meanUlp += err ;
+      }
+   if (r.count > r.nonFinite)
+      r.meanUlp /= (r.count - r.nonFinite) ;
+   delete [] res ;
+   }
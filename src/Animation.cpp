@@ -0,0 +1,189 @@
+/* -------- Animation.cpp -----------
+
+   Keyframe Animation
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <algorithm>
+#include <Animation.h>
+#include <Parallel.h>
+#include <VMath.h>
+
+			// Tracks per parallel chunk.
+static const int GRAIN = 256 ;
+			// Times per batch of trigonometry.
+static const int CHUNK = 256 ;
+			// Limit on the polar iterations of a decomposition.
+static const int POLAR_STEPS = 20 ;
+
+/** -----------------------------------------------------------
+ * Try the cached segment and the one after it (forward play),
+ * then fall back to a binary search. The cursor is kept in
+ * range, so a stale one from a shorter track is harmless.
+ **/
+int findSegment(scalar const* times, int n, scalar t, int& cursor) {
+   if (n <= 0)
+      return cursor = -1 ;
+   int i = MIN(MAX(cursor, -1), n - 1) ;
+
+   for (int step = 0 ; step < 2 ; step++, i++) {
+      if (i >= n)
+         break ;
+      const bool after = (i < 0) || times[i] <= t ;
+      const bool before = (i + 1 >= n) || t < times[i + 1] ;
+      if (after && before)
+         return cursor = i ;
+      }
+   return cursor = (int)(std::upper_bound(times, times + n, t) - times) - 1 ;
+   }
+
+Vector3 Vector3Track::sample(scalar t, int& cursor, Vector3 const& none) const {
+   const int n = (int)times.size() ;
+   if (n == 0)
+      return none ;
+   const int i = findSegment(&times[0], n, t, cursor) ;
+   if (i < 0)
+      return values[0] ;
+   if (i >= n - 1)
+      return values[n - 1] ;
+   const scalar f = (t - times[i])/(times[i + 1] - times[i]) ;
+   return values[i] + (values[i + 1] - values[i])*f ;
+   }
+
+Quaternion RotationTrack::sample(scalar t, int& cursor) const {
+   const int n = (int)times.size() ;
+   if (n == 0)
+      return Quaternion() ;
+   const int i = findSegment(&times[0], n, t, cursor) ;
+   if (i < 0)
+      return values[0] ;
+   if (i >= n - 1)
+      return values[n - 1] ;
+   const scalar f = (t - times[i])/(times[i + 1] - times[i]) ;
+   return slerp(values[i], values[i + 1], f) ;
+   }
+
+Transform TransformTrack::sample(scalar t, TrackCursor& cursor) const {
+   return compose(scale.sample(t, cursor.scale, Vector3(1, 1, 1)),
+                  rotation.sample(t, cursor.rotation),
+                  translation.sample(t, cursor.translation)) ;
+   }
+
+void sampleTracks(TransformTrack const* tracks, TrackCursor* cursors,
+                  int n, scalar t, Transform* out) {
+   parallelFor(n, GRAIN, [&](int begin, int end) {
+      for (int i = begin ; i < end ; i++)
+         out[i] = tracks[i].sample(t, cursors[i]) ;
+      }) ;
+   }
+
+void sampleTracks(TransformTrack const* tracks, TrackCursor* cursors,
+                  int n, scalar const* times, Transform* out) {
+   parallelFor(n, GRAIN, [&](int begin, int end) {
+      for (int i = begin ; i < end ; i++)
+         out[i] = tracks[i].sample(times[i], cursors[i]) ;
+      }) ;
+   }
+
+/** -----------------------------------------------------------
+ * Row i of the upper 3x3 is scale i times row i of the rotation.
+ * A reflection (negative determinant) goes into the scale, all
+ * three negated. The rows are then averaged with the inverse
+ * transpose (Higham's polar iteration), which converges to the
+ * nearest rotation; rows already orthonormal stop it at once.
+ **/
+Decomposition::Decomposition(Transform const& mx) {
+   const scalar (*m)[4] = mx.xform ;
+   scale.w = (m[3][3] != 0) ? 1/m[3][3] : 0 ;
+   translation = Vector3(m[3][0], m[3][1], m[3][2]) * scale.w ;
+
+   Vector3 r[3] ;
+   for (int i = 0 ; i < 3 ; i++)
+      r[i] = Vector3(m[i][0], m[i][1], m[i][2]) ;
+   const scalar sign = (r[0].dot(r[1].cross(r[2])) < 0) ? -1 : 1 ;
+   scale.x = sign*r[0].len() ;
+   scale.y = sign*r[1].len() ;
+   scale.z = sign*r[2].len() ;
+   r[0] /= scale.x ;
+   r[1] /= scale.y ;
+   r[2] /= scale.z ;
+
+   for (int k = 0 ; k < POLAR_STEPS ; k++) {
+      const Vector3 c0 = r[1].cross(r[2]), c1 = r[2].cross(r[0]), c2 = r[0].cross(r[1]) ;
+      const scalar det = r[0].dot(c0) ;
+      const Vector3 n0 = (r[0] + c0/det)*.5 ;
+      const Vector3 n1 = (r[1] + c1/det)*.5 ;
+      const Vector3 n2 = (r[2] + c2/det)*.5 ;
+      const Vector3 d0 = n0 - r[0], d1 = n1 - r[1], d2 = n2 - r[2] ;
+      r[0] = n0 ;
+      r[1] = n1 ;
+      r[2] = n2 ;
+      if (d0.dot(d0) + d1.dot(d1) + d2.dot(d2) < EPSILON*EPSILON*EPSILON*EPSILON)
+         break ;
+      }
+
+   rotation = Quaternion(Transform(r[0], r[1], r[2], Vector3())) ;
+   rotation.norm() ;
+   }
+
+			// The columns of the rotation matrix.
+void Decomposition::directions(Direction& rx, Direction& ry, Direction& rz) const {
+   const Transform mx = rotation.transform() ;
+   rx = Direction::Unit(mx.xform[0][0], mx.xform[1][0], mx.xform[2][0]) ;
+   ry = Direction::Unit(mx.xform[0][1], mx.xform[1][1], mx.xform[2][1]) ;
+   rz = Direction::Unit(mx.xform[0][2], mx.xform[1][2], mx.xform[2][2]) ;
+   }
+
+Decomposition interpolate(Decomposition const& a, Decomposition const& b, scalar t) {
+   const Vector4 s(a.scale.x + (b.scale.x - a.scale.x)*t, a.scale.y + (b.scale.y - a.scale.y)*t,
+                   a.scale.z + (b.scale.z - a.scale.z)*t, a.scale.w + (b.scale.w - a.scale.w)*t) ;
+   return Decomposition(a.translation + (b.translation - a.translation)*t,
+                        slerp(a.rotation, b.rotation, t), s) ;
+   }
+
+/** -----------------------------------------------------------
+ * slerp() with the arc found once: with c = cos(theta),
+ * sin((1-t) theta)/sin(theta) = cos(t theta) - c sin(t theta)/sin(theta),
+ * so each time needs only the sine and cosine of t theta, and
+ * those are done a chunk at a time.
+ **/
+void interpolateBatch(Decomposition const& a, Decomposition const& b,
+                      scalar const* times, Transform* out, int n) {
+   scalar c = a.rotation.dot(b.rotation) ;
+   const Quaternion e = (c < 0) ? -b.rotation : b.rotation ;
+   c = ABS(c) ;
+   const bool linear = c > 1 - EPSILON ;
+   const scalar theta = linear ? 0 : acos(c) ;
+   const scalar inv = linear ? 0 : 1/sin(theta) ;
+   scalar angle[CHUNK], s[CHUNK], co[CHUNK] ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      if (!linear) {
+         for (int j = 0 ; j < m ; j++)
+            angle[j] = times[i0 + j]*theta ;
+         vsincos(angle, s, co, m) ;
+         }
+      for (int j = 0 ; j < m ; j++) {
+         const scalar t = times[i0 + j] ;
+         Quaternion q ;
+         if (linear)
+            q = nlerp(a.rotation, e, t) ;
+         else {
+            const scalar wb = s[j]*inv ;
+            q = a.rotation*(co[j] - c*wb) + e*wb ;
+            }
+         const Vector4 sc(a.scale.x + (b.scale.x - a.scale.x)*t, a.scale.y + (b.scale.y - a.scale.y)*t,
+                          a.scale.z + (b.scale.z - a.scale.z)*t, a.scale.w + (b.scale.w - a.scale.w)*t) ;
+         out[i0 + j] = Decomposition(a.translation + (b.translation - a.translation)*t, q, sc).transform() ;
+         }
+      }
+   }
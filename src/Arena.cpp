@@ -0,0 +1,130 @@
+/* -------- Arena.cpp -----------
+
+   Arena (Bump) Allocator
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <Arena.h>
+
+Arena::Arena(size_t size) :
+   blockSize(size), first(0), current(0), offset(0) { }
+
+Arena::~Arena() {
+   current = 0 ;
+   trim() ;
+   }
+
+/** -----------------------------------------------------------
+ * Bump allocate from the current block. When it is full, move
+ * on to the next block kept from an earlier frame that is large
+ * enough, passing over (but keeping) any too small for this
+ * request; if none is, add a new one after the current block.
+ * Blocks are never freed here, so a frame that repeats the
+ * requests of an earlier one finds every block already there.
+ **/
+void* Arena::allocate(size_t bytes, size_t align) {
+   Block* b = current ? current : first ;
+   size_t at = current ? offset : 0 ;
+
+   for ( ; b ; b = b->next, at = 0) {
+      uintptr_t p = ((uintptr_t)(data(b) + at) + align - 1) & ~(uintptr_t)(align - 1) ;
+      if (p + bytes <= (uintptr_t)(data(b) + b->size)) {
+         current = b ;
+         offset = p + bytes - (uintptr_t)data(b) ;
+         return (void*)p ;
+         }
+      }
+
+   size_t size = MAX(blockSize, bytes + align) ;
+   b = (Block*)malloc(sizeof(Block) + size) ;
+   if (!b)
+      throw std::bad_alloc() ;
+   b->size = size ;
+   if (current) {
+      b->next = current->next ;
+      current->next = b ;
+      }
+   else {
+      b->next = first ;
+      first = b ;
+      }
+   current = b ;
+   offset = 0 ;
+   return allocate(bytes, align) ;
+   }
+
+/*------------------------------------------------------------
+ * Three coordinate arrays, each starting on an alignment
+ * boundary.
+ */
+Vector3SoA Arena::soa(int n) {
+   scalar* x = (scalar*)allocate(n*sizeof(scalar)) ;
+   scalar* y = (scalar*)allocate(n*sizeof(scalar)) ;
+   scalar* z = (scalar*)allocate(n*sizeof(scalar)) ;
+   return Vector3SoA(x, y, z) ;
+   }
+
+Arena::Marker Arena::mark() const {
+   Marker m ;
+   m.block = current ;
+   m.used = offset ;
+   return m ;
+   }
+
+void Arena::release(Marker const& m) {
+   current = (Block*)m.block ;
+   offset = m.used ;
+   }
+
+void Arena::reset() {
+   current = 0 ;
+   offset = 0 ;
+   }
+
+/*------------------------------------------------------------
+ * Free the blocks after the current one (all of them if nothing
+ * is allocated).
+ */
+void Arena::trim() {
+   Block* b = current ? current->next : first ;
+   if (current)
+      current->next = 0 ;
+   else
+      first = 0 ;
+   while (b) {
+      Block* next = b->next ;
+      free(b) ;
+      b = next ;
+      }
+   }
+
+size_t Arena::used() const {
+   if (!current)
+      return 0 ;
+   size_t total = offset ;
+   for (Block* b = first ; b != current ; b = b->next)
+      total += b->size ;
+   return total ;
+   }
+
+size_t Arena::capacity() const {
+   size_t total = 0 ;
+   for (Block* b = first ; b ; b = b->next)
+      total += b->size ;
+   return total ;
+   }
+
+Arena& Arena::thread() {
+   static thread_local Arena arena ;
+   return arena ;
+   }
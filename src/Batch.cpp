@@ -0,0 +1,354 @@
+/* -------- Batch.cpp -----------
+
+   Batch (Structure of Arrays) Vector Library
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <Batch.h>
+#include <VMath.h>
+#include <Dispatch.h>
+
+			// Scratch arrays for the vector math calls are this long.
+static const int CHUNK = 256 ;
+
+/*------------------------------------------------------------
+ * The upper 3x3 of setElements() (Rogers & Adams p55) from a
+ * unit axis and the sine and cosine of the angle. Written
+ * without branches so that it can be inlined into a vectorized
+ * loop.
+ */
+static inline void rotation(scalar ax, scalar ay, scalar az,
+                            scalar sinTheta, scalar cosTheta,
+                            scalar m[3][3]) {
+   const scalar oneMinusCos = 1 - cosTheta ;
+   const scalar xy = ax*ay ;
+   const scalar xz = ax*az ;
+   const scalar yz = ay*az ;
+
+   m[0][0] = ax*ax + (1 - ax*ax)*cosTheta ;
+   m[0][1] = xy*oneMinusCos + az*sinTheta ;
+   m[0][2] = xz*oneMinusCos - ay*sinTheta ;
+
+   m[1][0] = xy*oneMinusCos - az*sinTheta ;
+   m[1][1] = ay*ay + (1 - ay*ay)*cosTheta ;
+   m[1][2] = yz*oneMinusCos + ax*sinTheta ;
+
+   m[2][0] = xz*oneMinusCos + ay*sinTheta ;
+   m[2][1] = yz*oneMinusCos - ax*sinTheta ;
+   m[2][2] = az*az + (1 - az*az)*cosTheta ;
+   }
+
+			// As above, from an axis of length sinTheta, i.e. d1 cross d2
+			// before it is normalized.
+static inline void rotation(scalar ax, scalar ay, scalar az,
+                            scalar cosTheta, scalar m[3][3]) {
+   const scalar sinTheta = sqrt(ax*ax + ay*ay + az*az) ;
+   const scalar l = (sinTheta != 0) ? sinTheta : 1 ;
+   rotation(ax/l, ay/l, az/l, sinTheta, cosTheta, m) ;
+   }
+
+			// The rotation from unit vector a to unit vector b.
+static inline void rotation(scalar a[3], scalar b[3], scalar m[3][3]) {
+   rotation(a[1]*b[2] - a[2]*b[1],
+            a[2]*b[0] - a[0]*b[2],
+            a[0]*b[1] - a[1]*b[0],
+            a[0]*b[0] + a[1]*b[1] + a[2]*b[2], m) ;
+   }
+
+			// Store a 3x3 rotation as a Transform (no translation).
+static inline void store(Transform& mx, scalar m[3][3]) {
+   for (int r = 0 ; r < 3 ; r++) {
+      mx.xform[r][0] = m[r][0] ;
+      mx.xform[r][1] = m[r][1] ;
+      mx.xform[r][2] = m[r][2] ;
+      mx.xform[r][3] = 0 ;
+      }
+   mx.xform[3][0] = mx.xform[3][1] = mx.xform[3][2] = 0 ;
+   mx.xform[3][3] = 1 ;
+   }
+
+			// Project a unit vector onto the xz plane, as setRotateGimbal() does.
+static inline void project(scalar x, scalar z, scalar p[3]) {
+   const scalar l = sqrt(x*x + z*z) ;
+   const bool degenerate = (l == 0) ;
+   p[0] = degenerate ? 0 : x/(degenerate ? 1 : l) ;
+   p[1] = 0 ;
+   p[2] = degenerate ? -1 : z/(degenerate ? 1 : l) ;
+   }
+
+/*------------------------------------------------------------
+ * 2D operations. The output may alias an input element for
+ * element, so the pointers are not RESTRICT; SIMD_LOOP says
+ * the iterations are independent anyway.
+ */
+void transformBatch(Vector2SoA const& p, Transform2 const& mx,
+                    Vector2SoA const& out, int n) {
+   const scalar m00 = mx.xform[0][0], m01 = mx.xform[0][1] ;
+   const scalar m10 = mx.xform[1][0], m11 = mx.xform[1][1] ;
+   const scalar m20 = mx.xform[2][0], m21 = mx.xform[2][1] ;
+
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar x = p.x[i], y = p.y[i] ;
+      out.x[i] = x*m00 + y*m10 + m20 ;
+      out.y[i] = x*m01 + y*m11 + m21 ;
+      }
+   }
+
+void linearBatch(Vector2SoA const& v, Transform2 const& mx,
+                 Vector2SoA const& out, int n) {
+   const scalar m00 = mx.xform[0][0], m01 = mx.xform[0][1] ;
+   const scalar m10 = mx.xform[1][0], m11 = mx.xform[1][1] ;
+
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar x = v.x[i], y = v.y[i] ;
+      out.x[i] = x*m00 + y*m10 ;
+      out.y[i] = x*m01 + y*m11 ;
+      }
+   }
+
+void dotBatch(Vector2SoA const& v1, Vector2SoA const& v2,
+              scalar* out, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++)
+      out[i] = v1.x[i]*v2.x[i] + v1.y[i]*v2.y[i] ;
+   }
+
+void scaleBatch(Vector2SoA const& v, scalar s,
+                Vector2SoA const& out, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      out.x[i] = s*v.x[i] ;
+      out.y[i] = s*v.y[i] ;
+      }
+   }
+
+void mulBatch(Vector2SoA const& v1, Vector2SoA const& v2,
+              Vector2SoA const& out, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar x = v1.x[i]*v2.x[i], y = v1.y[i]*v2.y[i] ;
+      out.x[i] = x ;
+      out.y[i] = y ;
+      }
+   }
+
+/*------------------------------------------------------------
+ * 3D operations: the kernels are in DispatchKernels.h, one copy
+ * per instruction set. Aliasing as in 2D.
+ */
+
+void transformBatch(Vector3SoA const& p, Transform const& mx,
+                    Vector3SoA const& out, int n) {
+   kernels().transform(p, mx, out, n) ;
+   }
+
+void linearBatch(Vector3SoA const& v, Transform const& mx,
+                 Vector3SoA const& out, int n) {
+   kernels().linear(v, mx, out, n) ;
+   }
+
+void dotBatch(Vector3SoA const& v1, Vector3SoA const& v2,
+              scalar* out, int n) {
+   kernels().dot(v1, v2, out, n) ;
+   }
+
+void crossBatch(Vector3SoA const& v1, Vector3SoA const& v2,
+                Vector3SoA const& out, int n) {
+   kernels().cross(v1, v2, out, n) ;
+   }
+
+void normalizeBatch(Vector3SoA const& v, Vector3SoA const& out,
+                    int n, scalar* len) {
+   BatchKernels const& k = kernels() ;
+   if (len) {
+      k.normalize(v, out, len, n) ;
+      return ;
+      }
+   scalar l[CHUNK] ;
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK)
+      k.normalize(v + i0, out + i0, l, MIN(CHUNK, n - i0)) ;
+   }
+
+/** -----------------------------------------------------------
+ * Batch version of Transform::setRotate(d1, d2).
+ **/
+void setRotateBatch(Vector3SoA const& d1, Vector3SoA const& d2,
+                    Transform* out, int n) {
+   scalar const* RESTRICT x1 = d1.x ;
+   scalar const* RESTRICT y1 = d1.y ;
+   scalar const* RESTRICT z1 = d1.z ;
+   scalar const* RESTRICT x2 = d2.x ;
+   scalar const* RESTRICT y2 = d2.y ;
+   scalar const* RESTRICT z2 = d2.z ;
+
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      scalar m[3][3] ;
+      rotation(y1[i]*z2[i] - z1[i]*y2[i],
+               z1[i]*x2[i] - x1[i]*z2[i],
+               x1[i]*y2[i] - y1[i]*x2[i],
+               x1[i]*x2[i] + y1[i]*y2[i] + z1[i]*z2[i], m) ;
+      store(out[i], m) ;
+      }
+   }
+
+/** -----------------------------------------------------------
+ * Batch version of Transform::setRotateGimbal(d1, d2).
+ *    The scalar version builds three rotations as 4x4 matrices
+ * and multiplies them. Here the middle rotation - between two
+ * vectors in the xz plane - is always about the y axis, so it
+ * reduces to its cosine c and signed sine s (k = 1):
+ *
+ *              |  c  0 -s |
+ *       m2  =  |  0  k  0 |
+ *              |  s  0  c |
+ *
+ * and m1 * m2 only mixes columns 0 and 2 of m1. Only one full
+ * 3x3 product (by m3) remains.
+ *    When the projections are opposite, the scalar version uses
+ * rotateY(PI); c = cos(PI) and s = sin(PI) give the same matrix.
+ * When they are opposite only to within rounding, the axis
+ * of rotation vanishes and setElements() puts c (not 1) in the
+ * middle of m2; so does this.
+ **/
+void setRotateGimbalBatch(Vector3SoA const& d1, Vector3SoA const& d2,
+                          Transform* out, int n) {
+   scalar const* RESTRICT x1 = d1.x ;
+   scalar const* RESTRICT y1 = d1.y ;
+   scalar const* RESTRICT z1 = d1.z ;
+   scalar const* RESTRICT x2 = d2.x ;
+   scalar const* RESTRICT y2 = d2.y ;
+   scalar const* RESTRICT z2 = d2.z ;
+   const scalar cosPI = cos(PI) ;
+   const scalar sinPI = sin(PI) ;
+
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      scalar a[3] = { x1[i], y1[i], z1[i] } ;
+      scalar b[3] = { x2[i], y2[i], z2[i] } ;
+      scalar pa[3], pb[3], m1[3][3], m3[3][3], p[3][3] ;
+
+      project(a[0], a[2], pa) ;
+      project(b[0], b[2], pb) ;
+      rotation(a, pa, m1) ;         // d1 to pr_d1
+      rotation(pb, b, m3) ;         // pr_d2 to d2
+
+      // pr_d1 to pr_d2
+      scalar c = pa[0]*pb[0] + pa[2]*pb[2] ;
+      scalar s = pa[2]*pb[0] - pa[0]*pb[2] ;
+      const bool opposite = (c == -1) ;
+      s = opposite ? sinPI : s ;
+      c = opposite ? cosPI : c ;
+      const scalar k = (s != 0) ? 1 : c ;
+
+      for (int r = 0 ; r < 3 ; r++) {
+         p[r][0] = m1[r][0]*c + m1[r][2]*s ;
+         p[r][1] = m1[r][1]*k ;
+         p[r][2] = m1[r][2]*c - m1[r][0]*s ;
+         }
+      for (int r = 0 ; r < 3 ; r++)
+         for (int j = 0 ; j < 3 ; j++)
+            m1[r][j] = p[r][0]*m3[0][j] + p[r][1]*m3[1][j] + p[r][2]*m3[2][j] ;
+      store(out[i], m1) ;
+      }
+   }
+
+/** -----------------------------------------------------------
+ * Batch version of Transform::setRotate(axis, radians).
+ *    The sines and cosines come from vsincos() a chunk at a time.
+ **/
+void setRotateBatch(Vector3SoA const& axis, scalar const* radians,
+                    Transform* out, int n) {
+   scalar s[CHUNK], c[CHUNK] ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      scalar const* RESTRICT x = axis.x + i0 ;
+      scalar const* RESTRICT y = axis.y + i0 ;
+      scalar const* RESTRICT z = axis.z + i0 ;
+      Transform* RESTRICT mx = out + i0 ;
+
+      vsincos(radians + i0, s, c, m) ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++) {
+         scalar r[3][3] ;
+         rotation(x[i], y[i], z[i], s[i], c[i], r) ;
+         store(mx[i], r) ;
+         }
+      }
+   }
+
+/*------------------------------------------------------------
+ * Batch versions of Transform::rotateX/Y/Z(radians): rotate
+ * columns a and b of each transform by the angle.
+ * (Graphics Gems I, p478)
+ */
+static void rotateBatch(Transform* out, scalar const* radians, int n,
+                        int a, int b) {
+   scalar s[CHUNK], c[CHUNK] ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      Transform* RESTRICT mx = out + i0 ;
+
+      vsincos(radians + i0, s, c, m) ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++)
+         for (int r = 0 ; r < 4 ; r++) {
+            const scalar t = mx[i].xform[r][a] ;
+            mx[i].xform[r][a] = t*c[i] - mx[i].xform[r][b]*s[i] ;
+            mx[i].xform[r][b] = t*s[i] + mx[i].xform[r][b]*c[i] ;
+            }
+      }
+   }
+
+void rotateXBatch(Transform* out, scalar const* radians, int n) {
+   rotateBatch(out, radians, n, 1, 2) ;
+   }
+
+void rotateYBatch(Transform* out, scalar const* radians, int n) {
+   rotateBatch(out, radians, n, 2, 0) ;
+   }
+
+void rotateZBatch(Transform* out, scalar const* radians, int n) {
+   rotateBatch(out, radians, n, 0, 1) ;
+   }
+
+/** -----------------------------------------------------------
+ * Batch version of Direction::angle(d2): atan2 of the length of
+ * the cross product and the dot product, the atan2 by vatan2().
+ **/
+void angleBatch(Vector3SoA const& d1, Vector3SoA const& d2,
+                scalar* out, int n) {
+   scalar l[CHUNK], d[CHUNK] ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      scalar const* RESTRICT x1 = d1.x + i0 ;
+      scalar const* RESTRICT y1 = d1.y + i0 ;
+      scalar const* RESTRICT z1 = d1.z + i0 ;
+      scalar const* RESTRICT x2 = d2.x + i0 ;
+      scalar const* RESTRICT y2 = d2.y + i0 ;
+      scalar const* RESTRICT z2 = d2.z + i0 ;
+
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++) {
+         const scalar cx = y1[i]*z2[i] - z1[i]*y2[i] ;
+         const scalar cy = z1[i]*x2[i] - x1[i]*z2[i] ;
+         const scalar cz = x1[i]*y2[i] - y1[i]*x2[i] ;
+         l[i] = sqrt(cx*cx + cy*cy + cz*cz) ;
+         d[i] = x1[i]*x2[i] + y1[i]*y2[i] + z1[i]*z2[i] ;
+         }
+      vatan2(l, d, out + i0, m) ;
+      }
+   }
@@ -0,0 +1,242 @@
+/* -------- Clip.cpp -----------
+
+   Polygon Clipping
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <string.h>
+#include <Arena.h>
+#include <Clip.h>
+
+/*------------------------------------------------------------
+ * p on THIS  <=>  p * mx on the result: (a b c d)' = mx^-1 (a b c d)'.
+ * Transform::inverse() is for affine transforms only and mx is
+ * likely a projection, so the full 4x4 inverse is done here, by
+ * cofactors from the 2x2 minors of the top and bottom row pairs.
+ */
+Plane Plane::transform(Transform const& mx) const {
+   scalar const (*m)[4] = mx.xform ;
+   const scalar s0 = m[0][0]*m[1][1] - m[1][0]*m[0][1] ;
+   const scalar s1 = m[0][0]*m[1][2] - m[1][0]*m[0][2] ;
+   const scalar s2 = m[0][0]*m[1][3] - m[1][0]*m[0][3] ;
+   const scalar s3 = m[0][1]*m[1][2] - m[1][1]*m[0][2] ;
+   const scalar s4 = m[0][1]*m[1][3] - m[1][1]*m[0][3] ;
+   const scalar s5 = m[0][2]*m[1][3] - m[1][2]*m[0][3] ;
+   const scalar c5 = m[2][2]*m[3][3] - m[3][2]*m[2][3] ;
+   const scalar c4 = m[2][1]*m[3][3] - m[3][1]*m[2][3] ;
+   const scalar c3 = m[2][1]*m[3][2] - m[3][1]*m[2][2] ;
+   const scalar c2 = m[2][0]*m[3][3] - m[3][0]*m[2][3] ;
+   const scalar c1 = m[2][0]*m[3][2] - m[3][0]*m[2][2] ;
+   const scalar c0 = m[2][0]*m[3][1] - m[3][0]*m[2][1] ;
+   const scalar det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0 ;
+
+   const scalar inv[4][4] = {
+      {  m[1][1]*c5 - m[1][2]*c4 + m[1][3]*c3, -m[0][1]*c5 + m[0][2]*c4 - m[0][3]*c3,
+         m[3][1]*s5 - m[3][2]*s4 + m[3][3]*s3, -m[2][1]*s5 + m[2][2]*s4 - m[2][3]*s3 },
+      { -m[1][0]*c5 + m[1][2]*c2 - m[1][3]*c1,  m[0][0]*c5 - m[0][2]*c2 + m[0][3]*c1,
+        -m[3][0]*s5 + m[3][2]*s2 - m[3][3]*s1,  m[2][0]*s5 - m[2][2]*s2 + m[2][3]*s1 },
+      {  m[1][0]*c4 - m[1][1]*c2 + m[1][3]*c0, -m[0][0]*c4 + m[0][1]*c2 - m[0][3]*c0,
+         m[3][0]*s4 - m[3][1]*s2 + m[3][3]*s0, -m[2][0]*s4 + m[2][1]*s2 - m[2][3]*s0 },
+      { -m[1][0]*c3 + m[1][1]*c1 - m[1][2]*c0,  m[0][0]*c3 - m[0][1]*c1 + m[0][2]*c0,
+        -m[3][0]*s3 + m[3][1]*s1 - m[3][2]*s0,  m[2][0]*s3 - m[2][1]*s1 + m[2][2]*s0 } } ;
+
+   const scalar in[4] = { a, b, c, d } ;
+   scalar r[4] ;
+   for (int i = 0 ; i < 4 ; i++)
+      r[i] = (inv[i][0]*in[0] + inv[i][1]*in[1] + inv[i][2]*in[2] + inv[i][3]*in[3]) / det ;
+   return Plane(r[0], r[1], r[2], r[3]) ;
+   }
+
+/*------------------------------------------------------------
+ * A polygon being clipped: for each vertex its position and
+ * attributes (stride scalars) and the mesh vertex it is, or -1
+ * for a vertex made by clipping.
+ */
+class ClipPolygon {
+   public:
+      scalar* data ;
+      int*    source ;
+      int     count ;
+   } ;
+
+static inline scalar distance(Plane const& p, scalar const* v) {
+   return p.a*v[0] + p.b*v[1] + p.c*v[2] + p.d*v[3] ;
+   }
+
+/*------------------------------------------------------------
+ * One Sutherland-Hodgman pass: from in to out, keeping the part
+ * inside plane. An edge crossing the plane gets a vertex
+ * interpolated from its inside end, whichever way it runs.
+ */
+static void clipPass(ClipPolygon const& in, ClipPolygon& out, Plane const& plane, int stride,
+                     scalar* dist) {
+   for (int i = 0 ; i < in.count ; i++)
+      dist[i] = distance(plane, in.data + i*stride) ;
+
+   out.count = 0 ;
+   for (int i = 0 ; i < in.count ; i++) {
+      const int j = (i + 1 == in.count) ? 0 : i + 1 ;
+      const bool inI = dist[i] >= 0, inJ = dist[j] >= 0 ;
+      if (inI) {
+         memcpy(out.data + out.count*stride, in.data + i*stride, stride*sizeof(scalar)) ;
+         out.source[out.count++] = in.source[i] ;
+         }
+      if (inI != inJ) {
+         const int k = inI ? i : j, o = inI ? j : i ;
+         const scalar t = dist[k]/(dist[k] - dist[o]) ;
+         scalar const* p = in.data + k*stride ;
+         scalar const* q = in.data + o*stride ;
+         scalar* v = out.data + out.count*stride ;
+         for (int c = 0 ; c < stride ; c++)
+            v[c] = p[c] + t*(q[c] - p[c]) ;
+         out.source[out.count++] = -1 ;
+         }
+      }
+   }
+
+			// True if some vertex is outside plane.
+static bool cuts(ClipPolygon const& poly, Plane const& plane, int stride) {
+   for (int i = 0 ; i < poly.count ; i++)
+      if (distance(plane, poly.data + i*stride) < 0)
+         return true ;
+   return false ;
+   }
+
+/*------------------------------------------------------------
+ * Room for two polygons of up to size vertices each, and their
+ * distances to a plane, from one arena.
+ */
+class ClipScratch {
+   public:
+      ClipPolygon poly[2] ;
+      scalar*     dist ;
+      int         size ;
+
+      ClipScratch(Arena& arena, int n, int stride) : size(n) {
+         for (int k = 0 ; k < 2 ; k++) {
+            poly[k].data = arena.array<scalar>(n*stride) ;
+            poly[k].source = arena.array<int>(n) ;
+            }
+         dist = arena.array<scalar>(n) ;
+         }
+   } ;
+
+/** -----------------------------------------------------------
+ * Clip against the frustum planes in mask and the user planes,
+ * ping-ponging between the two scratch polygons, then append
+ * the vertices made to the mesh: all of them, or (if they do not
+ * fit) none. Each pass adds at most one vertex, so scratch of
+ * clipVertices(count, planeCount) holds every stage.
+ **/
+static int clip(ClipMesh& mesh, int const* polygon, int count, int* out, int mask,
+                Plane const* planes, int planeCount, ClipScratch& scratch) {
+   const int A = mesh.attributeCount ;
+   const int stride = 4 + A ;
+   ClipPolygon* poly = scratch.poly ;
+
+   ClipPolygon* cur = &poly[0] ;
+   cur->count = count ;
+   for (int i = 0 ; i < count ; i++) {
+      const int s = polygon[i] ;
+      scalar* v = cur->data + i*stride ;
+      v[0] = mesh.clip.x[s] ;
+      v[1] = mesh.clip.y[s] ;
+      v[2] = mesh.clip.z[s] ;
+      v[3] = mesh.clip.w[s] ;
+      if (A > 0)
+         memcpy(v + 4, mesh.attributes + s*A, A*sizeof(scalar)) ;
+      cur->source[i] = s ;
+      }
+
+   for (int p = 0 ; p < 6 + planeCount ; p++) {
+      const int bit = (p < 6) ? 1 << p : 0 ;
+      if (p < 6 && !(mask & bit))
+         continue ;
+      const Plane plane = (p < 6) ? frustumPlane(bit) : planes[p - 6] ;
+      if (p >= 6 && !cuts(*cur, plane, stride))
+         continue ;
+      ClipPolygon* next = (cur == &poly[0]) ? &poly[1] : &poly[0] ;
+      clipPass(*cur, *next, plane, stride, scratch.dist) ;
+      cur = next ;
+      if (cur->count < 3)
+         return 0 ;
+      }
+
+   int made = 0 ;
+   for (int i = 0 ; i < cur->count ; i++)
+      made += (cur->source[i] < 0) ;
+   if (mesh.vertices + made > mesh.capacity)
+      return -1 ;
+
+   for (int i = 0 ; i < cur->count ; i++) {
+      if (cur->source[i] >= 0) {
+         out[i] = cur->source[i] ;
+         continue ;
+         }
+      const int s = mesh.vertices++ ;
+      scalar const* v = cur->data + i*stride ;
+      mesh.clip.set(s, v[0], v[1], v[2], v[3]) ;
+      if (A > 0)
+         memcpy(mesh.attributes + s*A, v + 4, A*sizeof(scalar)) ;
+      out[i] = s ;
+      }
+   return cur->count ;
+   }
+
+int clipPolygon(ClipMesh& mesh, int const* polygon, int count, int* out,
+                int mask, Plane const* planes, int planeCount) {
+   if (count < 3)
+      return 0 ;
+   ArenaScope scope ;
+   ClipScratch scratch(scope.arena, clipVertices(count, planeCount), 4 + mesh.attributeCount) ;
+   return clip(mesh, polygon, count, out, mask, planes, planeCount, scratch) ;
+   }
+
+/*------------------------------------------------------------
+ * Only the planes some vertex is outside of can cut: the OR of
+ * the outcodes. Outside one plane entirely: the AND. If out or
+ * the mesh fills, the vertices appended so far are taken back.
+ */
+int clipTriangles(ClipMesh& mesh, unsigned char const* codes,
+                  int const* triangles, int n, int* out, int outCapacity,
+                  Plane const* planes, int planeCount) {
+   ArenaScope scope ;
+   ClipScratch scratch(scope.arena, clipVertices(3, planeCount), 4 + mesh.attributeCount) ;
+   int* poly = scope.arena.array<int>(scratch.size) ;
+   const int first = mesh.vertices ;
+   int written = 0 ;
+
+   for (int t = 0 ; t < n ; t++) {
+      int const* v = triangles + 3*t ;
+      int c[3] ;
+      for (int k = 0 ; k < 3 ; k++)
+         c[k] = codes ? codes[v[k]] : outcode(mesh.clip.vector(v[k])) ;
+      if (c[0] & c[1] & c[2])
+         continue ;
+
+      int m = 3 ;
+      if ((c[0] | c[1] | c[2]) == 0 && planeCount == 0)
+         memcpy(poly, v, 3*sizeof(int)) ;
+      else
+         m = clip(mesh, v, 3, poly, c[0] | c[1] | c[2], planes, planeCount, scratch) ;
+      if (m < 0 || written + m - 2 > outCapacity) {
+         mesh.vertices = first ;
+         return -1 ;
+         }
+      for (int k = 1 ; k + 1 < m ; k++) {
+         out[3*written + 0] = poly[0] ;
+         out[3*written + 1] = poly[k] ;
+         out[3*written + 2] = poly[k + 1] ;
+         written++ ;
+         }
+      }
+   return written ;
+   }
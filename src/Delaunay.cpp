@@ -0,0 +1,316 @@
+/* -------- Delaunay.cpp -----------
+
+   Delaunay Triangulation
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <Delaunay.h>
+#include <Parallel.h>
+#include <Predicates.h>
+#include <Sampling.h>
+
+			// The vertex at infinity, and the mark of a free triangle.
+static const int GHOST = -1 ;
+static const int FREE = -2 ;
+			// Cells of the Hilbert curve along each axis.
+static const int HILBERT = 1 << 16 ;
+
+/*------------------------------------------------------------
+ * Position along the Hilbert curve of cell (x, y).
+ */
+static unsigned long long hilbert(unsigned x, unsigned y) {
+   unsigned long long d = 0 ;
+   for (unsigned s = HILBERT/2 ; s > 0 ; s /= 2) {
+      const unsigned rx = (x & s) ? 1 : 0 ;
+      const unsigned ry = (y & s) ? 1 : 0 ;
+      d += (unsigned long long)s*s*((3*rx) ^ ry) ;
+      if (ry == 0) {
+         if (rx == 1) {
+            x = HILBERT - 1 - x ;
+            y = HILBERT - 1 - y ;
+            }
+         const unsigned t = x ;
+         x = y ;
+         y = t ;
+         }
+      }
+   return d ;
+   }
+
+void hilbertOrder(Vector2 const* points, int n, std::vector<int>& order) {
+   order.resize(n) ;
+   if (n == 0)
+      return ;
+   scalar x0 = points[0].x, y0 = points[0].y, x1 = x0, y1 = y0 ;
+   for (int i = 1 ; i < n ; i++) {
+      x0 = MIN(x0, points[i].x) ; x1 = MAX(x1, points[i].x) ;
+      y0 = MIN(y0, points[i].y) ; y1 = MAX(y1, points[i].y) ;
+      }
+   const scalar sx = (x1 > x0) ? (HILBERT - 1)/(x1 - x0) : 0 ;
+   const scalar sy = (y1 > y0) ? (HILBERT - 1)/(y1 - y0) : 0 ;
+
+   std::vector<unsigned long long> keys(n) ;
+   parallelFor(n, 1 << 16, [&](int begin, int end) {
+      for (int i = begin ; i < end ; i++) {
+         const unsigned x = (unsigned)((points[i].x - x0)*sx) ;
+         const unsigned y = (unsigned)((points[i].y - y0)*sy) ;
+         keys[i] = hilbert(x, y) << 32 | (unsigned)i ;
+         }
+      }) ;
+   std::sort(keys.begin(), keys.end()) ;
+   for (int i = 0 ; i < n ; i++)
+      order[i] = (int)(keys[i] & 0xFFFFFFFFu) ;
+   }
+
+/*------------------------------------------------------------
+ * A triangle, counterclockwise, n[i] the triangle across the
+ * edge opposite v[i]. A ghost has GHOST for one vertex; the
+ * other two are a hull edge, counterclockwise seen from outside.
+ */
+class Triangle {
+   public:
+      int v[3] ;
+      int n[3] ;
+      int stamp ;
+   } ;
+
+class Triangulation {
+   public:
+      Vector2 const*        P ;
+      std::vector<Triangle> tris ;
+
+      Triangulation(Vector2 const* points) : P(points), last(0), stamp(0) { }
+
+      bool start(int a, int b, int c) ;
+      void insert(int p) ;
+
+   private:
+      class Edge {
+         public:
+            int a, b ;         // counterclockwise in the hole
+            int outside ;      // the triangle beyond
+            int inside ;       // the removed triangle it bounded
+         } ;
+      std::vector<int>  hole ;
+      std::vector<Edge> edges ;
+      std::vector<int>  spare ;     // free triangles
+      int               last ;
+      int               stamp ;
+
+      bool conflict(int t, int p) const ;
+      int  locate(int p) const ;
+      int  make() ;
+   } ;
+
+/*------------------------------------------------------------
+ * Whether p is in the circumcircle of t. For a ghost that is
+ * the open half plane beyond its hull edge, and the open edge.
+ */
+bool Triangulation::conflict(int t, int p) const {
+   int const* v = tris[t].v ;
+   for (int i = 0 ; i < 3 ; i++)
+      if (v[i] == GHOST) {
+         Vector2 const& a = P[v[(i + 1) % 3]] ;
+         Vector2 const& b = P[v[(i + 2) % 3]] ;
+         const scalar o = orient2d(a, b, P[p]) ;
+         if (o != 0)
+            return o > 0 ;
+         Vector2 const& q = P[p] ;
+         return (a.x != b.x) ? (MIN(a.x, b.x) < q.x && q.x < MAX(a.x, b.x))
+                             : (MIN(a.y, b.y) < q.y && q.y < MAX(a.y, b.y)) ;
+         }
+   return incircle(P[v[0]], P[v[1]], P[v[2]], P[p]) > 0 ;
+   }
+
+/*------------------------------------------------------------
+ * Walk from the last triangle made toward p, across any edge
+ * p is beyond, to the triangle holding p or the ghost past
+ * the hull edge p is outside of.
+ */
+int Triangulation::locate(int p) const {
+   int t = last ;
+   for (int i = 0 ; i < 3 ; i++)
+      if (tris[t].v[i] == GHOST)
+         t = tris[t].n[i] ;
+
+   for (int step = 0 ; ; step++) {
+      Triangle const& T = tris[t] ;
+      int next = -1 ;
+      for (int k = 0 ; k < 3 && next < 0 ; k++) {
+         const int i = (k + step) % 3 ;
+         if (orient2d(P[T.v[(i + 1) % 3]], P[T.v[(i + 2) % 3]], P[p]) < 0)
+            next = T.n[i] ;
+         }
+      if (next < 0)
+         return t ;
+      t = next ;
+      Triangle const& N = tris[t] ;
+      if (N.v[0] == GHOST || N.v[1] == GHOST || N.v[2] == GHOST)
+         return t ;
+      }
+   }
+
+int Triangulation::make() {
+   if (!spare.empty()) {
+      const int t = spare.back() ;
+      spare.pop_back() ;
+      return t ;
+      }
+   tris.push_back(Triangle()) ;
+   tris.back().stamp = 0 ;
+   return (int)tris.size() - 1 ;
+   }
+
+/*------------------------------------------------------------
+ * The first triangle and the three ghosts around it. Each edge
+ * is linked to the one running the other way.
+ */
+bool Triangulation::start(int a, int b, int c) {
+   const scalar o = orient2d(P[a], P[b], P[c]) ;
+   if (o == 0)
+      return false ;
+   if (o < 0) {
+      const int t = b ;
+      b = c ;
+      c = t ;
+      }
+   const int v[4][3] = { { a, b, c }, { b, a, GHOST }, { c, b, GHOST }, { a, c, GHOST } } ;
+   tris.resize(4) ;
+   for (int t = 0 ; t < 4 ; t++)
+      for (int i = 0 ; i < 3 ; i++) {
+         tris[t].v[i] = v[t][i] ;
+         tris[t].stamp = 0 ;
+         }
+   for (int t = 0 ; t < 4 ; t++)
+      for (int i = 0 ; i < 3 ; i++) {
+         const int x = tris[t].v[(i + 1) % 3], y = tris[t].v[(i + 2) % 3] ;
+         for (int u = 0 ; u < 4 ; u++)
+            for (int j = 0 ; j < 3 ; j++)
+               if (tris[u].v[(j + 1) % 3] == y && tris[u].v[(j + 2) % 3] == x)
+                  tris[t].n[i] = u ;
+         }
+   last = 0 ;
+   return true ;
+   }
+
+/** -----------------------------------------------------------
+ * Bowyer-Watson: grow the hole from the located triangle over
+ * the neighbours in conflict, then fan p to its boundary.
+ **/
+void Triangulation::insert(int p) {
+   const int t0 = locate(p) ;
+   if (!conflict(t0, p))
+      return ;                         // a repeated point
+
+   stamp++ ;
+   hole.clear() ;
+   edges.clear() ;
+   hole.push_back(t0) ;
+   tris[t0].stamp = stamp ;
+   for (size_t k = 0 ; k < hole.size() ; k++) {
+      const int t = hole[k] ;
+      for (int i = 0 ; i < 3 ; i++) {
+         const int u = tris[t].n[i] ;
+         if (tris[u].stamp == stamp)
+            continue ;
+         if (conflict(u, p)) {
+            tris[u].stamp = stamp ;
+            hole.push_back(u) ;
+            }
+         else {
+            Edge e = { tris[t].v[(i + 1) % 3], tris[t].v[(i + 2) % 3], u, t } ;
+            edges.push_back(e) ;
+            }
+         }
+      }
+
+   for (size_t k = 0 ; k < hole.size() ; k++) {
+      tris[hole[k]].v[0] = FREE ;
+      spare.push_back(hole[k]) ;
+      }
+
+   const int m = (int)edges.size() ;
+   for (int k = 0 ; k < m ; k++) {
+      Edge& e = edges[k] ;
+      const int t = make() ;
+      Triangle& T = tris[t] ;
+      T.v[0] = e.a ;
+      T.v[1] = e.b ;
+      T.v[2] = p ;
+      T.n[2] = e.outside ;
+      T.stamp = 0 ;
+      Triangle& U = tris[e.outside] ;      // by vertices: slots are reused
+      for (int j = 0 ; j < 3 ; j++)
+         if (U.v[(j + 1) % 3] == e.b && U.v[(j + 2) % 3] == e.a)
+            U.n[j] = t ;
+      e.inside = t ;
+      }
+			// Around p: the triangle after (a, b, p) starts at b.
+   for (int k = 0 ; k < m ; k++) {
+      Triangle& T = tris[edges[k].inside] ;
+      for (int j = 0 ; j < m ; j++) {
+         if (edges[j].a == edges[k].b)
+            T.n[0] = edges[j].inside ;
+         if (edges[j].b == edges[k].a)
+            T.n[1] = edges[j].inside ;
+         }
+      }
+   last = edges[0].inside ;
+   }
+
+int delaunay(Vector2 const* points, int n, std::vector<int>& triangles) {
+   triangles.clear() ;
+   std::vector<int> order ;
+   hilbertOrder(points, n, order) ;
+
+			// A first triangle: two distinct points and one off their line.
+   int i1 = 1 ;
+   while (i1 < n && points[order[i1]].x == points[order[0]].x
+                 && points[order[i1]].y == points[order[0]].y)
+      i1++ ;
+   int i2 = i1 + 1 ;
+   while (i2 < n && orient2d(points[order[0]], points[order[i1]], points[order[i2]]) == 0)
+      i2++ ;
+   if (i2 >= n)
+      return 0 ;
+
+   Triangulation mesh(points) ;
+   mesh.start(order[0], order[i1], order[i2]) ;
+   for (int k = 1 ; k < n ; k++)
+      if (k != i1 && k != i2)
+         mesh.insert(order[k]) ;
+
+   for (size_t t = 0 ; t < mesh.tris.size() ; t++) {
+      int const* v = mesh.tris[t].v ;
+      if (v[0] >= 0 && v[1] >= 0 && v[2] >= 0)
+         triangles.insert(triangles.end(), v, v + 3) ;
+      }
+   return (int)triangles.size()/3 ;
+   }
+
+void delaunayBenchmark(int n, FILE* out) {
+   std::vector<scalar> u(2*n) ;
+   RandomStream rng(1) ;
+   rng.uniform(&u[0], 2*n) ;
+   std::vector<Vector2> points(n) ;
+   for (int i = 0 ; i < n ; i++)
+      points[i] = Vector2(u[i], u[n + i]) ;
+
+   std::vector<int> triangles ;
+   auto t0 = std::chrono::steady_clock::now() ;
+   const int count = delaunay(&points[0], n, triangles) ;
+   auto t1 = std::chrono::steady_clock::now() ;
+   const double sec = std::chrono::duration<double>(t1 - t0).count() ;
+   fprintf(out, "delaunay  %9d points %8d triangles %8.1f ms %7.2f Mpoints/s\n",
+           n, count, 1e3*sec, n*1e-6/sec) ;
+   }
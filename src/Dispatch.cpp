@@ -0,0 +1,176 @@
+/* -------- Dispatch.cpp -----------
+
+   Runtime Instruction Set Dispatch
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <Dispatch.h>
+#include "Jacobi.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define DISPATCH_X86 1
+#endif
+
+#define KERNEL_PASTE2(a, b) a##_##b
+#define KERNEL_PASTE(a, b)  KERNEL_PASTE2(a, b)
+
+			// The baseline: the compiler's default target.
+#define KERNEL(name) KERNEL_PASTE(name, sse2)
+#define KERNEL_TARGET
+#include "DispatchKernels.h"
+
+#ifdef DISPATCH_X86
+#define KERNEL(name) KERNEL_PASTE(name, avx2)
+#define KERNEL_TARGET __attribute__((target("avx2,fma")))
+#include "DispatchKernels.h"
+
+#define KERNEL(name) KERNEL_PASTE(name, avx512)
+#define KERNEL_TARGET __attribute__((target("avx512f,avx2,fma")))
+#include "DispatchKernels.h"
+#endif
+
+static const BatchKernels table[ISA_COUNT] = {
+   { ISA_SSE2, transform_sse2, linear_sse2, dot_sse2, cross_sse2, normalize_sse2,
+     eigen_sse2, svd_sse2 },
+#ifdef DISPATCH_X86
+   { ISA_AVX2, transform_avx2, linear_avx2, dot_avx2, cross_avx2, normalize_avx2,
+     eigen_avx2, svd_avx2 },
+   { ISA_AVX512, transform_avx512, linear_avx512, dot_avx512, cross_avx512, normalize_avx512,
+     eigen_avx512, svd_avx512 },
+#else
+   { ISA_SSE2, transform_sse2, linear_sse2, dot_sse2, cross_sse2, normalize_sse2,
+     eigen_sse2, svd_sse2 },
+   { ISA_SSE2, transform_sse2, linear_sse2, dot_sse2, cross_sse2, normalize_sse2,
+     eigen_sse2, svd_sse2 },
+#endif
+   } ;
+
+static const char* names[ISA_COUNT] = { "sse2", "avx2", "avx512" } ;
+
+/** -----------------------------------------------------------
+ * __builtin_cpu_supports() reads CPUID and also checks that the
+ * OS saves the wide registers (XGETBV), which CPUID alone does not.
+ **/
+SimdIsa detectIsa() {
+#ifdef DISPATCH_X86
+   __builtin_cpu_init() ;
+   if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      return ISA_AVX512 ;
+   if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      return ISA_AVX2 ;
+#endif
+   return ISA_SSE2 ;
+   }
+
+bool isaSupported(SimdIsa isa) {
+   return isa >= ISA_SSE2 && isa <= detectIsa() ;
+   }
+
+const char* isaName(SimdIsa isa) {
+   return (isa >= ISA_SSE2 && isa < ISA_COUNT) ? names[isa] : "unknown" ;
+   }
+
+			// The detected set, lowered to VECTORLIB_ISA if that names a supported one.
+static BatchKernels const* initial() {
+   SimdIsa isa = detectIsa() ;
+   const char* env = getenv("VECTORLIB_ISA") ;
+   if (env)
+      for (int i = 0 ; i < ISA_COUNT ; i++)
+         if (strcmp(env, names[i]) == 0 && isaSupported((SimdIsa)i))
+            isa = (SimdIsa)i ;
+   return &table[isa] ;
+   }
+
+static std::atomic<BatchKernels const*> active(0) ;
+
+BatchKernels const& kernels() {
+   BatchKernels const* k = active.load(std::memory_order_acquire) ;
+   if (!k) {
+      BatchKernels const* expected = 0 ;
+      active.compare_exchange_strong(expected, initial()) ;
+      k = active.load(std::memory_order_acquire) ;
+      }
+   return *k ;
+   }
+
+BatchKernels const& kernels(SimdIsa isa) {
+   return table[(isa >= ISA_SSE2 && isa < ISA_COUNT) ? isa : ISA_SSE2] ;
+   }
+
+bool setIsa(SimdIsa isa) {
+   if (!isaSupported(isa))
+      return false ;
+   active.store(&table[isa], std::memory_order_release) ;
+   return true ;
+   }
+
+/*------------------------------------------------------------
+ * Each kernel is run over the same n elements until 50 ms have
+ * passed; the best run is reported, in millions of elements per
+ * second.
+ */
+template<class F>
+static double throughput(int n, F const& run) {
+   double best = HUGE_VAL, total = 0 ;
+   while (total < .05) {
+      auto t0 = std::chrono::steady_clock::now() ;
+      run() ;
+      auto t1 = std::chrono::steady_clock::now() ;
+      const double sec = std::chrono::duration<double>(t1 - t0).count() ;
+      best = MIN(best, sec) ;
+      total += sec ;
+      }
+   return n*1e-6/best ;
+   }
+
+void dispatchBenchmark(int n, FILE* out) {
+   std::vector<scalar> data(10*n) ;
+   for (int i = 0 ; i < 10*n ; i++)
+      data[i] = 1 + (scalar)(i % 97)/97 ;
+   const Vector3SoA a(&data[0], &data[n], &data[2*n]) ;
+   const Vector3SoA b(&data[3*n], &data[4*n], &data[5*n]) ;
+   const Vector3SoA c(&data[6*n], &data[7*n], &data[8*n]) ;
+   scalar* s = &data[9*n] ;
+   Transform mx ;
+   mx.setRotate(Direction::Unit(1, 2, 3), .5) ;
+   // n symmetric matrices and room for U and V (eigen writes its vectors to V)
+   std::vector<scalar> mats(27*n) ;
+   for (int i = 0 ; i < 27*n ; i++)
+      mats[i] = 1 + (scalar)(i % 89)/89 ;
+   const Matrix3SoA ma(&mats[0], n), mu(&mats[9*n], n), mv(&mats[18*n], n) ;
+   for (int i = 0 ; i < n ; i++)
+      ma.set(i, ma.matrix(i) + ma.matrix(i).transpose()) ;
+
+   const SimdIsa chosen = kernels().isa ;
+   const char* env = getenv("VECTORLIB_ISA") ;
+   fprintf(out, "dispatch: detected %s, using %s%s\n", isaName(detectIsa()), isaName(chosen),
+           (env && strcmp(env, names[chosen]) == 0) ? " (VECTORLIB_ISA)" : "") ;
+   fprintf(out, "%-8s %10s %10s %10s %10s %10s %10s %10s   (M elements/s, n = %d)\n",
+           "isa", "transform", "linear", "dot", "cross", "normalize", "eigen", "svd", n) ;
+   for (int i = 0 ; i < ISA_COUNT ; i++) {
+      if (!isaSupported((SimdIsa)i))
+         continue ;
+      BatchKernels const& k = table[i] ;
+      fprintf(out, "%-6s %c %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", names[i], (i == chosen) ? '*' : ' ',
+              throughput(n, [&]() { k.transform(a, mx, c, n) ; }),
+              throughput(n, [&]() { k.linear(a, mx, c, n) ; }),
+              throughput(n, [&]() { k.dot(a, b, s, n) ; }),
+              throughput(n, [&]() { k.cross(a, b, c, n) ; }),
+              throughput(n, [&]() { k.normalize(a, c, s, n) ; }),
+              throughput(n, [&]() { k.eigen(ma, c, mv, n) ; }),
+              throughput(n, [&]() { k.svd(ma, mu, c, mv, n) ; })) ;
+      }
+   }
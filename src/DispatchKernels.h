@@ -0,0 +1,167 @@
+/* -------- DispatchKernels.h -----------
+
+   Runtime Instruction Set Dispatch Kernels
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   Included by Dispatch.cpp once per instruction set, with no include
+   guard: KERNEL(name) makes the name of this copy of a kernel and
+   KERNEL_TARGET is the attribute compiling it for its set.
+
+*/
+
+KERNEL_TARGET
+static void KERNEL(transform)(Vector3SoA const& p, Transform const& mx,
+                              Vector3SoA const& out, int n) {
+   const scalar m00 = mx.xform[0][0], m01 = mx.xform[0][1], m02 = mx.xform[0][2] ;
+   const scalar m10 = mx.xform[1][0], m11 = mx.xform[1][1], m12 = mx.xform[1][2] ;
+   const scalar m20 = mx.xform[2][0], m21 = mx.xform[2][1], m22 = mx.xform[2][2] ;
+   const scalar m30 = mx.xform[3][0], m31 = mx.xform[3][1], m32 = mx.xform[3][2] ;
+
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar x = p.x[i], y = p.y[i], z = p.z[i] ;
+      out.x[i] = x*m00 + y*m10 + z*m20 + m30 ;
+      out.y[i] = x*m01 + y*m11 + z*m21 + m31 ;
+      out.z[i] = x*m02 + y*m12 + z*m22 + m32 ;
+      }
+   }
+
+KERNEL_TARGET
+static void KERNEL(linear)(Vector3SoA const& v, Transform const& mx,
+                           Vector3SoA const& out, int n) {
+   const scalar m00 = mx.xform[0][0], m01 = mx.xform[0][1], m02 = mx.xform[0][2] ;
+   const scalar m10 = mx.xform[1][0], m11 = mx.xform[1][1], m12 = mx.xform[1][2] ;
+   const scalar m20 = mx.xform[2][0], m21 = mx.xform[2][1], m22 = mx.xform[2][2] ;
+
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar x = v.x[i], y = v.y[i], z = v.z[i] ;
+      out.x[i] = x*m00 + y*m10 + z*m20 ;
+      out.y[i] = x*m01 + y*m11 + z*m21 ;
+      out.z[i] = x*m02 + y*m12 + z*m22 ;
+      }
+   }
+
+KERNEL_TARGET
+static void KERNEL(dot)(Vector3SoA const& v1, Vector3SoA const& v2,
+                        scalar* out, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++)
+      out[i] = v1.x[i]*v2.x[i] + v1.y[i]*v2.y[i] + v1.z[i]*v2.z[i] ;
+   }
+
+KERNEL_TARGET
+static void KERNEL(cross)(Vector3SoA const& v1, Vector3SoA const& v2,
+                          Vector3SoA const& out, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar ax = v1.x[i], ay = v1.y[i], az = v1.z[i] ;
+      const scalar bx = v2.x[i], by = v2.y[i], bz = v2.z[i] ;
+      out.x[i] = ay*bz - az*by ;
+      out.y[i] = az*bx - ax*bz ;
+      out.z[i] = ax*by - ay*bx ;
+      }
+   }
+
+KERNEL_TARGET
+static void KERNEL(normalize)(Vector3SoA const& v, Vector3SoA const& out,
+                              scalar* len, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar x = v.x[i], y = v.y[i], z = v.z[i] ;
+      const scalar l = sqrt(x*x + y*y + z*z) ;
+      const scalar inv = (l > 0) ? 1/l : 0 ;
+      out.x[i] = x*inv ;
+      out.y[i] = y*inv ;
+      out.z[i] = z*inv ;
+      len[i] = l ;
+      }
+   }
+
+/*------------------------------------------------------------
+ * eigenBatch(): five sweeps, enough for any 3x3 as convergence
+ * is quadratic; written out, as a loop would keep the body from
+ * vectorizing. The rotations are in Jacobi.h.
+ */
+KERNEL_TARGET
+static void KERNEL(eigen)(Matrix3SoA const& a, Vector3SoA const& values,
+                          Matrix3SoA const& vectors, int n) {
+   scalar* RESTRICT lx = values.x ;
+   scalar* RESTRICT ly = values.y ;
+   scalar* RESTRICT lz = values.z ;
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      scalar a00 = a.m[0][0][i], a01 = a.m[0][1][i], a02 = a.m[0][2][i] ;
+      scalar a11 = a.m[1][1][i], a12 = a.m[1][2][i], a22 = a.m[2][2][i] ;
+      scalar v00 = 1, v01 = 0, v02 = 0, v10 = 0, v11 = 1, v12 = 0, v20 = 0, v21 = 0, v22 = 1 ;
+      sweep(a00, a01, a02, a11, a12, a22, VECTORS) ;
+      sweep(a00, a01, a02, a11, a12, a22, VECTORS) ;
+      sweep(a00, a01, a02, a11, a12, a22, VECTORS) ;
+      sweep(a00, a01, a02, a11, a12, a22, VECTORS) ;
+      sweep(a00, a01, a02, a11, a12, a22, VECTORS) ;
+      sort(a00, a11, a22, VECTORS) ;
+      lx[i] = a00 ;  ly[i] = a11 ;  lz[i] = a22 ;
+      vectors.m[0][0][i] = v00 ;  vectors.m[0][1][i] = v01 ;  vectors.m[0][2][i] = v02 ;
+      vectors.m[1][0][i] = v10 ;  vectors.m[1][1][i] = v11 ;  vectors.m[1][2][i] = v12 ;
+      vectors.m[2][0][i] = v20 ;  vectors.m[2][1][i] = v21 ;  vectors.m[2][2][i] = v22 ;
+      }
+   }
+
+/*------------------------------------------------------------
+ * svdBatch(): svd() across the lanes, six sweeps (fixed, as in eigenBatch(),
+ * and written out), the columns sorted by length, and U
+ * completed by cross products where a column vanishes, all by
+ * 0/1 factors and selects rather than branches.
+ */
+KERNEL_TARGET
+static void KERNEL(svd)(Matrix3SoA const& a, Matrix3SoA const& u, Vector3SoA const& s,
+                        Matrix3SoA const& v, int n) {
+   scalar* RESTRICT sx = s.x ;
+   scalar* RESTRICT sy = s.y ;
+   scalar* RESTRICT sz = s.z ;
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      Vector3 a0(a.m[0][0][i], a.m[1][0][i], a.m[2][0][i]) ;
+      Vector3 a1(a.m[0][1][i], a.m[1][1][i], a.m[2][1][i]) ;
+      Vector3 a2(a.m[0][2][i], a.m[1][2][i], a.m[2][2][i]) ;
+      Vector3 v0(1, 0, 0), v1(0, 1, 0), v2(0, 0, 1) ;
+      rotate(a0, a1, v0, v1) ;  rotate(a0, a2, v0, v2) ;  rotate(a1, a2, v1, v2) ;
+      rotate(a0, a1, v0, v1) ;  rotate(a0, a2, v0, v2) ;  rotate(a1, a2, v1, v2) ;
+      rotate(a0, a1, v0, v1) ;  rotate(a0, a2, v0, v2) ;  rotate(a1, a2, v1, v2) ;
+      rotate(a0, a1, v0, v1) ;  rotate(a0, a2, v0, v2) ;  rotate(a1, a2, v1, v2) ;
+      rotate(a0, a1, v0, v1) ;  rotate(a0, a2, v0, v2) ;  rotate(a1, a2, v1, v2) ;
+      rotate(a0, a1, v0, v1) ;  rotate(a0, a2, v0, v2) ;  rotate(a1, a2, v1, v2) ;
+
+      scalar l0 = sqrt(a0.dot(a0)), l1 = sqrt(a1.dot(a1)), l2 = sqrt(a2.dot(a2)) ;
+      order(l0, l1, a0, a1, v0, v1) ;
+      order(l1, l2, a1, a2, v1, v2) ;
+      order(l0, l1, a0, a1, v0, v1) ;
+
+      // the completion is blended by 0/1 factors: a select whose operand is
+      // computed only for it gets the arithmetic moved into a branch
+      const scalar tiny = 1e-15*l0 ;
+      const scalar f0 = (l0 == 0), f1 = (l1 > tiny), f2 = (l2 > tiny) ;
+      const Vector3 u0 = a0*(1/(l0 + f0)) + Vector3(f0, 0, 0) ;
+      const scalar fx = (ABS(u0.x) < .9) ;
+      const Vector3 p = u0.cross(Vector3(fx, 1 - fx, 0)) ;
+      const Vector3 u1 = a1*(f1/(l1 + (1 - f1))) + p*((1 - f1)/sqrt(p.dot(p))) ;
+      const Vector3 u2 = a2*(f2/(l2 + (1 - f2))) + u0.cross(u1)*(1 - f2) ;
+      sx[i] = l0 ;  sy[i] = l1 ;  sz[i] = l2 ;
+      u.m[0][0][i] = u0.x ;  u.m[0][1][i] = u1.x ;  u.m[0][2][i] = u2.x ;
+      u.m[1][0][i] = u0.y ;  u.m[1][1][i] = u1.y ;  u.m[1][2][i] = u2.y ;
+      u.m[2][0][i] = u0.z ;  u.m[2][1][i] = u1.z ;  u.m[2][2][i] = u2.z ;
+      v.m[0][0][i] = v0.x ;  v.m[0][1][i] = v1.x ;  v.m[0][2][i] = v2.x ;
+      v.m[1][0][i] = v0.y ;  v.m[1][1][i] = v1.y ;  v.m[1][2][i] = v2.y ;
+      v.m[2][0][i] = v0.z ;  v.m[2][1][i] = v1.z ;  v.m[2][2][i] = v2.z ;
+      }
+   }
+
+#undef KERNEL
+#undef KERNEL_TARGET
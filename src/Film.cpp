@@ -0,0 +1,118 @@
+/* -------- Film.cpp -----------
+
+   Film (Image Accumulator)
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <new>
+#include <Film.h>
+#include <Parallel.h>
+
+static const int TILE_PIXELS = FILM_TILE*FILM_TILE ;
+
+Film::Film(int w, int h)
+   : width(w), height(h),
+     tilesX((w + FILM_TILE - 1)/FILM_TILE), tilesY((h + FILM_TILE - 1)/FILM_TILE),
+     count(tilesX*tilesY*TILE_PIXELS), pixels(0), memory(0),
+     splats(3*(size_t)count) {
+   memory = malloc(count*sizeof(Pixel) + SIMD_ALIGN) ;
+   if (!memory)
+      throw std::bad_alloc() ;
+   pixels = (Pixel*)(((uintptr_t)memory + SIMD_ALIGN - 1) & ~(uintptr_t)(SIMD_ALIGN - 1)) ;
+   for (int i = 0 ; i < count ; i++)
+      new (pixels + i) Pixel ;
+   clear() ;
+   }
+
+Film::~Film() {
+   free(memory) ;
+   }
+
+int Film::index(int x, int y) const {
+   const int t = (y/FILM_TILE)*tilesX + x/FILM_TILE ;
+   return t*TILE_PIXELS + (y % FILM_TILE)*FILM_TILE + x % FILM_TILE ;
+   }
+
+/*------------------------------------------------------------
+ * Kahan: comp holds the low order bits the last addition to
+ * sum rounded away, and is taken out of the next one.
+ */
+static inline void kahan(scalar& sum, scalar& comp, scalar v) {
+   const scalar y = v - comp ;
+   const scalar t = sum + y ;
+   comp = (t - sum) - y ;
+   sum = t ;
+   }
+
+void Film::add(int x, int y, Color const& c, scalar weight) {
+   Pixel& p = pixels[index(x, y)] ;
+   for (int i = 0 ; i < 3 ; i++)
+      kahan(p.sum.c[i], p.comp.c[i], c.c[i]*weight) ;
+   kahan(p.weight, p.weightComp, weight) ;
+   }
+
+/*------------------------------------------------------------
+ * std::atomic<float> has no fetch_add before C++20: retry the
+ * exchange until no other thread got in between.
+ */
+static inline void atomicAdd(std::atomic<float>& a, float v) {
+   float old = a.load(std::memory_order_relaxed) ;
+   while (!a.compare_exchange_weak(old, old + v, std::memory_order_relaxed))
+      ;
+   }
+
+void Film::splat(int x, int y, Colorf const& c) {
+   std::atomic<float>* s = &splats[3*index(x, y)] ;
+   for (int i = 0 ; i < 3 ; i++)
+      if (c.c[i] != 0)
+         atomicAdd(s[i], c.c[i]) ;
+   }
+
+void Film::tile(int i, int& x0, int& y0, int& x1, int& y1) const {
+   x0 = (i % tilesX)*FILM_TILE ;
+   y0 = (i / tilesX)*FILM_TILE ;
+   x1 = MIN(x0 + FILM_TILE, width) ;
+   y1 = MIN(y0 + FILM_TILE, height) ;
+   }
+
+void Film::forTiles(std::function<void(int, int, int, int)> const& body) {
+   parallelFor(tiles(), 1, [&](int begin, int end) {
+      for (int i = begin ; i < end ; i++) {
+         int x0, y0, x1, y1 ;
+         tile(i, x0, y0, x1, y1) ;
+         body(x0, y0, x1, y1) ;
+         }
+      }) ;
+   }
+
+Color Film::pixel(int x, int y, scalar splatScale) const {
+   const int k = index(x, y) ;
+   const Pixel& p = pixels[k] ;
+   Color c = (p.weight != 0) ? p.sum/p.weight : Color() ;
+   for (int i = 0 ; i < 3 ; i++)
+      c.c[i] += splatScale*splats[3*k + i].load(std::memory_order_relaxed) ;
+   return c ;
+   }
+
+void Film::resolve(Color* out, scalar splatScale) const {
+   for (int y = 0 ; y < height ; y++)
+      for (int x = 0 ; x < width ; x++)
+         out[y*width + x] = pixel(x, y, splatScale) ;
+   }
+
+void Film::clear() {
+   for (int i = 0 ; i < count ; i++)
+      pixels[i] = Pixel() ;
+   for (std::atomic<float>& s : splats)
+      s.store(0, std::memory_order_relaxed) ;
+   }
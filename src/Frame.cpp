@@ -0,0 +1,92 @@
+/* -------- Frame.cpp -----------
+
+   Orthonormal Frame
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <Frame.h>
+
+/*------------------------------------------------------------
+ * Frame(n) for lane i, as plain scalars so the loops vectorize.
+ */
+static inline void tangents(scalar nx, scalar ny, scalar nz,
+                            scalar& sx, scalar& sy, scalar& sz,
+                            scalar& tx, scalar& ty, scalar& tz) {
+   const scalar sign = copysign((scalar)1, nz) ;
+   const scalar a = -1/(sign + nz) ;
+   const scalar b = nx*ny*a ;
+   sx = 1 + sign*nx*nx*a ;
+   sy = sign*b ;
+   sz = -sign*nx ;
+   tx = b ;
+   ty = sign + ny*ny*a ;
+   tz = -ny ;
+   }
+
+void frameBatch(Vector3SoA const& normals, Vector3SoA const& s,
+                Vector3SoA const& t, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++)
+      tangents(normals.x[i], normals.y[i], normals.z[i],
+               s.x[i], s.y[i], s.z[i], t.x[i], t.y[i], t.z[i]) ;
+   }
+
+void toLocalBatch(Frame const& frame, Vector3SoA const& v,
+                  Vector3SoA const& out, int n) {
+   const Direction s = frame.s, t = frame.t, nn = frame.n ;
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar x = v.x[i], y = v.y[i], z = v.z[i] ;
+      out.x[i] = x*s.x + y*s.y + z*s.z ;
+      out.y[i] = x*t.x + y*t.y + z*t.z ;
+      out.z[i] = x*nn.x + y*nn.y + z*nn.z ;
+      }
+   }
+
+void toWorldBatch(Frame const& frame, Vector3SoA const& v,
+                  Vector3SoA const& out, int n) {
+   const Direction s = frame.s, t = frame.t, nn = frame.n ;
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar x = v.x[i], y = v.y[i], z = v.z[i] ;
+      out.x[i] = x*s.x + y*t.x + z*nn.x ;
+      out.y[i] = x*s.y + y*t.y + z*nn.y ;
+      out.z[i] = x*s.z + y*t.z + z*nn.z ;
+      }
+   }
+
+void toLocalBatch(Vector3SoA const& normals, Vector3SoA const& v,
+                  Vector3SoA const& out, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar nx = normals.x[i], ny = normals.y[i], nz = normals.z[i] ;
+      scalar sx, sy, sz, tx, ty, tz ;
+      tangents(nx, ny, nz, sx, sy, sz, tx, ty, tz) ;
+      const scalar x = v.x[i], y = v.y[i], z = v.z[i] ;
+      out.x[i] = x*sx + y*sy + z*sz ;
+      out.y[i] = x*tx + y*ty + z*tz ;
+      out.z[i] = x*nx + y*ny + z*nz ;
+      }
+   }
+
+void toWorldBatch(Vector3SoA const& normals, Vector3SoA const& v,
+                  Vector3SoA const& out, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar nx = normals.x[i], ny = normals.y[i], nz = normals.z[i] ;
+      scalar sx, sy, sz, tx, ty, tz ;
+      tangents(nx, ny, nz, sx, sy, sz, tx, ty, tz) ;
+      const scalar x = v.x[i], y = v.y[i], z = v.z[i] ;
+      out.x[i] = x*sx + y*tx + z*nx ;
+      out.y[i] = x*sy + y*ty + z*ny ;
+      out.z[i] = x*sz + y*tz + z*nz ;
+      }
+   }
@@ -0,0 +1,367 @@
+/* -------- Hull.cpp -----------
+
+   Convex Hull
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <Hull.h>
+#include <Parallel.h>
+#include <Predicates.h>
+#include <Sampling.h>
+
+			// Fewer points than this per thread are not worth splitting.
+static const int SPLIT_MIN = 1 << 16 ;
+			// Relative rounding error allowed the plane distance (about 2^-48).
+static const scalar TOLERANCE = 4e-15 ;
+
+static inline scalar norm1(Vector3 const& v) {
+   return ABS(v.x) + ABS(v.y) + ABS(v.z) ;
+   }
+
+/*------------------------------------------------------------
+ * A face: vertices counterclockwise from outside, n[i] the face
+ * across edge v[i] -> v[i+1], and the points outside it with the
+ * farthest of them (by the unnormalized plane distance).
+ */
+class HullFace {
+   public:
+      int              v[3] ;
+      int              n[3] ;
+      std::vector<int> outside ;
+      int              far ;
+      scalar           farDist ;
+      bool             dead ;
+      int              stamp ;
+      Vector3          normal ;
+      scalar           tolerance ;
+
+      HullFace(Position const* P, int a, int b, int c)
+         : far(-1), farDist(0), dead(false), stamp(0) {
+         v[0] = a ; v[1] = b ; v[2] = c ;
+         n[0] = n[1] = n[2] = -1 ;
+         const Vector3 e1 = P[b] - P[a], e2 = P[c] - P[a] ;
+         normal = e1.cross(e2) ;
+         tolerance = TOLERANCE*norm1(e1)*norm1(e2) ;
+         }
+   } ;
+
+class Quickhull {
+   public:
+      Position const*       P ;
+      std::vector<HullFace> faces ;
+      std::vector<int>      pending ;    // faces that may have outside points
+      int                   stamp ;
+
+      Quickhull(Position const* points) : P(points), stamp(0) { }
+
+      bool run(std::vector<int> const& idx) ;
+      void emit(std::vector<int>& triangles) const ;
+
+   private:
+      class Edge {
+         public:
+            int a, b ;        // horizon edge a -> b of a visible face
+            int face ;        // the visible face
+            int across ;      // the face beyond it, not visible
+         } ;
+      std::vector<Edge> horizon ;
+      std::vector<int>  visible ;
+
+      bool above(int f, int p, scalar& d) const ;
+      bool assign(int p, int first, int last) ;
+      void link(int f, int a, int b) ;
+      void search(int f, int entry, int eye) ;
+      void add(int eye) ;
+   } ;
+
+/*------------------------------------------------------------
+ * Whether p is outside face f, and its (unnormalized) distance
+ * d from the plane. The distance settles it unless it is within
+ * its rounding error of 0 - the error of the normal grows with
+ * the edges, not the normal, for slivers - and orient3d() does.
+ */
+bool Quickhull::above(int f, int p, scalar& d) const {
+   HullFace const& F = faces[f] ;
+   const Vector3 r = P[p] - P[F.v[0]] ;
+   d = F.normal.dot(r) ;
+   const scalar bound = F.tolerance*norm1(r) ;
+   if (d > bound)
+      return true ;
+   if (d < -bound)
+      return false ;
+   return orient3d(P[F.v[0]], P[F.v[1]], P[F.v[2]], P[p]) < 0 ;
+   }
+
+			// Give p to the first face in [first, last) it is above.
+bool Quickhull::assign(int p, int first, int last) {
+   scalar d ;
+   for (int f = first ; f < last ; f++)
+      if (above(f, p, d)) {
+         HullFace& F = faces[f] ;
+         if (F.far < 0 || d > F.farDist) {
+            F.far = p ;
+            F.farDist = d ;
+            }
+         F.outside.push_back(p) ;
+         return true ;
+         }
+   return false ;
+   }
+
+			// Point the neighbour of f across a -> b at the face holding b -> a (of the first four).
+void Quickhull::link(int f, int a, int b) {
+   for (int g = 0 ; g < 4 ; g++)
+      for (int i = 0 ; i < 3 ; i++)
+         if (faces[g].v[i] == b && faces[g].v[(i + 1) % 3] == a)
+            for (int j = 0 ; j < 3 ; j++)
+               if (faces[f].v[j] == a && faces[f].v[(j + 1) % 3] == b)
+                  faces[f].n[j] = g ;
+   }
+
+/*------------------------------------------------------------
+ * Depth first over the faces the eye sees, entered across edge
+ * entry; the edges to faces it does not see are the horizon,
+ * found in counterclockwise order around the eye.
+ */
+void Quickhull::search(int f, int entry, int eye) {
+   faces[f].stamp = stamp ;
+   visible.push_back(f) ;
+   for (int k = (entry < 0) ? 0 : 1 ; k < 3 ; k++) {
+      const int i = (entry < 0) ? k : (entry + k) % 3 ;
+      const int g = faces[f].n[i] ;
+      if (faces[g].stamp == stamp)
+         continue ;
+      scalar d ;
+      if (above(g, eye, d)) {
+         int j = 0 ;
+         while (faces[g].n[j] != f)
+            j++ ;
+         search(g, j, eye) ;
+         }
+      else {
+         Edge e = { faces[f].v[i], faces[f].v[(i + 1) % 3], f, g } ;
+         horizon.push_back(e) ;
+         }
+      }
+   }
+
+/** -----------------------------------------------------------
+ * Replace the faces the eye sees by the cone from the horizon to
+ * the eye, and hand their outside points to the new faces.
+ **/
+void Quickhull::add(int f) {
+   const int eye = faces[f].far ;
+   stamp++ ;
+   horizon.clear() ;
+   visible.clear() ;
+   search(f, -1, eye) ;
+
+   const int first = (int)faces.size() ;
+   const int m = (int)horizon.size() ;
+   for (int k = 0 ; k < m ; k++) {
+      Edge const& e = horizon[k] ;
+      HullFace h(P, e.a, e.b, eye) ;
+      h.n[0] = e.across ;
+      h.n[1] = first + (k + 1) % m ;
+      h.n[2] = first + (k + m - 1) % m ;
+      faces.push_back(h) ;
+      int* across = faces[e.across].n ;
+      for (int j = 0 ; j < 3 ; j++)
+         if (across[j] == e.face)
+            across[j] = first + k ;
+      }
+
+   for (size_t k = 0 ; k < visible.size() ; k++) {
+      HullFace& V = faces[visible[k]] ;
+      V.dead = true ;
+      for (size_t i = 0 ; i < V.outside.size() ; i++)
+         if (V.outside[i] != eye)
+            assign(V.outside[i], first, first + m) ;
+      std::vector<int>().swap(V.outside) ;
+      }
+   for (int k = first ; k < first + m ; k++)
+      if (faces[k].far >= 0)
+         pending.push_back(k) ;
+   }
+
+			// p before q in (x, y, z) lexicographic order.
+static inline bool lexLess(Position const& p, Position const& q) {
+   return (p.x != q.x) ? p.x < q.x : (p.y != q.y) ? p.y < q.y : p.z < q.z ;
+   }
+
+/*------------------------------------------------------------
+ * The starting tetrahedron: the lexicographic extremes, the point
+ * farthest from their line, then from their plane. Ties go to
+ * the lexicographically least point. Each distance is a convex
+ * function, so of the points tied at its maximum the least is a
+ * vertex of the hull, never one in the middle of a face or edge
+ * (which, counting as inside, would never be removed).
+ */
+bool Quickhull::run(std::vector<int> const& idx) {
+   const int n = (int)idx.size() ;
+   if (n < 4)
+      return false ;
+
+   int i0 = idx[0], i1 = idx[0] ;
+   for (int k = 1 ; k < n ; k++) {
+      if (lexLess(P[idx[k]], P[i0])) i0 = idx[k] ;
+      if (lexLess(P[i1], P[idx[k]])) i1 = idx[k] ;
+      }
+   if (!lexLess(P[i0], P[i1]))
+      return false ;
+
+   const Vector3 line = P[i1] - P[i0] ;
+   int i2 = -1 ;
+   scalar best = 0 ;
+   for (int k = 0 ; k < n ; k++) {
+      const Vector3 c = line.cross(P[idx[k]] - P[i0]) ;
+      const scalar d = c.dot(c) ;
+      if (d > best || (d == best && i2 >= 0 && lexLess(P[idx[k]], P[i2]))) {
+         best = d ;
+         i2 = idx[k] ;
+         }
+      }
+   if (i2 < 0)
+      return false ;
+
+   const Vector3 normal = line.cross(P[i2] - P[i0]) ;
+   int i3 = -1 ;
+   best = 0 ;
+   for (int k = 0 ; k < n ; k++) {
+      const scalar d = ABS(normal.dot(P[idx[k]] - P[i0])) ;
+      if (d > best || (d == best && i3 >= 0 && lexLess(P[idx[k]], P[i3]))) {
+         best = d ;
+         i3 = idx[k] ;
+         }
+      }
+   if (i3 < 0 || orient3d(P[i0], P[i1], P[i2], P[i3]) == 0)
+      return false ;
+   if (orient3d(P[i0], P[i1], P[i2], P[i3]) < 0) {
+      const int t = i1 ;
+      i1 = i2 ;
+      i2 = t ;
+      }
+
+			// i3 is below (i0, i1, i2): the other faces wind around it.
+   faces.clear() ;
+   faces.push_back(HullFace(P, i0, i1, i2)) ;
+   faces.push_back(HullFace(P, i0, i3, i1)) ;
+   faces.push_back(HullFace(P, i1, i3, i2)) ;
+   faces.push_back(HullFace(P, i2, i3, i0)) ;
+   for (int f = 0 ; f < 4 ; f++)
+      for (int i = 0 ; i < 3 ; i++)
+         link(f, faces[f].v[i], faces[f].v[(i + 1) % 3]) ;
+
+   for (int k = 0 ; k < n ; k++) {
+      const int p = idx[k] ;
+      if (p != i0 && p != i1 && p != i2 && p != i3)
+         assign(p, 0, 4) ;
+      }
+   pending.clear() ;
+   for (int f = 0 ; f < 4 ; f++)
+      if (faces[f].far >= 0)
+         pending.push_back(f) ;
+
+   while (!pending.empty()) {
+      const int f = pending.back() ;
+      pending.pop_back() ;
+      if (!faces[f].dead)
+         add(f) ;
+      }
+   return true ;
+   }
+
+void Quickhull::emit(std::vector<int>& triangles) const {
+   for (size_t f = 0 ; f < faces.size() ; f++)
+      if (!faces[f].dead)
+         for (int i = 0 ; i < 3 ; i++)
+            triangles.push_back(faces[f].v[i]) ;
+   }
+
+/** -----------------------------------------------------------
+ * Split into a part per thread when there are enough points;
+ * only the vertices of the parts' hulls go on to the last one.
+ **/
+int convexHull(Position const* points, int n, std::vector<int>& triangles) {
+   triangles.clear() ;
+   std::vector<int> idx ;
+
+   const int parts = MIN(threadCount(), n/SPLIT_MIN) ;
+   if (parts > 1) {
+      std::vector<std::vector<int> > kept(parts) ;
+      parallelFor(parts, 1, [&](int begin, int end) {
+         for (int part = begin ; part < end ; part++) {
+            const int lo = (int)((long long)n*part/parts) ;
+            const int hi = (int)((long long)n*(part + 1)/parts) ;
+            std::vector<int> sub(hi - lo), tris ;
+            for (int k = lo ; k < hi ; k++)
+               sub[k - lo] = k ;
+            Quickhull hull(points) ;
+            if (!hull.run(sub)) {
+               kept[part].swap(sub) ;      // flat: keep every point
+               continue ;
+               }
+            hull.emit(tris) ;
+            std::vector<int>& keep = kept[part] ;
+            for (size_t k = 0 ; k < tris.size() ; k++)
+               keep.push_back(tris[k]) ;
+            std::sort(keep.begin(), keep.end()) ;
+            keep.erase(std::unique(keep.begin(), keep.end()), keep.end()) ;
+            }
+         }) ;
+      for (int part = 0 ; part < parts ; part++)
+         idx.insert(idx.end(), kept[part].begin(), kept[part].end()) ;
+      }
+   else {
+      idx.resize(n) ;
+      for (int k = 0 ; k < n ; k++)
+         idx[k] = k ;
+      }
+
+   Quickhull hull(points) ;
+   if (!hull.run(idx))
+      return 0 ;
+   hull.emit(triangles) ;
+   return (int)triangles.size()/3 ;
+   }
+
+/*------------------------------------------------------------
+ * Points uniform in the unit ball (few on the hull) and on the
+ * unit sphere (all on the hull).
+ */
+void hullBenchmark(int n, FILE* out) {
+   std::vector<scalar> u(3*n) ;
+   std::vector<Position> ball(n), sphere(n) ;
+   RandomStream rng(1) ;
+   rng.uniform(&u[0], 3*n) ;
+   Vector3SoA dirs(&u[0], &u[n], &u[2*n]) ;
+   std::vector<scalar> r(n) ;
+   rng.uniform(&r[0], n) ;
+   sampleSphere(&u[0], &u[n], dirs, n) ;
+   for (int i = 0 ; i < n ; i++) {
+      sphere[i] = Position(dirs.x[i], dirs.y[i], dirs.z[i]) ;
+      ball[i] = cbrt(r[i])*sphere[i] ;
+      }
+
+   std::vector<int> triangles ;
+   const char* names[2] = { "ball", "sphere" } ;
+   Position const* sets[2] = { &ball[0], &sphere[0] } ;
+   for (int s = 0 ; s < 2 ; s++) {
+      auto t0 = std::chrono::steady_clock::now() ;
+      const int faces = convexHull(sets[s], n, triangles) ;
+      auto t1 = std::chrono::steady_clock::now() ;
+      const double sec = std::chrono::duration<double>(t1 - t0).count() ;
+      fprintf(out, "hull %-6s %9d points %8d faces %8.1f ms %7.2f Mpoints/s (%d threads)\n",
+              names[s], n, faces, 1e3*sec, n*1e-6/sec, threadCount()) ;
+      }
+   }
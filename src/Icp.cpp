@@ -0,0 +1,386 @@
+/* -------- Icp.cpp -----------
+
+   Point Cloud Registration
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <chrono>
+#include <Icp.h>
+#include <Animation.h>
+#include <Parallel.h>
+#include <Sampling.h>
+#include <Simd.h>
+
+			// Partial sums kept per pair block: one SIMD lane each.
+static const int LANES = 8 ;
+			// Pairs per partial sum (a multiple of LANES); fixed, so sums do not depend on threads.
+static const int CHUNK = 4096 ;
+			// Source points per parallel chunk of the pairing.
+static const int GRAIN = 1024 ;
+
+/*------------------------------------------------------------
+ * The pairs of one iteration, coordinate by coordinate: moved
+ * source point p, target point q, target normal n and weight w
+ * (0 for a point with no target in range, and for the padding
+ * up to a multiple of LANES). Summing w * term needs no branch.
+ */
+class IcpPairs {
+   public:
+      std::vector<scalar> px, py, pz, qx, qy, qz, nx, ny, nz, w ;
+      int                 padded ;
+
+      void resize(int n, bool normals) {
+         padded = (n + LANES - 1)/LANES*LANES ;
+         std::vector<scalar>* all[10] = { &px, &py, &pz, &qx, &qy, &qz, &w, &nx, &ny, &nz } ;
+         for (int a = 0 ; a < (normals ? 10 : 7) ; a++)
+            all[a]->assign(padded, 0) ;
+         }
+   } ;
+
+/** -----------------------------------------------------------
+ * total[s] = the sum over the pairs of term s. block(i0, acc)
+ * adds the pairs i0 .. i0+LANES-1 into acc[s][lane]; the lanes
+ * and then the chunks are added up in a fixed order.
+ **/
+template <int S, class F>
+static void sumPairs(int padded, scalar* total, F const& block) {
+   const int chunks = (padded + CHUNK - 1)/CHUNK ;
+   std::vector<scalar> partial(chunks*S) ;
+   parallelFor(chunks, 1, [&](int begin, int end) {
+      for (int c = begin ; c < end ; c++) {
+         scalar acc[S][LANES] = { } ;
+         const int last = MIN(padded, (c + 1)*CHUNK) ;
+         for (int i0 = c*CHUNK ; i0 < last ; i0 += LANES)
+            block(i0, acc) ;
+         for (int s = 0 ; s < S ; s++) {
+            scalar t = 0 ;
+            for (int k = 0 ; k < LANES ; k++)
+               t += acc[s][k] ;
+            partial[c*S + s] = t ;
+            }
+         }
+      }) ;
+   for (int s = 0 ; s < S ; s++) {
+      total[s] = 0 ;
+      for (int c = 0 ; c < chunks ; c++)
+         total[s] += partial[c*S + s] ;
+      }
+   }
+
+/*------------------------------------------------------------
+ * Cyclic Jacobi on a symmetric 4x4; v gets the eigenvector of
+ * the largest eigenvalue.
+ */
+static void largestEigenvector(scalar a[4][4], scalar v[4]) {
+   scalar e[4][4] = { { 1, 0, 0, 0 }, { 0, 1, 0, 0 }, { 0, 0, 1, 0 }, { 0, 0, 0, 1 } } ;
+   for (int sweep = 0 ; sweep < 50 ; sweep++) {
+      scalar off = 0, diag = 0 ;
+      for (int i = 0 ; i < 4 ; i++) {
+         diag += a[i][i]*a[i][i] ;
+         for (int j = i + 1 ; j < 4 ; j++)
+            off += a[i][j]*a[i][j] ;
+         }
+      if (off <= 1e-30*diag)
+         break ;
+      for (int p = 0 ; p < 4 ; p++)
+         for (int q = p + 1 ; q < 4 ; q++) {
+            if (a[p][q] == 0)
+               continue ;
+            const scalar theta = (a[q][q] - a[p][p])/(2*a[p][q]) ;
+            const scalar t = ((theta >= 0) ? 1 : -1)/(ABS(theta) + sqrt(theta*theta + 1)) ;
+            const scalar c = 1/sqrt(t*t + 1), s = t*c ;
+            for (int k = 0 ; k < 4 ; k++) {
+               const scalar kp = a[k][p], kq = a[k][q] ;
+               a[k][p] = c*kp - s*kq ;
+               a[k][q] = s*kp + c*kq ;
+               }
+            for (int k = 0 ; k < 4 ; k++) {
+               const scalar pk = a[p][k], qk = a[q][k] ;
+               a[p][k] = c*pk - s*qk ;
+               a[q][k] = s*pk + c*qk ;
+               }
+            for (int k = 0 ; k < 4 ; k++) {
+               const scalar kp = e[k][p], kq = e[k][q] ;
+               e[k][p] = c*kp - s*kq ;
+               e[k][q] = s*kp + c*kq ;
+               }
+            }
+      }
+   int best = 0 ;
+   for (int i = 1 ; i < 4 ; i++)
+      if (a[i][i] > a[best][best])
+         best = i ;
+   for (int k = 0 ; k < 4 ; k++)
+      v[k] = e[k][best] ;
+   }
+
+/*------------------------------------------------------------
+ * Solve the 6x6 normal equations m x = b by Cholesky. A flat or
+ * symmetric scan leaves some motion undetermined; the diagonal
+ * is raised by a trace relative epsilon so that motion is 0.
+ */
+static void solve6(scalar m[6][6], scalar b[6], scalar x[6]) {
+   scalar trace = 0 ;
+   for (int i = 0 ; i < 6 ; i++)
+      trace += m[i][i] ;
+   for (int i = 0 ; i < 6 ; i++)
+      m[i][i] += 1e-12*trace + 1e-300 ;
+
+   scalar l[6][6] = { } ;
+   for (int j = 0 ; j < 6 ; j++) {
+      scalar d = m[j][j] ;
+      for (int k = 0 ; k < j ; k++)
+         d -= l[j][k]*l[j][k] ;
+      l[j][j] = sqrt(MAX(d, 1e-300)) ;
+      for (int i = j + 1 ; i < 6 ; i++) {
+         scalar s = m[i][j] ;
+         for (int k = 0 ; k < j ; k++)
+            s -= l[i][k]*l[j][k] ;
+         l[i][j] = s/l[j][j] ;
+         }
+      }
+   scalar y[6] ;
+   for (int i = 0 ; i < 6 ; i++) {
+      scalar s = b[i] ;
+      for (int k = 0 ; k < i ; k++)
+         s -= l[i][k]*y[k] ;
+      y[i] = s/l[i][i] ;
+      }
+   for (int i = 5 ; i >= 0 ; i--) {
+      scalar s = y[i] ;
+      for (int k = i + 1 ; k < 6 ; k++)
+         s -= l[k][i]*x[k] ;
+      x[i] = s/l[i][i] ;
+      }
+   }
+
+/** -----------------------------------------------------------
+ * Horn: with S the covariance of the centered pairs, the unit
+ * quaternion of the best rotation is the eigenvector of the
+ * largest eigenvalue of the symmetric 4x4 N(S). The translation
+ * then carries the source centroid onto the target centroid.
+ **/
+static Transform pointToPoint(IcpPairs const& pr, scalar& rms) {
+   scalar s1[8] ;
+   sumPairs<8>(pr.padded, s1, [&](int i0, scalar (&acc)[8][LANES]) {
+      SIMD_LOOP
+      for (int k = 0 ; k < LANES ; k++) {
+         const int i = i0 + k ;
+         const scalar w = pr.w[i] ;
+         const scalar dx = pr.px[i] - pr.qx[i], dy = pr.py[i] - pr.qy[i], dz = pr.pz[i] - pr.qz[i] ;
+         acc[0][k] += w ;
+         acc[1][k] += w*pr.px[i] ;
+         acc[2][k] += w*pr.py[i] ;
+         acc[3][k] += w*pr.pz[i] ;
+         acc[4][k] += w*pr.qx[i] ;
+         acc[5][k] += w*pr.qy[i] ;
+         acc[6][k] += w*pr.qz[i] ;
+         acc[7][k] += w*(dx*dx + dy*dy + dz*dz) ;
+         }
+      }) ;
+   rms = sqrt(s1[7]/s1[0]) ;
+   const Vector3 pc(s1[1]/s1[0], s1[2]/s1[0], s1[3]/s1[0]) ;
+   const Vector3 qc(s1[4]/s1[0], s1[5]/s1[0], s1[6]/s1[0]) ;
+
+   scalar s[9] ;
+   sumPairs<9>(pr.padded, s, [&](int i0, scalar (&acc)[9][LANES]) {
+      SIMD_LOOP
+      for (int k = 0 ; k < LANES ; k++) {
+         const int i = i0 + k ;
+         const scalar w = pr.w[i] ;
+         const scalar px = w*(pr.px[i] - pc.x), py = w*(pr.py[i] - pc.y), pz = w*(pr.pz[i] - pc.z) ;
+         const scalar qx = pr.qx[i] - qc.x, qy = pr.qy[i] - qc.y, qz = pr.qz[i] - qc.z ;
+         acc[0][k] += px*qx ;  acc[1][k] += px*qy ;  acc[2][k] += px*qz ;
+         acc[3][k] += py*qx ;  acc[4][k] += py*qy ;  acc[5][k] += py*qz ;
+         acc[6][k] += pz*qx ;  acc[7][k] += pz*qy ;  acc[8][k] += pz*qz ;
+         }
+      }) ;
+   const scalar xx = s[0], xy = s[1], xz = s[2], yx = s[3], yy = s[4], yz = s[5], zx = s[6], zy = s[7], zz = s[8] ;
+   scalar n[4][4] = {
+      { xx + yy + zz, yz - zy,      zx - xz,      xy - yx      },
+      { yz - zy,      xx - yy - zz, xy + yx,      zx + xz      },
+      { zx - xz,      xy + yx,      yy - xx - zz, yz + zy      },
+      { xy - yx,      zx + xz,      yz + zy,      zz - xx - yy } } ;
+   scalar v[4] ;
+   largestEigenvector(n, v) ;
+   Quaternion q(v[0], v[1], v[2], v[3]) ;
+   q.norm() ;
+   return compose(Vector3(1, 1, 1), q, qc - q.rotate(pc)) ;
+   }
+
+/** -----------------------------------------------------------
+ * Chen & Medioni, linearized: about the source centroid c, a
+ * small rotation w and translation t move p by w x (p-c) + t,
+ * so the plane distance is d + w.((p-c) x n) + t.n with d the
+ * current (p-q).n. Least squares over the pairs is a 6x6
+ * system; the rotation found is applied as an exact one.
+ **/
+static Transform pointToPlane(IcpPairs const& pr, scalar& rms) {
+   scalar s1[4] ;
+   sumPairs<4>(pr.padded, s1, [&](int i0, scalar (&acc)[4][LANES]) {
+      SIMD_LOOP
+      for (int k = 0 ; k < LANES ; k++) {
+         const int i = i0 + k ;
+         acc[0][k] += pr.w[i] ;
+         acc[1][k] += pr.w[i]*pr.px[i] ;
+         acc[2][k] += pr.w[i]*pr.py[i] ;
+         acc[3][k] += pr.w[i]*pr.pz[i] ;
+         }
+      }) ;
+   const Vector3 c(s1[1]/s1[0], s1[2]/s1[0], s1[3]/s1[0]) ;
+
+			// The upper triangle of A'A (21), then A'd (6), then d.d.
+   scalar s[28] ;
+   sumPairs<28>(pr.padded, s, [&](int i0, scalar (&acc)[28][LANES]) {
+      SIMD_LOOP
+      for (int k = 0 ; k < LANES ; k++) {
+         const int i = i0 + k ;
+         const scalar w = pr.w[i] ;
+         const scalar x = pr.px[i] - c.x, y = pr.py[i] - c.y, z = pr.pz[i] - c.z ;
+         const scalar nx = pr.nx[i], ny = pr.ny[i], nz = pr.nz[i] ;
+         const scalar a[6] = { y*nz - z*ny, z*nx - x*nz, x*ny - y*nx, nx, ny, nz } ;
+         const scalar d = (pr.px[i] - pr.qx[i])*nx + (pr.py[i] - pr.qy[i])*ny + (pr.pz[i] - pr.qz[i])*nz ;
+         int m = 0 ;
+         for (int r = 0 ; r < 6 ; r++)
+            for (int col = r ; col < 6 ; col++)
+               acc[m++][k] += w*a[r]*a[col] ;
+         for (int r = 0 ; r < 6 ; r++)
+            acc[21 + r][k] += w*a[r]*d ;
+         acc[27][k] += w*d*d ;
+         }
+      }) ;
+   rms = sqrt(s[27]/s1[0]) ;
+
+   scalar m[6][6], b[6], x[6] ;
+   int j = 0 ;
+   for (int r = 0 ; r < 6 ; r++)
+      for (int col = r ; col < 6 ; col++)
+         m[r][col] = m[col][r] = s[j++] ;
+   for (int r = 0 ; r < 6 ; r++)
+      b[r] = -s[21 + r] ;
+   solve6(m, b, x) ;
+
+   const Vector3 w(x[0], x[1], x[2]) ;
+   const scalar angle = w.len() ;
+   const Quaternion q = (angle > 0) ? Quaternion(Direction::Unit(w.x/angle, w.y/angle, w.z/angle), angle)
+                                    : Quaternion() ;
+   return compose(Vector3(1, 1, 1), q, c + Vector3(x[3], x[4], x[5]) - q.rotate(c)) ;
+   }
+
+/** -----------------------------------------------------------
+ * Pair, measure, stop if the error no longer improves, step.
+ **/
+IcpResult icp(Position const* source, int n, KdTree const& target,
+              Direction const* normals, Transform const& initial,
+              IcpOptions const& options) {
+   auto t0 = std::chrono::steady_clock::now() ;
+   IcpResult r ;
+   r.xform = initial ;
+   const bool plane = options.pointToPlane && normals ;
+   const scalar maxDist2 = (options.maxDistance < HUGE_VAL) ? options.maxDistance*options.maxDistance : HUGE_VAL ;
+   IcpPairs pr ;
+   pr.resize(n, plane) ;
+
+   for (int it = 0 ; it <= options.iterations ; it++) {
+      const Transform mx = r.xform ;
+      parallelFor(n, GRAIN, [&](int begin, int end) {
+         for (int i = begin ; i < end ; i++) {
+            const Position p = source[i] * mx ;
+            scalar d2 ;
+            const int j = target.nearest(p, d2, maxDist2) ;
+            const Position q = (j >= 0) ? target.point(j) : p ;
+            pr.px[i] = p.x ;  pr.py[i] = p.y ;  pr.pz[i] = p.z ;
+            pr.qx[i] = q.x ;  pr.qy[i] = q.y ;  pr.qz[i] = q.z ;
+            pr.w[i] = (j >= 0) ? 1 : 0 ;
+            if (plane) {
+               const Direction d = (j >= 0) ? normals[j] : ZAXIS ;
+               pr.nx[i] = d.x ;  pr.ny[i] = d.y ;  pr.nz[i] = d.z ;
+               }
+            }
+         }) ;
+      int found = 0 ;
+      for (int i = 0 ; i < n ; i++)
+         found += (pr.w[i] != 0) ;
+      r.queries += n ;
+      r.pairs = found ;
+      if (found < (plane ? 6 : 3))
+         break ;
+
+      scalar rms ;
+      const Transform step = plane ? pointToPlane(pr, rms) : pointToPoint(pr, rms) ;
+      r.history.push_back(rms) ;
+      const bool stalled = it > 0 && r.rms - rms <= options.tolerance*r.rms ;
+      r.rms = rms ;
+      if (stalled) {
+         r.converged = true ;
+         break ;
+         }
+      if (it == options.iterations)
+         break ;
+      r.xform = mx * step ;
+      r.iterations++ ;
+      }
+
+   r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() ;
+   return r ;
+   }
+
+void IcpResult::report(FILE* out) const {
+   fprintf(out, "icp: %d iterations, %s, rms %.3g over %d pairs\n", iterations,
+           converged ? "converged" : "not converged", rms, pairs) ;
+   fprintf(out, "     rms by iteration:") ;
+   for (size_t i = 0 ; i < history.size() ; i++)
+      fprintf(out, " %.3g", history[i]) ;
+   fprintf(out, "\n     %.1f ms, %ld nearest point queries, %.2f Mqueries/s (%d threads)\n",
+           1e3*seconds, queries, seconds > 0 ? queries*1e-6/seconds : 0., threadCount()) ;
+   }
+
+/*------------------------------------------------------------
+ * Two independent samplings of the surface z = .3 sin(3x) cos(2y)
+ * over [-1,1]^2; the source is moved off the target by a known
+ * rigid motion, which registration should undo.
+ */
+void icpBenchmark(int n, FILE* out) {
+   RandomStream rng(7) ;
+   std::vector<scalar> u(4*n) ;
+   rng.uniform(&u[0], 4*n) ;
+   std::vector<Position> target(n), source(n) ;
+   std::vector<Direction> normals(n) ;
+   for (int i = 0 ; i < n ; i++) {
+      const scalar x = 2*u[i] - 1, y = 2*u[n + i] - 1 ;
+      target[i] = Position(x, y, .3*sin(3*x)*cos(2*y)) ;
+      normals[i] = Direction(-.9*cos(3*x)*cos(2*y), .6*sin(3*x)*sin(2*y), 1) ;
+      const scalar sx = 2*u[2*n + i] - 1, sy = 2*u[3*n + i] - 1 ;
+      source[i] = Position(sx, sy, .3*sin(3*sx)*cos(2*sy)) ;
+      }
+   const Transform truth = compose(Vector3(1, 1, 1), Quaternion(Direction(1, 1, 1), .15),
+                                   Vector3(.05, -.03, .02)) ;
+   const Transform back = truth.inverse() ;
+   for (int i = 0 ; i < n ; i++)
+      source[i] = source[i] * back ;
+
+   auto t0 = std::chrono::steady_clock::now() ;
+   const KdTree tree(&target[0], n) ;
+   const double build = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() ;
+   fprintf(out, "icp benchmark: %d points, k-d tree built in %.1f ms\n", n, 1e3*build) ;
+
+   for (int plane = 0 ; plane < 2 ; plane++) {
+      IcpOptions options ;
+      options.pointToPlane = plane != 0 ;
+      const IcpResult r = icp(&source[0], n, tree, &normals[0], Transform(), options) ;
+      scalar error = 0 ;
+      for (int i = 0 ; i < 4 ; i++)
+         for (int j = 0 ; j < 3 ; j++)
+            error = MAX(error, ABS(r.xform.xform[i][j] - truth.xform[i][j])) ;
+      fprintf(out, "%s: largest error in the transform %.3g\n", plane ? "point to plane" : "point to point", error) ;
+      r.report(out) ;
+      }
+   }
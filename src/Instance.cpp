@@ -0,0 +1,270 @@
+/* -------- Instance.cpp -----------
+
+   Instanced Geometry
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <algorithm>
+#include <Instance.h>
+#include <Batch.h>
+
+Instance::Instance(Traceable const& obj, Transform const& mx)
+   : object(&obj), xform(mx), inverse(mx.inverse()), box(obj.bounds().transform(mx)) {
+   }
+
+/** -----------------------------------------------------------
+ * The direction is carried by the linear part of the inverse
+ * and comes out scaled by len; normalized again, the same point
+ * is len times as far along the object ray, so the interval is
+ * scaled by len and the object's distances divided by it.
+ **/
+scalar Instance::toObject(Ray const& ray, Ray& out) const {
+   scalar const (*m)[4] = inverse.xform ;
+   Direction const& d = ray.direction ;
+   const scalar dx = d.x*m[0][0] + d.y*m[1][0] + d.z*m[2][0] ;
+   const scalar dy = d.x*m[0][1] + d.y*m[1][1] + d.z*m[2][1] ;
+   const scalar dz = d.x*m[0][2] + d.y*m[1][2] + d.z*m[2][2] ;
+   const scalar len = sqrt(dx*dx + dy*dy + dz*dz) ;
+   out = Ray(ray.origin * inverse, Direction::Unit(dx/len, dy/len, dz/len),
+             ray.tmin*len, ray.tmax*len) ;
+   return len ;
+   }
+
+int InstanceTree::add(Traceable const& object, Transform const& mx) {
+   instances.push_back(Instance(object, mx)) ;
+   return (int)instances.size() - 1 ;
+   }
+
+void InstanceTree::clear() {
+   instances.clear() ;
+   order.clear() ;
+   nodes.clear() ;
+   }
+
+/*------------------------------------------------------------
+ * Median split on the longest axis of the box centers, as
+ * TriangleMesh builds its hierarchy.
+ */
+void InstanceTree::split(int index, int begin, int end, std::vector<Position> const& centroid) {
+   Bounds b ;
+   for (int i = begin ; i < end ; i++)
+      b.extend(instances[order[i]].box) ;
+   nodes[index].box = b ;
+   nodes[index].axis = 0 ;
+
+   if (end - begin <= INSTANCE_LEAF) {
+      nodes[index].child = begin ;
+      nodes[index].count = end - begin ;
+      return ;
+      }
+
+   Bounds c ;
+   for (int i = begin ; i < end ; i++)
+      c.extend(centroid[order[i]]) ;
+   const Vector3 e = c.extent() ;
+   const int axis = (e.x >= e.y && e.x >= e.z) ? 0 : (e.y >= e.z) ? 1 : 2 ;
+   const int mid = begin + (end - begin)/2 ;
+   std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                    [&centroid, axis](int a, int b) {
+                       return (&centroid[a].x)[axis] < (&centroid[b].x)[axis] ; }) ;
+
+   const int child = (int)nodes.size() ;
+   nodes.resize(child + 2) ;
+   nodes[index].child = child ;
+   nodes[index].count = 0 ;
+   nodes[index].axis = axis ;
+   split(child, begin, mid, centroid) ;
+   split(child + 1, mid, end, centroid) ;
+   }
+
+void InstanceTree::build() {
+   const int n = (int)instances.size() ;
+   nodes.clear() ;
+   order.resize(n) ;
+   if (n == 0)
+      return ;
+
+   std::vector<Position> centroid(n) ;
+   for (int i = 0 ; i < n ; i++) {
+      order[i] = i ;
+      centroid[i] = instances[i].box.center() ;
+      }
+   nodes.resize(1) ;
+   split(0, 0, n, centroid) ;
+   }
+
+Bounds InstanceTree::bounds() const {
+   return nodes.empty() ? Bounds() : nodes[0].box ;
+   }
+
+/** -----------------------------------------------------------
+ * Depth first, nearer child first, as TriangleMesh; in a leaf
+ * each instance whose box the ray enters is traced in object
+ * space, up to the closest hit so far.
+ **/
+bool InstanceTree::intersect(Ray const& ray, Hit& hit) const {
+   hit = Hit() ;
+   hit.t = ray.tmax ;
+   if (nodes.empty())
+      return false ;
+
+   const Vector3 invDir(1/ray.direction.x, 1/ray.direction.y, 1/ray.direction.z) ;
+   int stack[64], top = 0 ;
+   stack[top++] = 0 ;
+   while (top) {
+      Node const& n = nodes[stack[--top]] ;
+      if (!n.box.intersect(ray.origin, invDir, ray.tmin, hit.t))
+         continue ;
+      if (n.count) {
+         for (int j = n.child ; j < n.child + n.count ; j++) {
+            Instance const& inst = instances[order[j]] ;
+            if (!inst.box.intersect(ray.origin, invDir, ray.tmin, hit.t))
+               continue ;
+            Ray local ;
+            Hit h ;
+            const scalar len = inst.toObject(Ray(ray.origin, ray.direction, ray.tmin, hit.t), local) ;
+            if (inst.object->intersect(local, h) && h.t/len < hit.t) {
+               hit = h ;
+               hit.t = h.t/len ;
+               hit.instance = order[j] ;
+               }
+            }
+         continue ;
+         }
+      const bool negative = (&invDir.x)[n.axis] < 0 ;
+      stack[top++] = n.child + !negative ;
+      stack[top++] = n.child + negative ;
+      }
+   if (!hit.hit())
+      hit.t = HUGE_VAL ;
+   return hit.hit() ;
+   }
+
+bool InstanceTree::occluded(Ray const& ray) const {
+   if (nodes.empty())
+      return false ;
+
+   const Vector3 invDir(1/ray.direction.x, 1/ray.direction.y, 1/ray.direction.z) ;
+   int stack[64], top = 0 ;
+   stack[top++] = 0 ;
+   while (top) {
+      Node const& n = nodes[stack[--top]] ;
+      if (!n.box.intersect(ray.origin, invDir, ray.tmin, ray.tmax))
+         continue ;
+      if (n.count) {
+         for (int j = n.child ; j < n.child + n.count ; j++) {
+            Instance const& inst = instances[order[j]] ;
+            if (!inst.box.intersect(ray.origin, invDir, ray.tmin, ray.tmax))
+               continue ;
+            Ray local ;
+            inst.toObject(ray, local) ;
+            if (inst.object->occluded(local))
+               return true ;
+            }
+         continue ;
+         }
+      stack[top++] = n.child ;
+      stack[top++] = n.child + 1 ;
+      }
+   return false ;
+   }
+
+/** -----------------------------------------------------------
+ * Packet traversal of the top level: RayPacket::traverse(), as
+ * TriangleMesh does. In a leaf the whole packet is moved into
+ * each instance's space with the batch transforms - origins by
+ * transformBatch, directions by linearBatch - and the lanes still
+ * in the node go to the object as one packet. Only the object's
+ * node visits are added to stats; its rays are already counted.
+ **/
+void InstanceTree::tracePacket(Ray const* rays, Hit* hits, bool* blocked,
+                               int n, PacketStats* stats) const {
+   scalar dx[RAY_PACKET], dy[RAY_PACKET], dz[RAY_PACKET] ;
+   scalar lx[RAY_PACKET], ly[RAY_PACKET], lz[RAY_PACKET] ;   // object space origins
+   scalar ex[RAY_PACKET], ey[RAY_PACKET], ez[RAY_PACKET] ;   // object space directions
+   Ray    local[RAY_PACKET] ;
+   Hit    localHits[RAY_PACKET] ;
+   bool   localBlocked[RAY_PACKET] ;
+   int    lane[RAY_PACKET] ;
+   scalar len[RAY_PACKET] ;
+
+   RayPacket pk(rays, n, hits, blocked, stats) ;
+   for (int k = 0 ; k < n ; k++) {
+      dx[k] = rays[k].direction.x ;
+      dy[k] = rays[k].direction.y ;
+      dz[k] = rays[k].direction.z ;
+      }
+
+   pk.traverse(nodes.data(), (int)nodes.size(), stats, [&](Node const& node) {
+      for (int j = node.child ; j < node.child + node.count ; j++) {
+         Instance const& inst = instances[order[j]] ;
+         transformBatch(Vector3SoA(pk.ox, pk.oy, pk.oz), inst.inverse, Vector3SoA(lx, ly, lz), n) ;
+         linearBatch(Vector3SoA(dx, dy, dz), inst.inverse, Vector3SoA(ex, ey, ez), n) ;
+         SIMD_LOOP
+         for (int k = 0 ; k < n ; k++)
+            len[k] = sqrt(ex[k]*ex[k] + ey[k]*ey[k] + ez[k]*ez[k]) ;
+
+         int m = 0 ;
+         for (int k = 0 ; k < n ; k++) {
+            if (!pk.in[k] || !inst.box.intersect(rays[k].origin, Vector3(pk.ix[k], pk.iy[k], pk.iz[k]),
+                                                 pk.t0[k], pk.t1[k]))
+               continue ;
+            local[m] = Ray(Position(lx[k], ly[k], lz[k]),
+                           Direction::Unit(ex[k]/len[k], ey[k]/len[k], ez[k]/len[k]),
+                           pk.t0[k]*len[k], pk.t1[k]*len[k]) ;
+            lane[m++] = k ;
+            }
+         if (!m)
+            continue ;
+
+         PacketStats inner ;
+         if (hits) {
+            inst.object->intersectPacket(local, localHits, m, stats ? &inner : 0) ;
+            for (int i = 0 ; i < m ; i++) {
+               const int k = lane[i] ;
+               const scalar t = localHits[i].t/len[k] ;
+               if (localHits[i].hit() && t < hits[k].t) {
+                  hits[k] = localHits[i] ;
+                  hits[k].t = t ;
+                  hits[k].instance = order[j] ;
+                  pk.t1[k] = t ;
+                  }
+               }
+            }
+         else {
+            inst.object->occludedPacket(local, localBlocked, m, stats ? &inner : 0) ;
+            for (int i = 0 ; i < m ; i++)
+               if (localBlocked[i]) {
+                  blocked[lane[i]] = true ;
+                  pk.live[lane[i]] = false ;
+                  pk.in[lane[i]] = false ;
+                  }
+            }
+         if (stats) {
+            stats->visits += inner.visits ;
+            stats->slots += inner.slots ;
+            stats->lanes += inner.lanes ;
+            }
+         }
+      }) ;
+   if (hits)
+      pk.finish(hits) ;
+   }
+
+void InstanceTree::intersectPacket(Ray const* rays, Hit* hits, int n,
+                                   PacketStats* stats) const {
+   tracePacket(rays, hits, 0, n, stats) ;
+   }
+
+void InstanceTree::occludedPacket(Ray const* rays, bool* blocked, int n,
+                                  PacketStats* stats) const {
+   tracePacket(rays, 0, blocked, n, stats) ;
+   }
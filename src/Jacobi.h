@@ -0,0 +1,128 @@
+/* -------- Jacobi.h -----------
+
+   Jacobi Rotation Helpers
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   The rotations shared by the scalar decompositions of Matrix3.cpp
+   and the batch kernels of DispatchKernels.h. All inline, so each
+   instruction set's copy of a kernel gets them compiled for its set.
+
+*/
+
+#ifndef JACOBI_H
+#define JACOBI_H
+
+#include <Matrix3.h>
+
+/*------------------------------------------------------------
+ * One Jacobi rotation of a symmetric 3x3 in the (p,q) plane, r
+ * the third index, zeroing apq (Numerical Recipes' form, with
+ * theta multiplied through by 2 apq so that apq = 0 needs no
+ * branch: it gives t = 0). The sign comes from copysign and a
+ * zero divisor is bumped to 1 by arithmetic, not selected: under
+ * the default -ftrapping-math GCC moves the operations of either
+ * side of a ?: into a branch, which only AVX-512's masks can
+ * vectorize. The columns p and q of the eigenvector matrix turn
+ * with it.
+ */
+static inline void rotate(scalar& app, scalar& aqq, scalar& apq, scalar& arp, scalar& arq,
+                          scalar& v0p, scalar& v0q, scalar& v1p, scalar& v1q,
+                          scalar& v2p, scalar& v2q) {
+   const scalar tau = aqq - app ;
+   const scalar den = ABS(tau) + sqrt(tau*tau + 4*apq*apq) ;
+   const scalar t = copysign((scalar)2, tau)*apq/(den + (den == 0)) ;
+   const scalar c = 1/sqrt(t*t + 1), s = t*c ;
+
+   app -= t*apq ;
+   aqq += t*apq ;
+   apq = 0 ;
+   const scalar rp = arp, rq = arq ;
+   arp = c*rp - s*rq ;
+   arq = s*rp + c*rq ;
+
+   scalar kp = v0p, kq = v0q ;
+   v0p = c*kp - s*kq ;  v0q = s*kp + c*kq ;
+   kp = v1p ;  kq = v1q ;
+   v1p = c*kp - s*kq ;  v1q = s*kp + c*kq ;
+   kp = v2p ;  kq = v2q ;
+   v2p = c*kp - s*kq ;  v2q = s*kp + c*kq ;
+   }
+
+			// Put (a, column a) before (b, column b) if b is larger, without a branch.
+static inline void order(scalar& a, scalar& b, scalar& a0, scalar& b0,
+                         scalar& a1, scalar& b1, scalar& a2, scalar& b2) {
+   const bool swap = b > a ;
+   scalar t ;
+   t = a ;  a = swap ? b : a ;  b = swap ? t : b ;
+   t = a0 ; a0 = swap ? b0 : a0 ; b0 = swap ? t : b0 ;
+   t = a1 ; a1 = swap ? b1 : a1 ; b1 = swap ? t : b1 ;
+   t = a2 ; a2 = swap ? b2 : a2 ; b2 = swap ? t : b2 ;
+   }
+
+			// The nine entries of the eigenvector matrix, row by row.
+#define VECTORS v00, v01, v02, v10, v11, v12, v20, v21, v22
+
+/*------------------------------------------------------------
+ * A sweep is a rotation in each of the planes (0,1), (0,2) and
+ * (1,2); after the sweeps a sorting network orders the
+ * eigenvalues. All on named scalars, so the batch loop has a
+ * straight-line body and vectorizes.
+ */
+static inline void sweep(scalar& a00, scalar& a01, scalar& a02, scalar& a11, scalar& a12, scalar& a22,
+                         scalar& v00, scalar& v01, scalar& v02, scalar& v10, scalar& v11,
+                         scalar& v12, scalar& v20, scalar& v21, scalar& v22) {
+   rotate(a00, a11, a01, a02, a12, v00, v01, v10, v11, v20, v21) ;
+   rotate(a00, a22, a02, a01, a12, v00, v02, v10, v12, v20, v22) ;
+   rotate(a11, a22, a12, a01, a02, v01, v02, v11, v12, v21, v22) ;
+   }
+
+static inline void sort(scalar& a00, scalar& a11, scalar& a22,
+                        scalar& v00, scalar& v01, scalar& v02, scalar& v10, scalar& v11,
+                        scalar& v12, scalar& v20, scalar& v21, scalar& v22) {
+   order(a00, a11, v00, v01, v10, v11, v20, v21) ;
+   order(a11, a22, v01, v02, v11, v12, v21, v22) ;
+   order(a00, a11, v00, v01, v10, v11, v20, v21) ;
+   }
+
+/*------------------------------------------------------------
+ * One one-sided Jacobi rotation: turn columns ap and aq of A
+ * until they are orthogonal, and the same columns of V. The
+ * angle is that of rotate() for the 2x2 Gram matrix, in the
+ * same branch free form.
+ */
+static inline void rotate(Vector3& ap, Vector3& aq, Vector3& vp, Vector3& vq) {
+   const scalar alpha = ap.dot(ap), beta = aq.dot(aq), gamma = ap.dot(aq) ;
+   const scalar tau = beta - alpha ;
+   const scalar den = ABS(tau) + sqrt(tau*tau + 4*gamma*gamma) ;
+   const scalar t = copysign((scalar)2, tau)*gamma/(den + (den == 0)) ;
+   const scalar c = 1/sqrt(t*t + 1), s = t*c ;
+   const Vector3 a = ap, v = vp ;
+   ap = a*c - aq*s ;
+   aq = a*s + aq*c ;
+   vp = v*c - vq*s ;
+   vq = v*s + vq*c ;
+   }
+
+			// c ? a : b, a coordinate at a time (a select, where a whole vector would be a branch).
+static inline Vector3 select(bool c, Vector3 const& a, Vector3 const& b) {
+   return Vector3(c ? a.x : b.x, c ? a.y : b.y, c ? a.z : b.z) ;
+   }
+
+			// Put column a (length la) before column b if b is longer, without a branch.
+static inline void order(scalar& la, scalar& lb, Vector3& a, Vector3& b, Vector3& va, Vector3& vb) {
+   const bool swap = lb > la ;
+   const scalar l = la ;
+   const Vector3 c = a, v = va ;
+   la = swap ? lb : la ;  lb = swap ? l : lb ;
+   a = select(swap, b, a) ;    b = select(swap, c, b) ;
+   va = select(swap, vb, va) ; vb = select(swap, v, vb) ;
+   }
+
+#endif
@@ -0,0 +1,198 @@
+/* -------- KdTree.cpp -----------
+
+   Nearest Neighbour Search
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <algorithm>
+#include <KdTree.h>
+#include <Parallel.h>
+#include <Simd.h>
+
+			// Queries per parallel chunk.
+static const int GRAIN = 1024 ;
+
+/*------------------------------------------------------------
+ * Median split along the axis of greatest spread. The points
+ * are reordered in index, then copied out coordinate by
+ * coordinate once the tree is done.
+ */
+void KdTree::split(int node, int begin, int end) {
+   if (end - begin <= KD_LEAF) {
+      nodes[node].axis = -1 ;
+      nodes[node].child = begin ;
+      nodes[node].count = end - begin ;
+      return ;
+      }
+
+   scalar lo[3] = { HUGE_VAL, HUGE_VAL, HUGE_VAL }, hi[3] = { -HUGE_VAL, -HUGE_VAL, -HUGE_VAL } ;
+   for (int i = begin ; i < end ; i++) {
+      const scalar c[3] = { x[index[i]], y[index[i]], z[index[i]] } ;
+      for (int a = 0 ; a < 3 ; a++) {
+         lo[a] = MIN(lo[a], c[a]) ;
+         hi[a] = MAX(hi[a], c[a]) ;
+         }
+      }
+   const scalar e[3] = { hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2] } ;
+   const int axis = (e[0] >= e[1] && e[0] >= e[2]) ? 0 : (e[1] >= e[2]) ? 1 : 2 ;
+   std::vector<scalar> const& coord = (axis == 0) ? x : (axis == 1) ? y : z ;
+
+   const int mid = begin + (end - begin)/2 ;
+   std::nth_element(index.begin() + begin, index.begin() + mid, index.begin() + end,
+                    [&coord](int a, int b) { return coord[a] < coord[b] ; }) ;
+
+   const int child = (int)nodes.size() ;
+   nodes.resize(child + 2) ;
+   nodes[node].split = coord[index[mid]] ;
+   nodes[node].axis = axis ;
+   nodes[node].child = child ;
+   nodes[node].count = 0 ;
+   split(child, begin, mid) ;
+   split(child + 1, mid, end) ;
+   }
+
+void KdTree::build(Position const* points, int n) {
+   nodes.clear() ;
+   index.resize(n) ;
+   slot.resize(n) ;
+   x.resize(n) ;
+   y.resize(n) ;
+   z.resize(n) ;
+   if (n <= 0)
+      return ;
+   for (int i = 0 ; i < n ; i++) {
+      index[i] = i ;
+      x[i] = points[i].x ;
+      y[i] = points[i].y ;
+      z[i] = points[i].z ;
+      }
+   nodes.resize(1) ;
+   split(0, 0, n) ;
+
+   for (int i = 0 ; i < n ; i++) {
+      x[i] = points[index[i]].x ;
+      y[i] = points[index[i]].y ;
+      z[i] = points[index[i]].z ;
+      slot[index[i]] = i ;
+      }
+   }
+
+/** -----------------------------------------------------------
+ * Depth first, the side of the split holding q first. A subtree
+ * is skipped when the distance from q to its splitting plane is
+ * already beyond the best found; each stack entry carries that
+ * squared distance.
+ **/
+int KdTree::nearest(Position const& q, scalar& dist2, scalar maxDist2) const {
+   dist2 = maxDist2 ;
+   int best = -1 ;
+   if (nodes.empty())
+      return -1 ;
+
+   int stack[MAX_DEPTH] ;
+   scalar bound[MAX_DEPTH] ;
+   int top = 0 ;
+   stack[top] = 0 ;
+   bound[top++] = 0 ;
+   scalar d[KD_LEAF] ;
+
+   while (top) {
+      top-- ;
+      if (bound[top] >= dist2)
+         continue ;
+      Node const& n = nodes[stack[top]] ;
+      if (n.axis < 0) {
+         const int b = n.child, m = n.count ;
+         SIMD_LOOP
+         for (int k = 0 ; k < m ; k++) {
+            const scalar dx = x[b + k] - q.x, dy = y[b + k] - q.y, dz = z[b + k] - q.z ;
+            d[k] = dx*dx + dy*dy + dz*dz ;
+            }
+         for (int k = 0 ; k < m ; k++)
+            if (d[k] < dist2) {
+               dist2 = d[k] ;
+               best = b + k ;
+               }
+         continue ;
+         }
+      const scalar diff = (&q.x)[n.axis] - n.split ;
+      const int nearSide = n.child + (diff >= 0) ;
+      const int farSide = n.child + (diff < 0) ;
+      stack[top] = farSide ;
+      bound[top++] = diff*diff ;
+      stack[top] = nearSide ;
+      bound[top++] = 0 ;
+      }
+   return (best < 0) ? -1 : index[best] ;
+   }
+
+/** -----------------------------------------------------------
+ * As above, with the k best kept sorted by insertion; the bound
+ * to beat is the k-th distance once k are found.
+ **/
+int KdTree::nearest(Position const& q, int k, int* indices, scalar* dist2,
+                    scalar maxDist2) const {
+   if (nodes.empty() || k <= 0)
+      return 0 ;
+
+   int found = 0 ;
+   int stack[MAX_DEPTH] ;
+   scalar bound[MAX_DEPTH] ;
+   int top = 0 ;
+   stack[top] = 0 ;
+   bound[top++] = 0 ;
+   scalar d[KD_LEAF] ;
+
+   while (top) {
+      top-- ;
+      const scalar limit = (found == k) ? dist2[k - 1] : maxDist2 ;
+      if (bound[top] >= limit)
+         continue ;
+      Node const& n = nodes[stack[top]] ;
+      if (n.axis < 0) {
+         const int b = n.child, m = n.count ;
+         SIMD_LOOP
+         for (int j = 0 ; j < m ; j++) {
+            const scalar dx = x[b + j] - q.x, dy = y[b + j] - q.y, dz = z[b + j] - q.z ;
+            d[j] = dx*dx + dy*dy + dz*dz ;
+            }
+         for (int j = 0 ; j < m ; j++) {
+            const scalar worst = (found == k) ? dist2[k - 1] : maxDist2 ;
+            if (!(d[j] < worst))
+               continue ;
+            int i = (found < k) ? found++ : k - 1 ;
+            for ( ; i > 0 && dist2[i - 1] > d[j] ; i--) {
+               dist2[i] = dist2[i - 1] ;
+               indices[i] = indices[i - 1] ;
+               }
+            dist2[i] = d[j] ;
+            indices[i] = b + j ;
+            }
+         continue ;
+         }
+      const scalar diff = (&q.x)[n.axis] - n.split ;
+      stack[top] = n.child + (diff < 0) ;
+      bound[top++] = diff*diff ;
+      stack[top] = n.child + (diff >= 0) ;
+      bound[top++] = 0 ;
+      }
+   for (int i = 0 ; i < found ; i++)
+      indices[i] = index[indices[i]] ;
+   return found ;
+   }
+
+void KdTree::nearestBatch(Position const* queries, int n, int* indices, scalar* dist2,
+                          scalar maxDist2) const {
+   parallelFor(n, GRAIN, [&](int begin, int end) {
+      for (int i = begin ; i < end ; i++)
+         indices[i] = nearest(queries[i], dist2[i], maxDist2) ;
+      }) ;
+   }
@@ -0,0 +1,286 @@
+/* -------- Matrix3.cpp -----------
+
+   3x3 Matrix
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <chrono>
+#include <vector>
+#include <Matrix3.h>
+#include <Sampling.h>
+#include <Dispatch.h>
+#include "Jacobi.h"
+
+			// Sweep limit of the scalar decompositions (they stop on convergence).
+static const int MAX_SWEEPS = 32 ;
+
+bool Matrix3::solveLU(Vector3 const& b, Vector3& x) const {
+   scalar a[3][3], y[3] = { b.x, b.y, b.z } ;
+   for (int r = 0 ; r < 3 ; r++)
+      for (int c = 0 ; c < 3 ; c++)
+         a[r][c] = m[r][c] ;
+
+   for (int k = 0 ; k < 3 ; k++) {
+      int p = k ;
+      for (int r = k + 1 ; r < 3 ; r++)
+         if (ABS(a[r][k]) > ABS(a[p][k]))
+            p = r ;
+      if (a[p][k] == 0)
+         return false ;
+      if (p != k) {
+         for (int c = 0 ; c < 3 ; c++) {
+            const scalar t = a[k][c] ; a[k][c] = a[p][c] ; a[p][c] = t ;
+            }
+         const scalar t = y[k] ; y[k] = y[p] ; y[p] = t ;
+         }
+      for (int r = k + 1 ; r < 3 ; r++) {
+         const scalar f = a[r][k]/a[k][k] ;
+         for (int c = k + 1 ; c < 3 ; c++)
+            a[r][c] -= f*a[k][c] ;
+         y[r] -= f*y[k] ;
+         }
+      }
+   for (int r = 2 ; r >= 0 ; r--) {
+      for (int c = r + 1 ; c < 3 ; c++)
+         y[r] -= a[r][c]*y[c] ;
+      y[r] /= a[r][r] ;
+      }
+   x = Vector3(y[0], y[1], y[2]) ;
+   return true ;
+   }
+
+void Matrix3::eigen(Vector3& values, Matrix3& vectors) const {
+   scalar a00 = m[0][0], a01 = m[0][1], a02 = m[0][2], a11 = m[1][1], a12 = m[1][2], a22 = m[2][2] ;
+   scalar v00 = 1, v01 = 0, v02 = 0, v10 = 0, v11 = 1, v12 = 0, v20 = 0, v21 = 0, v22 = 1 ;
+   for (int i = 0 ; i < MAX_SWEEPS ; i++) {
+      const scalar off = a01*a01 + a02*a02 + a12*a12 ;
+      if (off <= 1e-36*(a00*a00 + a11*a11 + a22*a22) || off == 0)
+         break ;
+      sweep(a00, a01, a02, a11, a12, a22, VECTORS) ;
+      }
+   sort(a00, a11, a22, VECTORS) ;
+   values = Vector3(a00, a11, a22) ;
+   vectors = Matrix3(Vector3(v00, v01, v02), Vector3(v10, v11, v12), Vector3(v20, v21, v22)) ;
+   }
+
+/*------------------------------------------------------------
+ * One-sided Jacobi (Hestenes): rotate pairs of columns of A
+ * until they are orthogonal, applying the same rotations to V.
+ * Then A V = U diag(s) with s the column lengths. Columns of
+ * length 0 leave U to be completed by cross products.
+ */
+void Matrix3::svd(Matrix3& u, Vector3& s, Matrix3& v) const {
+   Vector3 a[3] = { col(0), col(1), col(2) } ;
+   Vector3 w[3] = { Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1) } ;
+   for (int sweep = 0 ; sweep < MAX_SWEEPS ; sweep++) {
+      bool rotated = false ;
+      for (int p = 0 ; p < 2 ; p++)
+         for (int q = p + 1 ; q < 3 ; q++) {
+            const scalar alpha = a[p].dot(a[p]), beta = a[q].dot(a[q]), gamma = a[p].dot(a[q]) ;
+            if (ABS(gamma) <= 1e-15*sqrt(alpha*beta) || gamma == 0)
+               continue ;
+            rotated = true ;
+            const scalar zeta = (beta - alpha)/(2*gamma) ;
+            const scalar t = ((zeta >= 0) ? 1 : -1)/(ABS(zeta) + sqrt(zeta*zeta + 1)) ;
+            const scalar c = 1/sqrt(t*t + 1), sn = t*c ;
+            const Vector3 ap = a[p], wp = w[p] ;
+            a[p] = ap*c - a[q]*sn ;
+            a[q] = ap*sn + a[q]*c ;
+            w[p] = wp*c - w[q]*sn ;
+            w[q] = wp*sn + w[q]*c ;
+            }
+      if (!rotated)
+         break ;
+      }
+
+   scalar l[3] = { a[0].len(), a[1].len(), a[2].len() } ;
+   int k[3] = { 0, 1, 2 } ;
+   for (int i = 0 ; i < 2 ; i++)
+      for (int j = i + 1 ; j < 3 ; j++)
+         if (l[k[j]] > l[k[i]]) {
+            const int t = k[i] ; k[i] = k[j] ; k[j] = t ;
+            }
+
+   Vector3 c[3] ;
+   const scalar tiny = 1e-15*l[k[0]] ;
+   for (int i = 0 ; i < 3 ; i++)
+      c[i] = (l[k[i]] > tiny) ? a[k[i]]*(1/l[k[i]]) : Vector3() ;
+   if (l[k[0]] <= tiny)
+      c[0] = Vector3(1, 0, 0) ;
+   if (l[k[1]] <= tiny) {
+      const Vector3 e = (ABS(c[0].x) < .9) ? Vector3(1, 0, 0) : Vector3(0, 1, 0) ;
+      c[1] = c[0].cross(e) ;
+      c[1] = c[1]*(1/c[1].len()) ;
+      }
+   if (l[k[2]] <= tiny)
+      c[2] = c[0].cross(c[1]) ;
+
+   s = Vector3(l[k[0]], l[k[1]], l[k[2]]) ;
+   u = Matrix3(c[0], c[1], c[2]).transpose() ;
+   v = Matrix3(w[k[0]], w[k[1]], w[k[2]]).transpose() ;
+   }
+
+/*------------------------------------------------------------
+ * The batch decompositions are in DispatchKernels.h, one copy
+ * per instruction set.
+ */
+
+void eigenBatch(Matrix3SoA const& a, Vector3SoA const& values,
+                Matrix3SoA const& vectors, int n) {
+   kernels().eigen(a, values, vectors, n) ;
+   }
+
+void svdBatch(Matrix3SoA const& a, Matrix3SoA const& u, Vector3SoA const& s,
+              Matrix3SoA const& v, int n) {
+   kernels().svd(a, u, s, v, n) ;
+   }
+
+void solveBatch(Matrix3SoA const& a, Vector3SoA const& b,
+                Vector3SoA const& x, int n) {
+   scalar* RESTRICT ox = x.x ;
+   scalar* RESTRICT oy = x.y ;
+   scalar* RESTRICT oz = x.z ;
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar a00 = a.m[0][0][i], a01 = a.m[0][1][i], a02 = a.m[0][2][i] ;
+      const scalar a10 = a.m[1][0][i], a11 = a.m[1][1][i], a12 = a.m[1][2][i] ;
+      const scalar a20 = a.m[2][0][i], a21 = a.m[2][1][i], a22 = a.m[2][2][i] ;
+      const scalar bx = b.x[i], by = b.y[i], bz = b.z[i] ;
+      // det(b, c1, c2), det(c0, b, c2), det(c0, c1, b) over det(c0, c1, c2), columns c
+      const scalar c0 = a11*a22 - a12*a21, c1 = a02*a21 - a01*a22, c2 = a01*a12 - a02*a11 ;
+      const scalar d = a00*c0 + a10*c1 + a20*c2 ;
+      const scalar r = (d != 0) ? 1/d : 0 ;
+      const scalar y0 = by*a22 - a12*bz, y1 = a02*bz - bx*a22, y2 = bx*a12 - a02*by ;
+      const scalar z0 = a11*bz - by*a21, z1 = a21*bx - a01*bz, z2 = a01*by - a11*bx ;
+      ox[i] = (bx*c0 + by*c1 + bz*c2)*r ;
+      oy[i] = (a00*y0 + a10*y1 + a20*y2)*r ;
+      oz[i] = (a00*z0 + a10*z1 + a20*z2)*r ;
+      }
+   }
+
+			// Largest |A v - l v| over the eigenpairs, relative to the largest |l|.
+static scalar eigenError(Matrix3 const& a, Vector3 const& l, Matrix3 const& v) {
+   const scalar norm = MAX(ABS(l.x), MAX(ABS(l.y), ABS(l.z))) ;
+   const scalar lk[3] = { l.x, l.y, l.z } ;
+   scalar e = 0 ;
+   for (int k = 0 ; k < 3 ; k++)
+      e = MAX(e, (a*v.col(k) - v.col(k)*lk[k]).len()) ;
+   return (norm > 0) ? e/norm : e ;
+   }
+
+static void print(FILE* out, char const* what, int n, double sec, scalar error) {
+   fprintf(out, "matrix3 %-14s %9d matrices %8.1f ms %7.2f Mmatrices/s  error %.2g\n",
+           what, n, 1e3*sec, n*1e-6/sec, error) ;
+   }
+
+/*------------------------------------------------------------
+ * Random symmetric matrices for the eigen problem and the SVD,
+ * random diagonally dominant (well-conditioned) ones for the
+ * solves. Errors are residuals relative to the matrix size.
+ */
+void matrix3Benchmark(int n, FILE* out) {
+   RandomStream rng(11) ;
+   std::vector<scalar> u(12*n) ;
+   rng.uniform(&u[0], 12*n) ;
+   std::vector<scalar> sym(9*n), gen(9*n), vecs(9*n), vals(3*n), rhs(3*n), sol(3*n) ;
+   Matrix3SoA s(&sym[0], n), g(&gen[0], n), v(&vecs[0], n) ;
+   Vector3SoA l(&vals[0], &vals[n], &vals[2*n]) ;
+   Vector3SoA b(&rhs[0], &rhs[n], &rhs[2*n]), x(&sol[0], &sol[n], &sol[2*n]) ;
+   for (int i = 0 ; i < n ; i++) {
+      for (int r = 0 ; r < 3 ; r++)
+         for (int c = 0 ; c < 3 ; c++) {
+            g.m[r][c][i] = 2*u[(3*r + c)*n + i] - 1 + ((r == c) ? 3 : 0) ;
+            s.m[r][c][i] = s.m[c][r][i] = 2*u[(3*MIN(r, c) + MAX(r, c))*n + i] - 1 ;
+            }
+      b.set(i, 2*u[9*n + i] - 1, 2*u[10*n + i] - 1, 2*u[11*n + i] - 1) ;
+      }
+
+   auto time = [](auto body) {
+      auto t0 = std::chrono::steady_clock::now() ;
+      body() ;
+      return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count() ;
+      } ;
+   scalar error ;
+   double sec ;
+
+   sec = time([&] {
+      for (int i = 0 ; i < n ; i++) {
+         Vector3 li ;
+         Matrix3 vi ;
+         s.matrix(i).eigen(li, vi) ;
+         l.set(i, li) ;
+         v.set(i, vi) ;
+         }
+      }) ;
+   error = 0 ;
+   for (int i = 0 ; i < n ; i++)
+      error = MAX(error, eigenError(s.matrix(i), l.vector(i), v.matrix(i))) ;
+   print(out, "eigen", n, sec, error) ;
+
+   sec = time([&] { eigenBatch(s, l, v, n) ; }) ;
+   error = 0 ;
+   for (int i = 0 ; i < n ; i++)
+      error = MAX(error, eigenError(s.matrix(i), l.vector(i), v.matrix(i))) ;
+   print(out, "eigenBatch", n, sec, error) ;
+
+   std::vector<Matrix3> us(n), vs(n) ;
+   std::vector<Vector3> ss(n) ;
+   sec = time([&] {
+      for (int i = 0 ; i < n ; i++)
+         g.matrix(i).svd(us[i], ss[i], vs[i]) ;
+      }) ;
+   error = 0 ;
+   for (int i = 0 ; i < n ; i++) {
+      const Matrix3 d(Vector3(ss[i].x, 0, 0), Vector3(0, ss[i].y, 0), Vector3(0, 0, ss[i].z)) ;
+      const Matrix3 e = us[i]*d*vs[i].transpose() - g.matrix(i) ;
+      for (int r = 0 ; r < 3 ; r++)
+         error = MAX(error, e.row(r).len()/ss[i].x) ;
+      }
+   print(out, "svd", n, sec, error) ;
+
+   std::vector<scalar> us9(9*n), vs9(9*n), ss3(3*n) ;
+   const Matrix3SoA ub(&us9[0], n), vb(&vs9[0], n) ;
+   const Vector3SoA sb(&ss3[0], &ss3[n], &ss3[2*n]) ;
+   sec = time([&] { svdBatch(g, ub, sb, vb, n) ; }) ;
+   error = 0 ;
+   for (int i = 0 ; i < n ; i++) {
+      const Vector3 si = sb.vector(i) ;
+      const Matrix3 d(Vector3(si.x, 0, 0), Vector3(0, si.y, 0), Vector3(0, 0, si.z)) ;
+      const Matrix3 e = ub.matrix(i)*d*vb.matrix(i).transpose() - g.matrix(i) ;
+      for (int r = 0 ; r < 3 ; r++)
+         error = MAX(error, e.row(r).len()/si.x) ;
+      }
+   print(out, "svdBatch", n, sec, error) ;
+
+   auto residual = [&] {
+      scalar e = 0 ;
+      for (int i = 0 ; i < n ; i++)
+         e = MAX(e, (g.matrix(i)*x.vector(i) - b.vector(i)).len()) ;
+      return e ;
+      } ;
+   sec = time([&] {
+      for (int i = 0 ; i < n ; i++)
+         x.set(i, g.matrix(i).solve(b.vector(i))) ;
+      }) ;
+   print(out, "solve", n, sec, residual()) ;
+
+   sec = time([&] {
+      for (int i = 0 ; i < n ; i++) {
+         Vector3 xi ;
+         g.matrix(i).solveLU(b.vector(i), xi) ;
+         x.set(i, xi) ;
+         }
+      }) ;
+   print(out, "solveLU", n, sec, residual()) ;
+
+   sec = time([&] { solveBatch(g, b, x, n) ; }) ;
+   print(out, "solveBatch", n, sec, residual()) ;
+   }
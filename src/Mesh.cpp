@@ -0,0 +1,311 @@
+/* -------- Mesh.cpp -----------
+
+   Triangle Mesh
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <algorithm>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <Mesh.h>
+
+TriangleMesh::TriangleMesh() :
+   nTriangles(0), nPacks(0), packs(0), memory(0) { }
+
+TriangleMesh::TriangleMesh(Position const* vertices, int const* indices,
+                           int n) :
+   nTriangles(0), nPacks(0), packs(0), memory(0) {
+   build(vertices, indices, n) ;
+   }
+
+TriangleMesh::~TriangleMesh() {
+   free(memory) ;
+   }
+
+/*------------------------------------------------------------
+ * The rows of the world to unit triangle map. In row vector
+ * form a point of the triangle's space is
+ *
+ *    p = [u v w 1] * | e1 |        e1 = v1 - v0
+ *                    | e2 |        e2 = v2 - v0
+ *                    | n  |        n  = e1 x e2
+ *                    | v0 |
+ *
+ * and [u v w 1] = [p 1] * inverse; u, v and w are the columns
+ * of the inverse.
+ */
+static void unitMap(Position const& v0, Position const& v1,
+                    Position const& v2, scalar m[12]) {
+   const Vector3 e1 = v1 - v0 ;
+   const Vector3 e2 = v2 - v0 ;
+   const Vector3 n = e1.cross(e2) ;
+
+   if (n.dot(n) == 0) {                 // degenerate: w and Dw are 0, t is NaN
+      for (int i = 0 ; i < 12 ; i++)
+         m[i] = 0 ;
+      return ;
+      }
+   const Transform inv = Transform(e1, e2, n, Vector(v0)).inverse() ;
+   for (int r = 0 ; r < 3 ; r++)
+      for (int c = 0 ; c < 4 ; c++)
+         m[4*r + c] = inv.xform[c][r] ;
+   }
+
+/*------------------------------------------------------------
+ * Median split on the longest axis of the centroids, with the
+ * left half rounded up to whole packs so that the leaves are
+ * full.
+ */
+class MeshBuilder {
+   public:
+      Position const*                 vertices ;
+      int const*                      indices ;
+      std::vector<int>                order ;
+      std::vector<Position>           centroid ;
+      std::vector<TriangleMesh::Node>& nodes ;
+      std::vector<TriangleMesh::Pack>  packs ;
+
+      MeshBuilder(std::vector<TriangleMesh::Node>& n) : nodes(n) { }
+
+      Bounds bound(int begin, int end) const {
+         Bounds b ;
+         for (int i = begin ; i < end ; i++)
+            for (int k = 0 ; k < 3 ; k++)
+               b.extend(vertices[indices[3*order[i] + k]]) ;
+         return b ;
+         }
+
+      void split(int index, int begin, int end) {
+         TriangleMesh::Node& node = nodes[index] ;
+         node.box = bound(begin, end) ;
+         node.axis = 0 ;
+
+         if (end - begin <= TRIANGLE_PACK) {
+            TriangleMesh::Pack p ;
+            for (int k = 0 ; k < TRIANGLE_PACK ; k++) {
+               scalar m[12] = { 0 } ;
+               p.id[k] = -1 ;
+               if (begin + k < end) {
+                  int const* t = indices + 3*order[begin + k] ;
+                  unitMap(vertices[t[0]], vertices[t[1]], vertices[t[2]], m) ;
+                  p.id[k] = order[begin + k] ;
+                  }
+               for (int r = 0 ; r < 12 ; r++)
+                  p.m[r][k] = m[r] ;
+               }
+            node.child = (int)packs.size() ;
+            node.count = end - begin ;
+            packs.push_back(p) ;
+            return ;
+            }
+
+         Bounds c ;
+         for (int i = begin ; i < end ; i++)
+            c.extend(centroid[order[i]]) ;
+         const Vector3 e = c.extent() ;
+         const int axis = (e.x >= e.y && e.x >= e.z) ? 0 : (e.y >= e.z) ? 1 : 2 ;
+         const int half = (end - begin)/2 ;
+         const int mid = begin + (half + TRIANGLE_PACK - 1)/TRIANGLE_PACK*TRIANGLE_PACK ;
+         std::vector<Position> const& cen = centroid ;
+         std::nth_element(order.begin() + begin, order.begin() + mid, order.begin() + end,
+                          [&cen, axis](int a, int b) {
+                             return (&cen[a].x)[axis] < (&cen[b].x)[axis] ; }) ;
+
+         const int child = (int)nodes.size() ;
+         nodes.resize(child + 2) ;            // invalidates node
+         nodes[index].child = child ;
+         nodes[index].count = 0 ;
+         nodes[index].axis = axis ;
+         split(child, begin, mid) ;
+         split(child + 1, mid, end) ;
+         }
+   } ;
+
+void TriangleMesh::build(Position const* vertices, int const* indices, int n) {
+   free(memory) ;
+   memory = 0 ;
+   packs = 0 ;
+   nodes.clear() ;
+   nTriangles = n ;
+   nPacks = 0 ;
+   if (n <= 0)
+      return ;
+
+   MeshBuilder b(nodes) ;
+   b.vertices = vertices ;
+   b.indices = indices ;
+   b.order.resize(n) ;
+   b.centroid.resize(n) ;
+   for (int i = 0 ; i < n ; i++) {
+      Position const& v0 = vertices[indices[3*i]] ;
+      b.order[i] = i ;
+      b.centroid[i] = v0 + ((vertices[indices[3*i+1]] - v0) + (vertices[indices[3*i+2]] - v0))/3 ;
+      }
+   nodes.resize(1) ;
+   b.split(0, 0, n) ;
+
+   nPacks = (int)b.packs.size() ;
+   memory = malloc(nPacks*sizeof(Pack) + SIMD_ALIGN) ;
+   if (!memory)
+      throw std::bad_alloc() ;
+   packs = (Pack*)(((uintptr_t)memory + SIMD_ALIGN - 1) & ~(uintptr_t)(SIMD_ALIGN - 1)) ;
+   memcpy(packs, &b.packs[0], nPacks*sizeof(Pack)) ;
+   }
+
+Bounds TriangleMesh::bounds() const {
+   return nodes.empty() ? Bounds() : nodes[0].box ;
+   }
+
+/*------------------------------------------------------------
+ * The distance to each triangle of a pack, HUGE_VAL where the
+ * ray misses it or the distance is not in (tmin, tmax). One lane
+ * per triangle, no branches.
+ */
+static inline void distances(TriangleMesh::Pack const& p, Ray const& ray,
+                             scalar tmax, scalar t[TRIANGLE_PACK],
+                             scalar u[TRIANGLE_PACK], scalar v[TRIANGLE_PACK]) {
+   const scalar ox = ray.origin.x, oy = ray.origin.y, oz = ray.origin.z ;
+   const scalar dx = ray.direction.x, dy = ray.direction.y, dz = ray.direction.z ;
+   const scalar tmin = ray.tmin ;
+
+   SIMD_LOOP
+   for (int k = 0 ; k < TRIANGLE_PACK ; k++) {
+      const scalar ow = p.m[8][k]*ox + p.m[9][k]*oy + p.m[10][k]*oz + p.m[11][k] ;
+      const scalar dw = p.m[8][k]*dx + p.m[9][k]*dy + p.m[10][k]*dz ;
+      const scalar tk = -ow/dw ;
+      const scalar uk = p.m[0][k]*ox + p.m[1][k]*oy + p.m[2][k]*oz + p.m[3][k]
+                   + tk*(p.m[0][k]*dx + p.m[1][k]*dy + p.m[2][k]*dz) ;
+      const scalar vk = p.m[4][k]*ox + p.m[5][k]*oy + p.m[6][k]*oz + p.m[7][k]
+                   + tk*(p.m[4][k]*dx + p.m[5][k]*dy + p.m[6][k]*dz) ;
+      const bool inside = tk > tmin && tk < tmax && uk >= 0 && vk >= 0 && uk + vk <= 1 ;
+      t[k] = inside ? tk : HUGE_VAL ;
+      u[k] = uk ;
+      v[k] = vk ;
+      }
+   }
+
+bool TriangleMesh::intersect(Pack const& p, Ray const& ray, Hit& hit) {
+   scalar t[TRIANGLE_PACK], u[TRIANGLE_PACK], v[TRIANGLE_PACK] ;
+   distances(p, ray, hit.t, t, u, v) ;
+
+   int best = -1 ;
+   for (int k = 0 ; k < TRIANGLE_PACK ; k++)
+      if (t[k] < hit.t) {
+         hit.t = t[k] ;
+         best = k ;
+         }
+   if (best < 0)
+      return false ;
+   hit.u = u[best] ;
+   hit.v = v[best] ;
+   hit.triangle = p.id[best] ;
+   return true ;
+   }
+
+bool TriangleMesh::occluded(Pack const& p, Ray const& ray) {
+   scalar t[TRIANGLE_PACK], u[TRIANGLE_PACK], v[TRIANGLE_PACK] ;
+   distances(p, ray, ray.tmax, t, u, v) ;
+
+   bool any = false ;
+   for (int k = 0 ; k < TRIANGLE_PACK ; k++)
+      any |= (t[k] < HUGE_VAL) ;
+   return any ;
+   }
+
+/** -----------------------------------------------------------
+ * Depth first traversal, nearer child first, skipping nodes
+ * beyond the closest hit so far.
+ **/
+bool TriangleMesh::intersect(Ray const& ray, Hit& hit) const {
+   hit = Hit() ;
+   hit.t = ray.tmax ;
+   if (nodes.empty())
+      return false ;
+
+   const Vector3 invDir(1/ray.direction.x, 1/ray.direction.y, 1/ray.direction.z) ;
+   int stack[64], top = 0 ;
+   stack[top++] = 0 ;
+   while (top) {
+      Node const& n = nodes[stack[--top]] ;
+      if (!n.box.intersect(ray.origin, invDir, ray.tmin, hit.t))
+         continue ;
+      if (n.count) {
+         intersect(packs[n.child], ray, hit) ;
+         continue ;
+         }
+      const bool negative = (&invDir.x)[n.axis] < 0 ;
+      stack[top++] = n.child + !negative ;      // far child
+      stack[top++] = n.child + negative ;       // near child, popped first
+      }
+   if (!hit.hit())
+      hit.t = HUGE_VAL ;
+   return hit.hit() ;
+   }
+
+bool TriangleMesh::occluded(Ray const& ray) const {
+   if (nodes.empty())
+      return false ;
+
+   const Vector3 invDir(1/ray.direction.x, 1/ray.direction.y, 1/ray.direction.z) ;
+   int stack[64], top = 0 ;
+   stack[top++] = 0 ;
+   while (top) {
+      Node const& n = nodes[stack[--top]] ;
+      if (!n.box.intersect(ray.origin, invDir, ray.tmin, ray.tmax))
+         continue ;
+      if (n.count) {
+         if (occluded(packs[n.child], ray))
+            return true ;
+         continue ;
+         }
+      stack[top++] = n.child ;
+      stack[top++] = n.child + 1 ;
+      }
+   return false ;
+   }
+
+/** -----------------------------------------------------------
+ * Packet traversal, shared by the closest hit (hits) and any
+ * hit (blocked) queries: RayPacket::traverse(), with each leaf's
+ * pack tested against the rays still in it.
+ **/
+void TriangleMesh::tracePacket(Ray const* rays, Hit* hits, bool* blocked,
+                               int n, PacketStats* stats) const {
+   RayPacket pk(rays, n, hits, blocked, stats) ;
+   pk.traverse(nodes.data(), (int)nodes.size(), stats, [&](Node const& node) {
+      Pack const& p = packs[node.child] ;
+      for (int k = 0 ; k < n ; k++) {
+         if (!pk.in[k])
+            continue ;
+         if (hits) {
+            intersect(p, rays[k], hits[k]) ;
+            pk.t1[k] = hits[k].t ;
+            }
+         else if (occluded(p, rays[k])) {
+            blocked[k] = true ;
+            pk.live[k] = false ;
+            }
+         }
+      }) ;
+   if (hits)
+      pk.finish(hits) ;
+   }
+
+void TriangleMesh::intersectPacket(Ray const* rays, Hit* hits, int n,
+                                   PacketStats* stats) const {
+   tracePacket(rays, hits, 0, n, stats) ;
+   }
+
+void TriangleMesh::occludedPacket(Ray const* rays, bool* blocked, int n,
+                                  PacketStats* stats) const {
+   tracePacket(rays, 0, blocked, n, stats) ;
+   }
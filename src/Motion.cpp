@@ -0,0 +1,125 @@
+/* -------- Motion.cpp -----------
+
+   Motion Blur Transform
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <Motion.h>
+
+			// Times per batch.
+static const int CHUNK = 256 ;
+			// Most steps motionBounds() takes.
+static const int MAX_STEPS = 256 ;
+			// Most rotation (radians) per half step of motionBounds().
+static const scalar STEP_ANGLE = 1./64 ;
+
+AnimatedTransform::AnimatedTransform(Transform const& mx)
+   : start(mx), end(mx), startParts(mx), endParts(startParts),
+     startTime(0), endTime(0), animated(false) {
+   }
+
+AnimatedTransform::AnimatedTransform(Transform const& mx0, scalar t0,
+                                     Transform const& mx1, scalar t1)
+   : start(mx0), end(mx1), startParts(mx0), endParts(mx1),
+     startTime(t0), endTime(t1), animated(false) {
+   for (int r = 0 ; r < 4 ; r++)
+      for (int c = 0 ; c < 4 ; c++)
+         if (mx0.xform[r][c] != mx1.xform[r][c])
+            animated = true ;
+   }
+
+			// time as 0 at the start to 1 at the end, clamped.
+scalar AnimatedTransform::fraction(scalar time) const {
+   if (!(time > startTime))
+      return 0 ;
+   if (!(time < endTime))
+      return 1 ;
+   return (time - startTime)/(endTime - startTime) ;
+   }
+
+Transform AnimatedTransform::at(scalar time) const {
+   if (!animated)
+      return start ;
+   const scalar f = fraction(time) ;
+   if (f == 0)
+      return start ;
+   if (f == 1)
+      return end ;
+   return interpolate(startParts, endParts, f).transform() ;
+   }
+
+void AnimatedTransform::at(scalar const* times, Transform* out, int n) const {
+   if (!animated) {
+      for (int i = 0 ; i < n ; i++)
+         out[i] = start ;
+      return ;
+      }
+   scalar f[CHUNK] ;
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      for (int j = 0 ; j < m ; j++)
+         f[j] = fraction(times[i0 + j]) ;
+      interpolateBatch(startParts, endParts, f, out + i0, m) ;
+      }
+   }
+
+/** -----------------------------------------------------------
+ * A point c of b is at c S(f) R(f) + T(f) at fraction f, S the
+ * scale times the w scale. Linear motion (no turn, fixed w) is
+ * spanned by the two end boxes. Otherwise the box is placed at
+ * the middle f of each of K steps, and each placement padded by
+ * how far a point of b can get in half a step:
+ *
+ *    |c| |dS| + |c| max|S| (angle turned) + |dT|
+ *
+ * with K picked so that the angle is small.
+ **/
+Bounds AnimatedTransform::motionBounds(Bounds const& b) const {
+   if (!animated || b.empty())
+      return b.transform(start) ;
+
+   Decomposition const& p0 = startParts ;
+   Decomposition const& p1 = endParts ;
+   const scalar c = MIN(ABS(p0.rotation.dot(p1.rotation)), 1.) ;
+   const scalar turn = 2*acos(c) ;
+   if (turn < EPSILON && p0.scale.w == p1.scale.w) {
+      Bounds swept = b.transform(start) ;
+      return swept.extend(b.transform(end)) ;
+      }
+
+   const int steps = MIN(MAX(1, (int)ceil(turn/(2*STEP_ANGLE))), MAX_STEPS) ;
+   const scalar h = .5/steps ;
+
+   const Vector3 far(MAX(ABS(b.lo.x), ABS(b.hi.x)),
+                     MAX(ABS(b.lo.y), ABS(b.hi.y)),
+                     MAX(ABS(b.lo.z), ABS(b.hi.z))) ;
+   const scalar radius = far.len() ;
+   const scalar w = MAX(ABS(p0.scale.w), ABS(p1.scale.w)) ;
+   const scalar dw = ABS(p1.scale.w - p0.scale.w) ;
+   const scalar s0[3] = { p0.scale.x, p0.scale.y, p0.scale.z } ;
+   const scalar s1[3] = { p1.scale.x, p1.scale.y, p1.scale.z } ;
+   scalar smax = 0, ds = 0 ;
+   for (int k = 0 ; k < 3 ; k++) {
+      const scalar s = MAX(ABS(s0[k]), ABS(s1[k])) ;
+      smax = MAX(smax, w*s) ;
+      ds = MAX(ds, dw*s + w*ABS(s1[k] - s0[k])) ;
+      }
+   const scalar pad = h*(radius*ds + radius*smax*turn + (p1.translation - p0.translation).len()) ;
+
+   Bounds swept ;
+   for (int k = 0 ; k < steps ; k++) {
+      const Bounds placed = b.transform(interpolate(p0, p1, (2*k + 1)*h).transform()) ;
+      swept.extend(placed) ;
+      }
+   swept.lo -= Vector3(pad, pad, pad) ;
+   swept.hi += Vector3(pad, pad, pad) ;
+   return swept ;
+   }
@@ -0,0 +1,125 @@
+/* -------- Normals.cpp -----------
+
+   Point Cloud Normal Estimation
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <Normals.h>
+#include <Matrix3.h>
+#include <Parallel.h>
+
+			// Points per eigenBatch() call.
+static const int CHUNK = 256 ;
+			// Points per parallel chunk.
+static const int GRAIN = 1024 ;
+
+			// Partial sums per reduction: one SIMD lane each.
+static const int LANES = 8 ;
+			// Neighbour arrays, padded to a multiple of LANES.
+static const int PADDED = (NORMAL_MAX_K + LANES - 1)/LANES*LANES ;
+
+/*------------------------------------------------------------
+ * Covariance of the neighbours of each point of a block, about
+ * their mean, into the upper triangle of cov; count[i] is how
+ * many neighbours were found. The sums are kept in LANES
+ * partial sums, as Icp.cpp does, and added up after the loops;
+ * the padding is the mean, so it adds 0 to the covariance.
+ */
+static void gather(KdTree const& tree, int begin, int m, int k, scalar maxDist2,
+                   Matrix3SoA const& cov, int* count) {
+   int idx[NORMAL_MAX_K] ;
+   scalar d2[NORMAL_MAX_K], x[PADDED], y[PADDED], z[PADDED] ;
+   for (int i = 0 ; i < m ; i++) {
+      const int found = tree.nearest(tree.point(begin + i), k, idx, d2, maxDist2) ;
+      const int padded = (found + LANES - 1)/LANES*LANES ;
+      count[i] = found ;
+      for (int j = 0 ; j < found ; j++) {
+         const Position p = tree.point(idx[j]) ;
+         x[j] = p.x ;  y[j] = p.y ;  z[j] = p.z ;
+         }
+      for (int j = found ; j < padded ; j++)
+         x[j] = y[j] = z[j] = 0 ;
+
+      scalar s[3][LANES] = { } ;
+      for (int j0 = 0 ; j0 < padded ; j0 += LANES) {
+         SIMD_LOOP
+         for (int l = 0 ; l < LANES ; l++) {
+            s[0][l] += x[j0 + l] ;  s[1][l] += y[j0 + l] ;  s[2][l] += z[j0 + l] ;
+            }
+         }
+      scalar c[3] = { 0, 0, 0 } ;
+      for (int a = 0 ; a < 3 ; a++)
+         for (int l = 0 ; l < LANES ; l++)
+            c[a] += s[a][l] ;
+      const scalar r = (found > 0) ? 1./found : 0 ;
+      const scalar cx = c[0]*r, cy = c[1]*r, cz = c[2]*r ;
+      for (int j = found ; j < padded ; j++) {
+         x[j] = cx ;  y[j] = cy ;  z[j] = cz ;
+         }
+
+      scalar q[6][LANES] = { } ;
+      for (int j0 = 0 ; j0 < padded ; j0 += LANES) {
+         SIMD_LOOP
+         for (int l = 0 ; l < LANES ; l++) {
+            const scalar dx = x[j0 + l] - cx, dy = y[j0 + l] - cy, dz = z[j0 + l] - cz ;
+            q[0][l] += dx*dx ;  q[1][l] += dx*dy ;  q[2][l] += dx*dz ;
+            q[3][l] += dy*dy ;  q[4][l] += dy*dz ;  q[5][l] += dz*dz ;
+            }
+         }
+      scalar e[6] = { 0, 0, 0, 0, 0, 0 } ;
+      for (int a = 0 ; a < 6 ; a++)
+         for (int l = 0 ; l < LANES ; l++)
+            e[a] += q[a][l] ;
+      cov.m[0][0][i] = e[0]*r ;  cov.m[0][1][i] = e[1]*r ;  cov.m[0][2][i] = e[2]*r ;
+      cov.m[1][1][i] = e[3]*r ;  cov.m[1][2][i] = e[4]*r ;  cov.m[2][2][i] = e[5]*r ;
+      }
+   }
+
+void estimateNormals(KdTree const& tree, int k, Position const& viewpoint,
+                     Direction* normals, scalar* curvature, scalar maxDistance) {
+   k = MIN(MAX(k, 1), NORMAL_MAX_K) ;
+   const scalar maxDist2 = (maxDistance < HUGE_VAL) ? maxDistance*maxDistance : HUGE_VAL ;
+   parallelFor(tree.size(), GRAIN, [&](int begin, int end) {
+      scalar a[9*CHUNK], e[9*CHUNK], l[3*CHUNK] ;
+      int count[CHUNK] ;
+      for (int b = begin ; b < end ; b += CHUNK) {
+         const int m = MIN(CHUNK, end - b) ;
+         const Matrix3SoA cov(a, m), vec(e, m) ;
+         const Vector3SoA val(l, l + m, l + 2*m) ;
+         gather(tree, b, m, k, maxDist2, cov, count) ;
+         eigenBatch(cov, val, vec, m) ;
+
+         for (int i = 0 ; i < m ; i++) {
+            if (count[i] < 3) {
+               normals[b + i] = Direction::Unit(0, 0, 0) ;
+               if (curvature)
+                  curvature[b + i] = 0 ;
+               continue ;
+               }
+            // eigenvalues decrease, so column 2 is the thinnest direction
+            const Vector3 n(vec.m[0][2][i], vec.m[1][2][i], vec.m[2][2][i]) ;
+            const Vector3 view = viewpoint - tree.point(b + i) ;
+            const scalar s = (n.dot(view) < 0) ? -1 : 1 ;
+            normals[b + i] = Direction::Unit(s*n.x, s*n.y, s*n.z) ;
+            if (curvature) {
+               const scalar sum = val.x[i] + val.y[i] + val.z[i] ;
+               curvature[b + i] = (sum > 0) ? MAX(val.z[i], 0.)/sum : 0 ;
+               }
+            }
+         }
+      }) ;
+   }
+
+void estimateNormals(Position const* points, int n, int k, Position const& viewpoint,
+                     Direction* normals, scalar* curvature) {
+   const KdTree tree(points, n) ;
+   estimateNormals(tree, k, viewpoint, normals, curvature) ;
+   }
@@ -0,0 +1,65 @@
+/* -------- Parallel.cpp -----------
+
+   Parallel Loop
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <Parallel.h>
+
+static std::atomic<int> requested(0) ;
+
+void setThreadCount(int n) {
+   requested = (n > 0) ? n : 0 ;
+   }
+
+int threadCount() {
+   const int n = requested ;
+   if (n > 0)
+      return n ;
+   const int hw = (int)std::thread::hardware_concurrency() ;
+   return (hw > 0) ? hw : 1 ;
+   }
+
+/*------------------------------------------------------------
+ * The chunks are claimed from a shared counter, so threads that
+ * finish early take more of them. With one chunk (or one thread)
+ * the body just runs on the calling thread.
+ */
+void parallelFor(int n, int grain, std::function<void(int, int)> const& body) {
+   if (n <= 0)
+      return ;
+   if (grain < 1)
+      grain = 1 ;
+   const int chunks = (n + grain - 1)/grain ;
+   const int threads = (threadCount() < chunks) ? threadCount() : chunks ;
+   if (threads <= 1) {
+      body(0, n) ;
+      return ;
+      }
+
+   std::atomic<int> next(0) ;
+   auto work = [&]() {
+      for (int c = next++ ; c < chunks ; c = next++) {
+         const int begin = c*grain ;
+         body(begin, (n - begin < grain) ? n : begin + grain) ;
+         }
+      } ;
+
+   std::vector<std::thread> pool ;
+   for (int t = 1 ; t < threads ; t++)
+      pool.push_back(std::thread(work)) ;
+   work() ;
+   for (size_t t = 0 ; t < pool.size() ; t++)
+      pool[t].join() ;
+   }
@@ -0,0 +1,502 @@
+/* -------- Predicates.cpp -----------
+
+   Robust Geometric Predicates
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   The error bounds and the expansion arithmetic assume every
+   operation is rounded on its own: a multiply fused into a later add
+   would break twoSum(). Contraction is turned off for this file.
+
+*/
+
+#ifdef __clang__
+#pragma STDC FP_CONTRACT OFF
+#elif defined(__GNUC__)
+#pragma GCC optimize ("fp-contract=off")
+#endif
+
+#include <Predicates.h>
+#include <Arena.h>
+
+static_assert(sizeof(scalar) == sizeof(double), "the predicates need double precision") ;
+
+			// Scratch arrays for the batch filters are this long.
+static const int CHUNK = 256 ;
+
+			// Half an ulp of 1 (2^-53) and Shewchuk's first stage error bounds.
+static const double EPS = 1.1102230246251565e-16 ;
+static const double CCW_BOUND = (3 + 16*EPS)*EPS ;
+static const double O3D_BOUND = (7 + 56*EPS)*EPS ;
+static const double ICC_BOUND = (10 + 96*EPS)*EPS ;
+static const double ISP_BOUND = (16 + 224*EPS)*EPS ;
+
+/** -----------------------------------------------------------
+ * Expansion arithmetic. An expansion is a sum of doubles, sorted
+ * by increasing magnitude, no two overlapping in their bits, with
+ * the zeros left out; its sign is the sign of the last (largest)
+ * component. The results are allocated in an arena.
+ **/
+class Expansion {
+   public:
+      double* e ;
+      int     n ;
+   } ;
+
+			// x + y == a + b exactly, x the rounded sum.
+static inline void twoSum(double a, double b, double& x, double& y) {
+   x = a + b ;
+   const double bv = x - a ;
+   const double av = x - bv ;
+   y = (a - av) + (b - bv) ;
+   }
+
+			// The same, given |a| >= |b|.
+static inline void fastTwoSum(double a, double b, double& x, double& y) {
+   x = a + b ;
+   y = b - (x - a) ;
+   }
+
+static inline void twoDiff(double a, double b, double& x, double& y) {
+   x = a - b ;
+   const double bv = a - x ;
+   const double av = x + bv ;
+   y = (a - av) + (bv - b) ;
+   }
+
+			// x + y == a * b exactly: the fused multiply-add yields the low half.
+static inline void twoProduct(double a, double b, double& x, double& y) {
+   x = a * b ;
+   y = fma(a, b, -x) ;
+   }
+
+			// a - b exactly, as an expansion of one or two components.
+static Expansion difference(Arena& arena, double a, double b) {
+   Expansion h ;
+   h.e = arena.array<double>(2) ;
+   h.n = 0 ;
+   double x, y ;
+   twoDiff(a, b, x, y) ;
+   if (y != 0)
+      h.e[h.n++] = y ;
+   if (x != 0)
+      h.e[h.n++] = x ;
+   return h ;
+   }
+
+/*------------------------------------------------------------
+ * Shewchuk's fast_expansion_sum_zeroelim: merge the components
+ * by magnitude and carry the sum up through them.
+ */
+static Expansion sum(Arena& arena, Expansion const& e, Expansion const& f) {
+   if (e.n == 0)
+      return f ;
+   if (f.n == 0)
+      return e ;
+
+   Expansion h ;
+   h.e = arena.array<double>(e.n + f.n) ;
+   h.n = 0 ;
+   int ei = 0, fi = 0 ;
+   double en = e.e[0], fn = f.e[0] ;
+   double q, qnew, hh ;
+
+   if ((fn > en) == (fn > -en)) {
+      q = en ;
+      en = (++ei < e.n) ? e.e[ei] : 0 ;
+      }
+   else {
+      q = fn ;
+      fn = (++fi < f.n) ? f.e[fi] : 0 ;
+      }
+   if (ei < e.n && fi < f.n) {
+      if ((fn > en) == (fn > -en)) {
+         fastTwoSum(en, q, qnew, hh) ;
+         en = (++ei < e.n) ? e.e[ei] : 0 ;
+         }
+      else {
+         fastTwoSum(fn, q, qnew, hh) ;
+         fn = (++fi < f.n) ? f.e[fi] : 0 ;
+         }
+      q = qnew ;
+      if (hh != 0)
+         h.e[h.n++] = hh ;
+      while (ei < e.n && fi < f.n) {
+         if ((fn > en) == (fn > -en)) {
+            twoSum(q, en, qnew, hh) ;
+            en = (++ei < e.n) ? e.e[ei] : 0 ;
+            }
+         else {
+            twoSum(q, fn, qnew, hh) ;
+            fn = (++fi < f.n) ? f.e[fi] : 0 ;
+            }
+         q = qnew ;
+         if (hh != 0)
+            h.e[h.n++] = hh ;
+         }
+      }
+   for ( ; ei < e.n ; ei++) {
+      twoSum(q, e.e[ei], qnew, hh) ;
+      q = qnew ;
+      if (hh != 0)
+         h.e[h.n++] = hh ;
+      }
+   for ( ; fi < f.n ; fi++) {
+      twoSum(q, f.e[fi], qnew, hh) ;
+      q = qnew ;
+      if (hh != 0)
+         h.e[h.n++] = hh ;
+      }
+   if (q != 0)
+      h.e[h.n++] = q ;
+   return h ;
+   }
+
+static Expansion negate(Arena& arena, Expansion const& e) {
+   Expansion h ;
+   h.e = arena.array<double>(e.n) ;
+   h.n = e.n ;
+   for (int i = 0 ; i < e.n ; i++)
+      h.e[i] = -e.e[i] ;
+   return h ;
+   }
+
+static Expansion diff(Arena& arena, Expansion const& e, Expansion const& f) {
+   return sum(arena, e, negate(arena, f)) ;
+   }
+
+/*------------------------------------------------------------
+ * Shewchuk's scale_expansion_zeroelim: e * b.
+ */
+static Expansion scale(Arena& arena, Expansion const& e, double b) {
+   Expansion h ;
+   h.e = arena.array<double>(2*e.n) ;
+   h.n = 0 ;
+   if (e.n == 0 || b == 0)
+      return h ;
+
+   double q, hh, p1, p0, s ;
+   twoProduct(e.e[0], b, q, hh) ;
+   if (hh != 0)
+      h.e[h.n++] = hh ;
+   for (int i = 1 ; i < e.n ; i++) {
+      twoProduct(e.e[i], b, p1, p0) ;
+      twoSum(q, p0, s, hh) ;
+      if (hh != 0)
+         h.e[h.n++] = hh ;
+      fastTwoSum(p1, s, q, hh) ;
+      if (hh != 0)
+         h.e[h.n++] = hh ;
+      }
+   if (q != 0)
+      h.e[h.n++] = q ;
+   return h ;
+   }
+
+static Expansion product(Arena& arena, Expansion const& e, Expansion const& f) {
+   Expansion h = { 0, 0 } ;
+   for (int i = 0 ; i < f.n ; i++)
+      h = sum(arena, h, scale(arena, e, f.e[i])) ;
+   return h ;
+   }
+
+static inline double sign(Expansion const& e) {
+   return (e.n > 0) ? e.e[e.n - 1] : 0 ;
+   }
+
+/** -----------------------------------------------------------
+ * The first stage: the determinants in floating point, and
+ * whether they are certainly further from 0 than their error.
+ * No branches, so the batch loops vectorize.
+ **/
+static inline double orient2dFast(double ax, double ay, double bx, double by,
+                                  double cx, double cy, bool& sure) {
+   const double left = (ax - cx)*(by - cy) ;
+   const double right = (ay - cy)*(bx - cx) ;
+   const double det = left - right ;
+   sure = ABS(det) >= CCW_BOUND*(ABS(left) + ABS(right)) ;
+   return det ;
+   }
+
+static inline double orient3dFast(double ax, double ay, double az, double bx, double by, double bz,
+                                  double cx, double cy, double cz, double dx, double dy, double dz,
+                                  bool& sure) {
+   const double adx = ax - dx, bdx = bx - dx, cdx = cx - dx ;
+   const double ady = ay - dy, bdy = by - dy, cdy = cy - dy ;
+   const double adz = az - dz, bdz = bz - dz, cdz = cz - dz ;
+
+   const double bdxcdy = bdx*cdy, cdxbdy = cdx*bdy ;
+   const double cdxady = cdx*ady, adxcdy = adx*cdy ;
+   const double adxbdy = adx*bdy, bdxady = bdx*ady ;
+
+   const double det = adz*(bdxcdy - cdxbdy) + bdz*(cdxady - adxcdy) + cdz*(adxbdy - bdxady) ;
+   const double permanent = (ABS(bdxcdy) + ABS(cdxbdy))*ABS(adz)
+                          + (ABS(cdxady) + ABS(adxcdy))*ABS(bdz)
+                          + (ABS(adxbdy) + ABS(bdxady))*ABS(cdz) ;
+   sure = ABS(det) > O3D_BOUND*permanent ;
+   return det ;
+   }
+
+static inline double incircleFast(double ax, double ay, double bx, double by,
+                                  double cx, double cy, double dx, double dy, bool& sure) {
+   const double adx = ax - dx, bdx = bx - dx, cdx = cx - dx ;
+   const double ady = ay - dy, bdy = by - dy, cdy = cy - dy ;
+
+   const double bdxcdy = bdx*cdy, cdxbdy = cdx*bdy ;
+   const double cdxady = cdx*ady, adxcdy = adx*cdy ;
+   const double adxbdy = adx*bdy, bdxady = bdx*ady ;
+   const double alift = adx*adx + ady*ady ;
+   const double blift = bdx*bdx + bdy*bdy ;
+   const double clift = cdx*cdx + cdy*cdy ;
+
+   const double det = alift*(bdxcdy - cdxbdy) + blift*(cdxady - adxcdy) + clift*(adxbdy - bdxady) ;
+   const double permanent = (ABS(bdxcdy) + ABS(cdxbdy))*alift
+                          + (ABS(cdxady) + ABS(adxcdy))*blift
+                          + (ABS(adxbdy) + ABS(bdxady))*clift ;
+   sure = ABS(det) > ICC_BOUND*permanent ;
+   return det ;
+   }
+
+static inline double insphereFast(double ax, double ay, double az, double bx, double by, double bz,
+                                  double cx, double cy, double cz, double dx, double dy, double dz,
+                                  double ex, double ey, double ez, bool& sure) {
+   const double aex = ax - ex, bex = bx - ex, cex = cx - ex, dex = dx - ex ;
+   const double aey = ay - ey, bey = by - ey, cey = cy - ey, dey = dy - ey ;
+   const double aez = az - ez, bez = bz - ez, cez = cz - ez, dez = dz - ez ;
+
+   const double aexbey = aex*bey, bexaey = bex*aey ;
+   const double bexcey = bex*cey, cexbey = cex*bey ;
+   const double cexdey = cex*dey, dexcey = dex*cey ;
+   const double dexaey = dex*aey, aexdey = aex*dey ;
+   const double aexcey = aex*cey, cexaey = cex*aey ;
+   const double bexdey = bex*dey, dexbey = dex*bey ;
+   const double ab = aexbey - bexaey, bc = bexcey - cexbey ;
+   const double cd = cexdey - dexcey, da = dexaey - aexdey ;
+   const double ac = aexcey - cexaey, bd = bexdey - dexbey ;
+
+   const double abc = aez*bc - bez*ac + cez*ab ;
+   const double bcd = bez*cd - cez*bd + dez*bc ;
+   const double cda = cez*da + dez*ac + aez*cd ;
+   const double dab = dez*ab + aez*bd + bez*da ;
+
+   const double alift = aex*aex + aey*aey + aez*aez ;
+   const double blift = bex*bex + bey*bey + bez*bez ;
+   const double clift = cex*cex + cey*cey + cez*cez ;
+   const double dlift = dex*dex + dey*dey + dez*dez ;
+
+   const double det = (dlift*abc - clift*dab) + (blift*cda - alift*bcd) ;
+
+   const double aez1 = ABS(aez), bez1 = ABS(bez), cez1 = ABS(cez), dez1 = ABS(dez) ;
+   const double ab1 = ABS(aexbey) + ABS(bexaey), bc1 = ABS(bexcey) + ABS(cexbey) ;
+   const double cd1 = ABS(cexdey) + ABS(dexcey), da1 = ABS(dexaey) + ABS(aexdey) ;
+   const double ac1 = ABS(aexcey) + ABS(cexaey), bd1 = ABS(bexdey) + ABS(dexbey) ;
+   const double permanent = (cd1*bez1 + bd1*cez1 + bc1*dez1)*alift
+                          + (da1*cez1 + ac1*dez1 + cd1*aez1)*blift
+                          + (ab1*dez1 + bd1*aez1 + da1*bez1)*clift
+                          + (bc1*aez1 + ac1*bez1 + ab1*cez1)*dlift ;
+   sure = ABS(det) > ISP_BOUND*permanent ;
+   return det ;
+   }
+
+/** -----------------------------------------------------------
+ * The exact stage: the same determinants term by term in
+ * expansion arithmetic, from the exact differences.
+ **/
+static double orient2dExact(double ax, double ay, double bx, double by,
+                            double cx, double cy) {
+   ArenaScope scope ;
+   Arena& A = scope.arena ;
+   const Expansion acx = difference(A, ax, cx), acy = difference(A, ay, cy) ;
+   const Expansion bcx = difference(A, bx, cx), bcy = difference(A, by, cy) ;
+   return sign(diff(A, product(A, acx, bcy), product(A, acy, bcx))) ;
+   }
+
+static double orient3dExact(double ax, double ay, double az, double bx, double by, double bz,
+                            double cx, double cy, double cz, double dx, double dy, double dz) {
+   ArenaScope scope ;
+   Arena& A = scope.arena ;
+   const Expansion adx = difference(A, ax, dx), bdx = difference(A, bx, dx), cdx = difference(A, cx, dx) ;
+   const Expansion ady = difference(A, ay, dy), bdy = difference(A, by, dy), cdy = difference(A, cy, dy) ;
+   const Expansion adz = difference(A, az, dz), bdz = difference(A, bz, dz), cdz = difference(A, cz, dz) ;
+
+   const Expansion bc = diff(A, product(A, bdx, cdy), product(A, cdx, bdy)) ;
+   const Expansion ca = diff(A, product(A, cdx, ady), product(A, adx, cdy)) ;
+   const Expansion ab = diff(A, product(A, adx, bdy), product(A, bdx, ady)) ;
+   return sign(sum(A, sum(A, product(A, adz, bc), product(A, bdz, ca)), product(A, cdz, ab))) ;
+   }
+
+static double incircleExact(double ax, double ay, double bx, double by,
+                            double cx, double cy, double dx, double dy) {
+   ArenaScope scope ;
+   Arena& A = scope.arena ;
+   const Expansion adx = difference(A, ax, dx), bdx = difference(A, bx, dx), cdx = difference(A, cx, dx) ;
+   const Expansion ady = difference(A, ay, dy), bdy = difference(A, by, dy), cdy = difference(A, cy, dy) ;
+
+   const Expansion bc = diff(A, product(A, bdx, cdy), product(A, cdx, bdy)) ;
+   const Expansion ca = diff(A, product(A, cdx, ady), product(A, adx, cdy)) ;
+   const Expansion ab = diff(A, product(A, adx, bdy), product(A, bdx, ady)) ;
+   const Expansion alift = sum(A, product(A, adx, adx), product(A, ady, ady)) ;
+   const Expansion blift = sum(A, product(A, bdx, bdx), product(A, bdy, bdy)) ;
+   const Expansion clift = sum(A, product(A, cdx, cdx), product(A, cdy, cdy)) ;
+   return sign(sum(A, sum(A, product(A, alift, bc), product(A, blift, ca)), product(A, clift, ab))) ;
+   }
+
+static double insphereExact(double ax, double ay, double az, double bx, double by, double bz,
+                            double cx, double cy, double cz, double dx, double dy, double dz,
+                            double ex, double ey, double ez) {
+   ArenaScope scope ;
+   Arena& A = scope.arena ;
+   const Expansion aex = difference(A, ax, ex), bex = difference(A, bx, ex) ;
+   const Expansion cex = difference(A, cx, ex), dex = difference(A, dx, ex) ;
+   const Expansion aey = difference(A, ay, ey), bey = difference(A, by, ey) ;
+   const Expansion cey = difference(A, cy, ey), dey = difference(A, dy, ey) ;
+   const Expansion aez = difference(A, az, ez), bez = difference(A, bz, ez) ;
+   const Expansion cez = difference(A, cz, ez), dez = difference(A, dz, ez) ;
+
+   const Expansion ab = diff(A, product(A, aex, bey), product(A, bex, aey)) ;
+   const Expansion bc = diff(A, product(A, bex, cey), product(A, cex, bey)) ;
+   const Expansion cd = diff(A, product(A, cex, dey), product(A, dex, cey)) ;
+   const Expansion da = diff(A, product(A, dex, aey), product(A, aex, dey)) ;
+   const Expansion ac = diff(A, product(A, aex, cey), product(A, cex, aey)) ;
+   const Expansion bd = diff(A, product(A, bex, dey), product(A, dex, bey)) ;
+
+   const Expansion abc = sum(A, diff(A, product(A, aez, bc), product(A, bez, ac)), product(A, cez, ab)) ;
+   const Expansion bcd = sum(A, diff(A, product(A, bez, cd), product(A, cez, bd)), product(A, dez, bc)) ;
+   const Expansion cda = sum(A, sum(A, product(A, cez, da), product(A, dez, ac)), product(A, aez, cd)) ;
+   const Expansion dab = sum(A, sum(A, product(A, dez, ab), product(A, aez, bd)), product(A, bez, da)) ;
+
+   auto lift = [&](Expansion const& x, Expansion const& y, Expansion const& z) {
+      return sum(A, sum(A, product(A, x, x), product(A, y, y)), product(A, z, z)) ;
+      } ;
+   const Expansion alift = lift(aex, aey, aez), blift = lift(bex, bey, bez) ;
+   const Expansion clift = lift(cex, cey, cez), dlift = lift(dex, dey, dez) ;
+
+   return sign(sum(A, diff(A, product(A, dlift, abc), product(A, clift, dab)),
+                      diff(A, product(A, blift, cda), product(A, alift, bcd)))) ;
+   }
+
+/** -----------------------------------------------------------
+ * The predicates.
+ **/
+scalar orient2d(Vector2 const& a, Vector2 const& b, Vector2 const& c) {
+   bool sure ;
+   const double det = orient2dFast(a.x, a.y, b.x, b.y, c.x, c.y, sure) ;
+   return sure ? det : orient2dExact(a.x, a.y, b.x, b.y, c.x, c.y) ;
+   }
+
+scalar orient3d(Position const& a, Position const& b, Position const& c, Position const& d) {
+   bool sure ;
+   const double det = orient3dFast(a.x, a.y, a.z, b.x, b.y, b.z,
+                                   c.x, c.y, c.z, d.x, d.y, d.z, sure) ;
+   return sure ? det : orient3dExact(a.x, a.y, a.z, b.x, b.y, b.z,
+                                     c.x, c.y, c.z, d.x, d.y, d.z) ;
+   }
+
+scalar incircle(Vector2 const& a, Vector2 const& b, Vector2 const& c, Vector2 const& d) {
+   bool sure ;
+   const double det = incircleFast(a.x, a.y, b.x, b.y, c.x, c.y, d.x, d.y, sure) ;
+   return sure ? det : incircleExact(a.x, a.y, b.x, b.y, c.x, c.y, d.x, d.y) ;
+   }
+
+scalar insphere(Position const& a, Position const& b, Position const& c,
+                Position const& d, Position const& e) {
+   bool sure ;
+   const double det = insphereFast(a.x, a.y, a.z, b.x, b.y, b.z, c.x, c.y, c.z,
+                                   d.x, d.y, d.z, e.x, e.y, e.z, sure) ;
+   return sure ? det : insphereExact(a.x, a.y, a.z, b.x, b.y, b.z, c.x, c.y, c.z,
+                                     d.x, d.y, d.z, e.x, e.y, e.z) ;
+   }
+
+/** -----------------------------------------------------------
+ * Batches: the filter over a chunk, then the exact stage for
+ * the elements it left undecided.
+ **/
+void orient2dBatch(Vector2SoA const& a, Vector2SoA const& b, Vector2SoA const& c,
+                   scalar* out, int n) {
+   bool sure[CHUNK] ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      SIMD_LOOP
+      for (int k = 0 ; k < m ; k++) {
+         const int i = i0 + k ;
+         out[i] = orient2dFast(a.x[i], a.y[i], b.x[i], b.y[i], c.x[i], c.y[i], sure[k]) ;
+         }
+      for (int k = 0 ; k < m ; k++)
+         if (!sure[k]) {
+            const int i = i0 + k ;
+            out[i] = orient2dExact(a.x[i], a.y[i], b.x[i], b.y[i], c.x[i], c.y[i]) ;
+            }
+      }
+   }
+
+void orient3dBatch(Vector3SoA const& a, Vector3SoA const& b, Vector3SoA const& c,
+                   Vector3SoA const& d, scalar* out, int n) {
+   bool sure[CHUNK] ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      SIMD_LOOP
+      for (int k = 0 ; k < m ; k++) {
+         const int i = i0 + k ;
+         out[i] = orient3dFast(a.x[i], a.y[i], a.z[i], b.x[i], b.y[i], b.z[i],
+                               c.x[i], c.y[i], c.z[i], d.x[i], d.y[i], d.z[i], sure[k]) ;
+         }
+      for (int k = 0 ; k < m ; k++)
+         if (!sure[k]) {
+            const int i = i0 + k ;
+            out[i] = orient3dExact(a.x[i], a.y[i], a.z[i], b.x[i], b.y[i], b.z[i],
+                                   c.x[i], c.y[i], c.z[i], d.x[i], d.y[i], d.z[i]) ;
+            }
+      }
+   }
+
+void incircleBatch(Vector2SoA const& a, Vector2SoA const& b, Vector2SoA const& c,
+                   Vector2SoA const& d, scalar* out, int n) {
+   bool sure[CHUNK] ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      SIMD_LOOP
+      for (int k = 0 ; k < m ; k++) {
+         const int i = i0 + k ;
+         out[i] = incircleFast(a.x[i], a.y[i], b.x[i], b.y[i],
+                               c.x[i], c.y[i], d.x[i], d.y[i], sure[k]) ;
+         }
+      for (int k = 0 ; k < m ; k++)
+         if (!sure[k]) {
+            const int i = i0 + k ;
+            out[i] = incircleExact(a.x[i], a.y[i], b.x[i], b.y[i],
+                                   c.x[i], c.y[i], d.x[i], d.y[i]) ;
+            }
+      }
+   }
+
+void insphereBatch(Vector3SoA const& a, Vector3SoA const& b, Vector3SoA const& c,
+                   Vector3SoA const& d, Vector3SoA const& e, scalar* out, int n) {
+   bool sure[CHUNK] ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      SIMD_LOOP
+      for (int k = 0 ; k < m ; k++) {
+         const int i = i0 + k ;
+         out[i] = insphereFast(a.x[i], a.y[i], a.z[i], b.x[i], b.y[i], b.z[i],
+                               c.x[i], c.y[i], c.z[i], d.x[i], d.y[i], d.z[i],
+                               e.x[i], e.y[i], e.z[i], sure[k]) ;
+         }
+      for (int k = 0 ; k < m ; k++)
+         if (!sure[k]) {
+            const int i = i0 + k ;
+            out[i] = insphereExact(a.x[i], a.y[i], a.z[i], b.x[i], b.y[i], b.z[i],
+                                   c.x[i], c.y[i], c.z[i], d.x[i], d.y[i], d.z[i],
+                                   e.x[i], e.y[i], e.z[i]) ;
+            }
+      }
+   }
@@ -0,0 +1,128 @@
+/* -------- Projection.cpp -----------
+
+   Projection (Vertex Stage)
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <Projection.h>
+
+/*------------------------------------------------------------
+ * The OpenGL (gluPerspective) matrix, transposed for row
+ * vectors: w = -z, and z = -zNear..-zFar goes to -1..1.
+ */
+Transform perspective(scalar fovy, scalar aspect, scalar zNear, scalar zFar) {
+   const scalar f = 1/tan(fovy/2) ;
+   Transform mx ;
+   mx.xform[0][0] = f/aspect ;
+   mx.xform[1][1] = f ;
+   mx.xform[2][2] = (zFar + zNear)/(zNear - zFar) ;
+   mx.xform[2][3] = -1 ;
+   mx.xform[3][2] = 2*zFar*zNear/(zNear - zFar) ;
+   mx.xform[3][3] = 0 ;
+   return mx ;
+   }
+
+/*------------------------------------------------------------
+ * Per element pieces, on plain scalars so the loops vectorize.
+ */
+static inline int code(scalar x, scalar y, scalar z, scalar w) {
+   return (x < -w ? CLIP_LEFT   : 0) | (x > w ? CLIP_RIGHT : 0)
+        | (y < -w ? CLIP_BOTTOM : 0) | (y > w ? CLIP_TOP   : 0)
+        | (z < -w ? CLIP_NEAR   : 0) | (z > w ? CLIP_FAR   : 0) ;
+   }
+
+			// The viewport as screen = ndc * scale + offset.
+class ViewMap {
+   public:
+      scalar sx, sy, sz ;
+      scalar ox, oy, oz ;
+
+      ViewMap(Viewport const& vp)
+         : sx(.5*vp.width), sy(-.5*vp.height), sz(.5*(vp.zFar - vp.zNear)),
+           ox(vp.x0 + .5*vp.width), oy(vp.y0 + .5*vp.height), oz(.5*(vp.zFar + vp.zNear)) { }
+   } ;
+
+void transformBatch(Vector3SoA const& p, Transform const& mx,
+                    Vector4SoA const& clip, int n) {
+   scalar m[4][4] ;
+   for (int r = 0 ; r < 4 ; r++)
+      for (int c = 0 ; c < 4 ; c++)
+         m[r][c] = mx.xform[r][c] ;
+
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar x = p.x[i], y = p.y[i], z = p.z[i] ;
+      clip.x[i] = x*m[0][0] + y*m[1][0] + z*m[2][0] + m[3][0] ;
+      clip.y[i] = x*m[0][1] + y*m[1][1] + z*m[2][1] + m[3][1] ;
+      clip.z[i] = x*m[0][2] + y*m[1][2] + z*m[2][2] + m[3][2] ;
+      clip.w[i] = x*m[0][3] + y*m[1][3] + z*m[2][3] + m[3][3] ;
+      }
+   }
+
+void outcodeBatch(Vector4SoA const& clip, unsigned char* codes, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++)
+      codes[i] = (unsigned char)code(clip.x[i], clip.y[i], clip.z[i], clip.w[i]) ;
+   }
+
+void divideBatch(Vector4SoA const& clip, Viewport const& vp,
+                 Vector3SoA const& screen, scalar* invW, int n) {
+   const ViewMap v(vp) ;
+
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const scalar w = clip.w[i] ;
+      const scalar r = (w != 0) ? 1/w : 0 ;
+      screen.x[i] = clip.x[i]*r*v.sx + v.ox ;
+      screen.y[i] = clip.y[i]*r*v.sy + v.oy ;
+      screen.z[i] = clip.z[i]*r*v.sz + v.oz ;
+      invW[i] = r ;
+      }
+   }
+
+/** -----------------------------------------------------------
+ * The fused pass: each position is read once and every output
+ * written once, with no intermediate arrays between the stages.
+ **/
+int projectBatch(Vector3SoA const& p, Transform const& mx, Viewport const& vp,
+                 Vector4SoA const& clip, unsigned char* codes,
+                 Vector3SoA const& screen, scalar* invW, int n) {
+   scalar m[4][4] ;
+   for (int r = 0 ; r < 4 ; r++)
+      for (int c = 0 ; c < 4 ; c++)
+         m[r][c] = mx.xform[r][c] ;
+   const ViewMap v(vp) ;
+   int all = CLIP_LEFT | CLIP_RIGHT | CLIP_BOTTOM | CLIP_TOP | CLIP_NEAR | CLIP_FAR ;
+
+   SIMD_REDUCE(&, all)
+   for (int i = 0 ; i < n ; i++) {
+      const scalar x = p.x[i], y = p.y[i], z = p.z[i] ;
+      const scalar cx = x*m[0][0] + y*m[1][0] + z*m[2][0] + m[3][0] ;
+      const scalar cy = x*m[0][1] + y*m[1][1] + z*m[2][1] + m[3][1] ;
+      const scalar cz = x*m[0][2] + y*m[1][2] + z*m[2][2] + m[3][2] ;
+      const scalar cw = x*m[0][3] + y*m[1][3] + z*m[2][3] + m[3][3] ;
+      clip.x[i] = cx ;
+      clip.y[i] = cy ;
+      clip.z[i] = cz ;
+      clip.w[i] = cw ;
+
+      const int c = code(cx, cy, cz, cw) ;
+      codes[i] = (unsigned char)c ;
+      all &= c ;
+
+      const scalar r = (cw != 0) ? 1/cw : 0 ;
+      screen.x[i] = cx*r*v.sx + v.ox ;
+      screen.y[i] = cy*r*v.sy + v.oy ;
+      screen.z[i] = cz*r*v.sz + v.oz ;
+      invW[i] = r ;
+      }
+   return all ;
+   }
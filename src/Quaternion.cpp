@@ -0,0 +1,106 @@
+/* -------- Quaternion.cpp -----------
+
+   Quaternion Class Library
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <Vector.h>
+
+Quaternion::Quaternion(Direction const& axis, scalar radians) {
+   const scalar s = sin(radians/2) ;
+   w = cos(radians/2) ;
+   x = axis.x * s ;
+   y = axis.y * s ;
+   z = axis.z * s ;
+   }
+
+/** -----------------------------------------------------------
+ * Extract the rotation from a rotation matrix (Shepperd's
+ * method): take the square root of the largest of w, x, y and z
+ * from the diagonal, the rest from the off diagonal sums and
+ * differences. mx is in row vector form, so m[i][j] is the
+ * usual R[j][i].
+ **/
+Quaternion::Quaternion(Transform const& mx) {
+   const scalar (*m)[4] = mx.xform ;
+   const scalar trace = m[0][0] + m[1][1] + m[2][2] ;
+
+   if (trace >= m[0][0] && trace >= m[1][1] && trace >= m[2][2]) {
+      const scalar r = sqrt(1 + trace) ;
+      const scalar s = .5/r ;
+      w = .5*r ;
+      x = (m[1][2] - m[2][1]) * s ;
+      y = (m[2][0] - m[0][2]) * s ;
+      z = (m[0][1] - m[1][0]) * s ;
+      }
+   else if (m[0][0] >= m[1][1] && m[0][0] >= m[2][2]) {
+      const scalar r = sqrt(1 + m[0][0] - m[1][1] - m[2][2]) ;
+      const scalar s = .5/r ;
+      x = .5*r ;
+      w = (m[1][2] - m[2][1]) * s ;
+      y = (m[0][1] + m[1][0]) * s ;
+      z = (m[2][0] + m[0][2]) * s ;
+      }
+   else if (m[1][1] >= m[2][2]) {
+      const scalar r = sqrt(1 - m[0][0] + m[1][1] - m[2][2]) ;
+      const scalar s = .5/r ;
+      y = .5*r ;
+      w = (m[2][0] - m[0][2]) * s ;
+      x = (m[0][1] + m[1][0]) * s ;
+      z = (m[1][2] + m[2][1]) * s ;
+      }
+   else {
+      const scalar r = sqrt(1 - m[0][0] - m[1][1] + m[2][2]) ;
+      const scalar s = .5/r ;
+      z = .5*r ;
+      w = (m[0][1] - m[1][0]) * s ;
+      x = (m[2][0] + m[0][2]) * s ;
+      y = (m[1][2] + m[2][1]) * s ;
+      }
+   }
+
+scalar Quaternion::len() const {
+   return sqrt(dot(*this)) ;
+   }
+
+scalar Quaternion::norm() {
+   const scalar l = len() ;
+   if (l != 0) {
+      w /= l ;
+      x /= l ;
+      y /= l ;
+      z /= l ;
+      }
+   return l ;
+   }
+
+/** -----------------------------------------------------------
+ * Slerp (Shoemake). b is negated if need be to take the shorter
+ * arc; when the quaternions are nearly parallel sin(theta) is
+ * too small to divide by and nlerp is as good.
+ **/
+Quaternion slerp(Quaternion const& a, Quaternion const& b, scalar t) {
+   scalar c = a.dot(b) ;
+   Quaternion e = (c < 0) ? -b : b ;
+   c = ABS(c) ;
+   if (c > 1 - EPSILON)
+      return nlerp(a, e, t) ;
+
+   const scalar theta = acos(c) ;
+   const scalar s = 1/sin(theta) ;
+   return a*(sin((1 - t)*theta)*s) + e*(sin(t*theta)*s) ;
+   }
+
+Quaternion nlerp(Quaternion const& a, Quaternion const& b, scalar t) {
+   Quaternion q = (a.dot(b) < 0) ? a*(1 - t) - b*t : a*(1 - t) + b*t ;
+   q.norm() ;
+   return q ;
+   }
@@ -0,0 +1,139 @@
+/* -------- Ray.cpp -----------
+
+   Ray, Hit and Bounds
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <Ray.h>
+#include <Simd.h>
+
+/** -----------------------------------------------------------
+ * Slab test (Kay & Kajiya). A zero direction coordinate gives
+ * an infinite invDir, and the slab is then everything or nothing,
+ * except when the origin lies in one of its planes: 0 * inf is NaN
+ * there. Such a ray runs along a face, inside the (closed) slab,
+ * so a slab with a NaN distance leaves tmin and tmax alone.
+ **/
+static inline void slab(scalar lo, scalar hi, scalar origin, scalar invDir,
+                        scalar& tmin, scalar& tmax) {
+   const scalar t0 = (lo - origin) * invDir ;
+   const scalar t1 = (hi - origin) * invDir ;
+   if (t0 == t0 && t1 == t1) {
+      tmin = MAX(tmin, MIN(t0, t1)) ;
+      tmax = MIN(tmax, MAX(t0, t1)) ;
+      }
+   }
+
+bool Bounds::intersect(Position const& origin, Vector3 const& invDir,
+                       scalar tmin, scalar tmax) const {
+   slab(lo.x, hi.x, origin.x, invDir.x, tmin, tmax) ;
+   slab(lo.y, hi.y, origin.y, invDir.y, tmin, tmax) ;
+   slab(lo.z, hi.z, origin.z, invDir.z, tmin, tmax) ;
+   return tmin <= tmax ;
+   }
+
+/*------------------------------------------------------------
+ * Transform the 8 corners and bound them. (Arvo's method would
+ * be quicker; this is not on any inner loop.)
+ */
+Bounds Bounds::transform(Transform const& mx) const {
+   Bounds b ;
+   if (empty())
+      return b ;
+   for (int i = 0 ; i < 8 ; i++)
+      b.extend(Position((i & 1) ? hi.x : lo.x,
+                        (i & 2) ? hi.y : lo.y,
+                        (i & 4) ? hi.z : lo.z) * mx) ;
+   return b ;
+   }
+
+void Traceable::intersect(Ray const* rays, Hit* hits, int n) const {
+   for (int i = 0 ; i < n ; i++)
+      intersect(rays[i], hits[i]) ;
+   }
+
+void Traceable::occluded(Ray const* rays, bool* blocked, int n) const {
+   for (int i = 0 ; i < n ; i++)
+      blocked[i] = occluded(rays[i]) ;
+   }
+
+/*------------------------------------------------------------
+ * Without a packet traversal the rays go one at a time; only
+ * the ray and packet counts are kept.
+ */
+void Traceable::intersectPacket(Ray const* rays, Hit* hits, int n,
+                                PacketStats* stats) const {
+   intersect(rays, hits, n) ;
+   if (stats) {
+      stats->rays += n ;
+      stats->packets++ ;
+      }
+   }
+
+void Traceable::occludedPacket(Ray const* rays, bool* blocked, int n,
+                               PacketStats* stats) const {
+   occluded(rays, blocked, n) ;
+   if (stats) {
+      stats->rays += n ;
+      stats->packets++ ;
+      }
+   }
+
+RayPacket::RayPacket(Ray const* rays, int n, Hit* hits, bool* blocked, PacketStats* stats)
+   : size(n) {
+   for (int k = 0 ; k < n ; k++) {
+      ox[k] = rays[k].origin.x ;
+      oy[k] = rays[k].origin.y ;
+      oz[k] = rays[k].origin.z ;
+      ix[k] = 1/rays[k].direction.x ;
+      iy[k] = 1/rays[k].direction.y ;
+      iz[k] = 1/rays[k].direction.z ;
+      t0[k] = rays[k].tmin ;
+      t1[k] = rays[k].tmax ;
+      live[k] = true ;
+      if (hits) {
+         hits[k] = Hit() ;
+         hits[k].t = t1[k] ;
+         }
+      else if (blocked)
+         blocked[k] = false ;
+      }
+   if (stats) {
+      stats->rays += n ;
+      stats->packets++ ;
+      }
+   }
+
+			// The slab test of Bounds::intersect() across the lanes.
+int RayPacket::enter(Bounds const& b, PacketStats* stats) {
+   int active = 0 ;
+   SIMD_REDUCE(+, active)
+   for (int k = 0 ; k < size ; k++) {
+      scalar tmin = t0[k], tmax = t1[k] ;
+      slab(b.lo.x, b.hi.x, ox[k], ix[k], tmin, tmax) ;
+      slab(b.lo.y, b.hi.y, oy[k], iy[k], tmin, tmax) ;
+      slab(b.lo.z, b.hi.z, oz[k], iz[k], tmin, tmax) ;
+      in[k] = live[k] && tmin <= tmax ;
+      active += in[k] ;
+      }
+   if (stats) {
+      stats->visits++ ;
+      stats->slots += size ;
+      stats->lanes += active ;
+      }
+   return active ;
+   }
+
+void RayPacket::finish(Hit* hits) const {
+   for (int k = 0 ; k < size ; k++)
+      if (!hits[k].hit())
+         hits[k].t = HUGE_VAL ;
+   }
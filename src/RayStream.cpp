@@ -0,0 +1,153 @@
+/* -------- RayStream.cpp -----------
+
+   Ray Stream (Coherent Batch Tracing)
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <algorithm>
+#include <RayStream.h>
+
+			// Bits for each of the direction's two minor coordinates and
+			// each origin coordinate. With the bin, 32 bits in all.
+static const int DIRECTION_BITS = 7 ;
+static const int ORIGIN_BITS = 5 ;
+
+RayStream::RayStream(int size) :
+   packetSize(MAX(1, MIN(size, RAY_PACKET))) { }
+
+/*------------------------------------------------------------
+ * The same comparisons as majorAxis(), so that the bins agree
+ * with it, ties and all.
+ */
+int RayStream::octant(Direction const& d) {
+   int axis ;
+   scalar c ;
+   if (ABS(d.x) >= ABS(d.y))
+      if (ABS(d.x) >= ABS(d.z))
+         axis = 0, c = d.x ;
+      else
+         axis = 2, c = d.z ;
+   else
+      if (ABS(d.y) >= ABS(d.z))
+         axis = 1, c = d.y ;
+      else
+         axis = 2, c = d.z ;
+   return 2*axis + (c < 0) ;
+   }
+
+/*------------------------------------------------------------
+ * Where d crosses the cube face its major axis points at, as
+ * two cell numbers. A zero direction crosses no face and goes to
+ * cell 0 (a/m would be NaN, and NaN to unsigned is undefined).
+ */
+static inline void cone(Direction const& d, unsigned long& i, unsigned long& j) {
+   const scalar ax = ABS(d.x), ay = ABS(d.y), az = ABS(d.z) ;
+   scalar a = d.x, b = d.y, m = az ;
+   if (ax >= ay && ax >= az)
+      a = d.y, b = d.z, m = ax ;
+   else if (ay >= az)
+      a = d.x, b = d.z, m = ay ;
+   if (!(m > 0)) {
+      i = j = 0 ;
+      return ;
+      }
+   const scalar cells = (1 << DIRECTION_BITS) - 1 ;
+   i = (unsigned long)((a/m + 1)*.5*cells + .5) ;
+   j = (unsigned long)((b/m + 1)*.5*cells + .5) ;
+   }
+
+/*------------------------------------------------------------
+ * Sort the rays by direction bin and then by a Morton code of
+ * the five numbers left: the two cone cells and the quantized
+ * origin. The bits are interleaved most significant first, so
+ * rays that share a packet agree in both where they start and
+ * where they point, as far as the ray count allows.
+ */
+void RayStream::sort(Ray const* rays, int n) {
+   Bounds b ;
+   for (int i = 0 ; i < n ; i++)
+      b.extend(rays[i].origin) ;
+   const Vector3 e = b.extent() ;
+   const scalar cells = (1 << ORIGIN_BITS) - 1 ;
+   const Vector3 scale(e.x > 0 ? cells/e.x : 0, e.y > 0 ? cells/e.y : 0, e.z > 0 ? cells/e.z : 0) ;
+
+   keys.resize(n) ;
+   for (int i = 0 ; i < n ; i++) {
+      const Vector3 q = (rays[i].origin - b.lo) * scale ;
+      unsigned long c[5] = { 0, 0, (unsigned long)q.x, (unsigned long)q.y, (unsigned long)q.z } ;
+      cone(rays[i].direction, c[0], c[1]) ;
+
+      unsigned long long key = octant(rays[i].direction) ;
+      for (int bit = DIRECTION_BITS - 1 ; bit >= 0 ; bit--)
+         for (int k = 0 ; k < 5 ; k++)
+            if (k < 2 || bit < ORIGIN_BITS)
+               key = key << 1 | ((c[k] >> bit) & 1) ;
+      keys[i] = key << 32 | (unsigned)i ;
+      }
+   std::sort(keys.begin(), keys.end()) ;
+
+   sorted.resize(n) ;
+   for (int i = 0 ; i < n ; i++)
+      sorted[i] = rays[keys[i] & 0xFFFFFFFF] ;
+   }
+
+Ray const* RayStream::gather(Position const* origins, Direction const* directions,
+                             int n, scalar tmin, scalar tmax) {
+   input.resize(n) ;
+   for (int i = 0 ; i < n ; i++)
+      input[i] = Ray(origins[i], directions[i], tmin, tmax) ;
+   return n ? &input[0] : 0 ;
+   }
+
+void RayStream::trace(Traceable const& target, Ray const* rays, Hit* hits, int n) {
+   Hit h[RAY_PACKET] ;
+
+   sort(rays, n) ;
+   for (int i = 0 ; i < n ; i += packetSize) {
+      const int m = MIN(packetSize, n - i) ;
+      target.intersectPacket(&sorted[i], h, m, &counts) ;
+      for (int k = 0 ; k < m ; k++)
+         hits[keys[i+k] & 0xFFFFFFFF] = h[k] ;
+      }
+   }
+
+void RayStream::trace(Traceable const& target, Position const* origins,
+                      Direction const* directions, Hit* hits, int n,
+                      scalar tmin, scalar tmax) {
+   trace(target, gather(origins, directions, n, tmin, tmax), hits, n) ;
+   }
+
+void RayStream::occluded(Traceable const& target, Ray const* rays, bool* blocked, int n) {
+   bool b[RAY_PACKET] ;
+
+   sort(rays, n) ;
+   for (int i = 0 ; i < n ; i += packetSize) {
+      const int m = MIN(packetSize, n - i) ;
+      target.occludedPacket(&sorted[i], b, m, &counts) ;
+      for (int k = 0 ; k < m ; k++)
+         blocked[keys[i+k] & 0xFFFFFFFF] = b[k] ;
+      }
+   }
+
+void RayStream::occluded(Traceable const& target, Position const* origins,
+                         Direction const* directions, bool* blocked, int n,
+                         scalar tmin, scalar tmax) {
+   occluded(target, gather(origins, directions, n, tmin, tmax), blocked, n) ;
+   }
+
+void RayStream::report(FILE* out) const {
+   if (!out)
+      return ;
+   fprintf(out, "rays %ld  packets %ld (%.1f rays each)  node visits %ld  SIMD utilization %.1f%%\n",
+           counts.rays, counts.packets,
+           counts.packets ? (double)counts.rays/counts.packets : 0.,
+           counts.visits, 100*counts.utilization()) ;
+   }
@@ -0,0 +1,230 @@
+/* -------- Sampling.cpp -----------
+
+   Monte Carlo Sampling
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <stdint.h>
+#include <stdexcept>
+#include <Sampling.h>
+#include <Frame.h>
+#include <VMath.h>
+
+			// Scratch arrays for the vector math calls are this long.
+static const int CHUNK = 256 ;
+			// 2^-32: an unsigned 32 bit number to [0,1).
+static const scalar UNIT32 = 1./4294967296. ;
+
+/*------------------------------------------------------------
+ * A 32 bit integer hash with good avalanche (Wellons' lowbias32).
+ * Only 32 bit multiplies, so it vectorizes on any SIMD target.
+ */
+static inline uint32_t mix32(uint32_t x) {
+   x ^= x >> 16 ;
+   x *= 0x7FEB352Du ;
+   x ^= x >> 15 ;
+   x *= 0x846CA68Bu ;
+   x ^= x >> 16 ;
+   return x ;
+   }
+
+/*------------------------------------------------------------
+ * Number i of the stream is two rounds of the hash of the low
+ * word of i, keyed by the seed and the high word.
+ */
+void RandomStream::uniform(scalar* out, int n) {
+   const uint32_t k1 = mix32(seed ^ 0x9E3779B9u) ;
+   while (n > 0) {
+      const uint32_t lo = (uint32_t)counter ;
+      const uint32_t k2 = mix32(k1 + (uint32_t)(counter >> 32)) ;
+      // stop where the low word wraps, so that k2 holds for the loop
+      const int m = (int)MIN((unsigned long long)n, 0x100000000ull - lo) ;
+
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++)
+         out[i] = mix32(mix32((lo + (uint32_t)i) ^ k1) + k2) * UNIT32 ;
+      counter += m ;
+      out += m ;
+      n -= m ;
+      }
+   }
+
+scalar RandomStream::uniform() {
+   scalar u ;
+   uniform(&u, 1) ;
+   return u ;
+   }
+
+/** -----------------------------------------------------------
+ * Sobol dimension 1 is the base 2 radical inverse (the bits of
+ * the index reversed); dimension 2 XORs together the direction
+ * numbers v[k] = v[k-1] ^ (v[k-1] >> 1) for the set bits of the
+ * index. Both written without branches.
+ **/
+void sobol2D(unsigned index, scalar* u1, scalar* u2, int n,
+             unsigned scramble1, unsigned scramble2) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++) {
+      const uint32_t x = index + (uint32_t)i ;
+      uint32_t r = x ;
+      r = (r << 16) | (r >> 16) ;
+      r = ((r & 0x00FF00FFu) << 8) | ((r & 0xFF00FF00u) >> 8) ;
+      r = ((r & 0x0F0F0F0Fu) << 4) | ((r & 0xF0F0F0F0u) >> 4) ;
+      r = ((r & 0x33333333u) << 2) | ((r & 0xCCCCCCCCu) >> 2) ;
+      r = ((r & 0x55555555u) << 1) | ((r & 0xAAAAAAAAu) >> 1) ;
+
+      uint32_t s = 0, v = 0x80000000u ;
+      for (int k = 0 ; k < 32 ; k++) {
+         s ^= v & (0u - ((x >> k) & 1u)) ;
+         v ^= v >> 1 ;
+         }
+      u1[i] = (r ^ scramble1) * UNIT32 ;
+      u2[i] = (s ^ scramble2) * UNIT32 ;
+      }
+   }
+
+void halton(int base, unsigned index, scalar* out, int n) {
+   if (base < 2)
+      throw std::invalid_argument("halton: base must be at least 2") ;
+   const scalar inv = 1./base ;
+   for (int i = 0 ; i < n ; i++) {
+      unsigned x = index + (unsigned)i ;
+      scalar r = 0, f = inv ;
+      while (x) {
+         r += (x % base) * f ;
+         x /= base ;
+         f *= inv ;
+         }
+      out[i] = r ;
+      }
+   }
+
+void stratified(int nx, int ny, RandomStream& rng, scalar* u1, scalar* u2) {
+   const int n = nx*ny ;
+   rng.uniform(u1, n) ;
+   rng.uniform(u2, n) ;
+   const scalar dx = 1./nx, dy = 1./ny ;
+   for (int j = 0 ; j < ny ; j++)
+      for (int i = 0 ; i < nx ; i++) {
+         u1[j*nx + i] = (i + u1[j*nx + i]) * dx ;
+         u2[j*nx + i] = (j + u2[j*nx + i]) * dy ;
+         }
+   }
+
+/** -----------------------------------------------------------
+ * z = cos(theta) = 1 - 2 u1 uniform in (-1,1] for u1 in [0,1)
+ * (Archimedes), phi uniform.
+ **/
+void sampleSphere(scalar const* u1, scalar const* u2,
+                  Vector3SoA const& out, int n) {
+   scalar phi[CHUNK], s[CHUNK], c[CHUNK] ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++)
+         phi[i] = 2*PI*u2[i0 + i] ;
+      vsincos(phi, s, c, m) ;
+
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++) {
+         const scalar z = 1 - 2*u1[i0 + i] ;
+         const scalar r = sqrt(MAX(0., 1 - z*z)) ;
+         out.x[i0 + i] = r*c[i] ;
+         out.y[i0 + i] = r*s[i] ;
+         out.z[i0 + i] = z ;
+         }
+      }
+   }
+
+void sampleHemisphere(Direction const& normal, scalar const* u1, scalar const* u2,
+                      Vector3SoA const& out, int n) {
+   scalar phi[CHUNK], s[CHUNK], c[CHUNK] ;
+   const Frame frame(normal) ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++)
+         phi[i] = 2*PI*u2[i0 + i] ;
+      vsincos(phi, s, c, m) ;
+
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++) {
+         const scalar z = u1[i0 + i] ;
+         const scalar r = sqrt(MAX(0., 1 - z*z)) ;
+         c[i] *= r ;
+         s[i] *= r ;
+         phi[i] = z ;
+         }
+      toWorldBatch(frame, Vector3SoA(c, s, phi), out + i0, m) ;
+      }
+   }
+
+/*------------------------------------------------------------
+ * Shirley & Chiu's concentric map of the square to the disk as
+ * a radius and an angle, without branches: the square's point
+ * (a, b) in [-1,1)^2 goes to radius a at angle PI/4 * b/a when
+ * |a| > |b|, else to radius b at PI/2 - PI/4 * a/b.
+ */
+static inline void concentric(scalar u1, scalar u2, scalar& r, scalar& phi) {
+   const scalar a = 2*u1 - 1, b = 2*u2 - 1 ;
+   const bool wide = ABS(a) > ABS(b) ;
+   r = wide ? a : b ;
+   const scalar num = wide ? b : a ;
+   const scalar den = (r != 0) ? r : 1 ;
+   phi = wide ? (PI/4)*(num/den) : PI/2 - (PI/4)*(num/den) ;
+   }
+
+void sampleDisk(scalar const* u1, scalar const* u2,
+                Vector2SoA const& out, int n) {
+   scalar r[CHUNK], phi[CHUNK], s[CHUNK], c[CHUNK] ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++)
+         concentric(u1[i0 + i], u2[i0 + i], r[i], phi[i]) ;
+      vsincos(phi, s, c, m) ;
+
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++) {
+         out.x[i0 + i] = r[i]*c[i] ;
+         out.y[i0 + i] = r[i]*s[i] ;
+         }
+      }
+   }
+
+/** -----------------------------------------------------------
+ * Malley's method: a uniform point on the disk lifted to the
+ * hemisphere.
+ **/
+void sampleHemisphereCosine(Direction const& normal, scalar const* u1, scalar const* u2,
+                            Vector3SoA const& out, int n) {
+   scalar r[CHUNK], phi[CHUNK], s[CHUNK], c[CHUNK] ;
+   const Frame frame(normal) ;
+
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++)
+         concentric(u1[i0 + i], u2[i0 + i], r[i], phi[i]) ;
+      vsincos(phi, s, c, m) ;
+
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++) {
+         c[i] *= r[i] ;
+         s[i] *= r[i] ;
+         r[i] = sqrt(MAX(0., 1 - r[i]*r[i])) ;
+         }
+      toWorldBatch(frame, Vector3SoA(c, s, r), out + i0, m) ;
+      }
+   }
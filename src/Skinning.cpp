@@ -0,0 +1,151 @@
+/* -------- Skinning.cpp -----------
+
+   Skinning (Vertex Blending)
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <Skinning.h>
+#include <Parallel.h>
+
+			// Vertices per parallel chunk.
+static const int GRAIN = 4096 ;
+
+DualQuaternion::DualQuaternion(Transform const& mx)
+   : real(mx), dual() {
+   real.norm() ;
+   *this = DualQuaternion(real, Vector3(mx.xform[3][0], mx.xform[3][1], mx.xform[3][2])) ;
+   }
+
+/*------------------------------------------------------------
+ * The blends below run at SIMD width across the coefficients
+ * of one vertex (12 for a matrix, 8 for a dual quaternion), not
+ * across vertices: that would take a gather per coefficient per
+ * influence, which is slower than the scalar loads.
+ */
+
+/*------------------------------------------------------------
+ * Linear blend: the weighted sum of the joint matrices, applied
+ * to the position and (its linear part) to the normal. The
+ * normal is renormalized; with non-uniform scale in the palette
+ * it is only approximately perpendicular to the surface.
+ */
+template <bool normals>
+static void skinLinear(Affine3 const* palette, int const* joints,
+                       scalar const* weights, Vector3SoA const& p,
+                       Vector3SoA const& n, Vector3SoA const& op,
+                       Vector3SoA const& on, int begin, int end) {
+   for (int i = begin ; i < end ; i++) {
+      scalar m[12] = { 0 } ;
+      for (int k = 0 ; k < SKIN_INFLUENCES ; k++) {
+         scalar const* a = &palette[joints[SKIN_INFLUENCES*i + k]].xform[0][0] ;
+         const scalar w = weights[SKIN_INFLUENCES*i + k] ;
+         for (int e = 0 ; e < 12 ; e++)
+            m[e] += w*a[e] ;
+         }
+
+      const scalar x = p.x[i], y = p.y[i], z = p.z[i] ;
+      op.x[i] = x*m[0] + y*m[3] + z*m[6] + m[9] ;
+      op.y[i] = x*m[1] + y*m[4] + z*m[7] + m[10] ;
+      op.z[i] = x*m[2] + y*m[5] + z*m[8] + m[11] ;
+
+      if (normals) {
+         const scalar nx = n.x[i], ny = n.y[i], nz = n.z[i] ;
+         const scalar sx = nx*m[0] + ny*m[3] + nz*m[6] ;
+         const scalar sy = nx*m[1] + ny*m[4] + nz*m[7] ;
+         const scalar sz = nx*m[2] + ny*m[5] + nz*m[8] ;
+         const scalar l = sqrt(sx*sx + sy*sy + sz*sz) ;
+         const scalar r = (l != 0) ? 1/l : 0 ;
+         on.x[i] = sx*r ;
+         on.y[i] = sy*r ;
+         on.z[i] = sz*r ;
+         }
+      }
+   }
+
+void skinLinear(Affine3 const* palette, int const* joints, scalar const* weights,
+                Vector3SoA const& positions, Vector3SoA const& normals,
+                Vector3SoA const& outPositions, Vector3SoA const& outNormals,
+                int n) {
+   const bool both = normals.x && outNormals.x ;
+   parallelFor(n, GRAIN, [&](int begin, int end) {
+      if (both)
+         skinLinear<true>(palette, joints, weights, positions, normals,
+                          outPositions, outNormals, begin, end) ;
+      else
+         skinLinear<false>(palette, joints, weights, positions, normals,
+                           outPositions, outNormals, begin, end) ;
+      }) ;
+   }
+
+/*------------------------------------------------------------
+ * Dual quaternion blend (DLB): the weighted sum, with each joint
+ * flipped into the hemisphere of the first so that q and -q do
+ * not cancel, divided by the length of its real part. Then the
+ * rotation and translation of the result are applied.
+ */
+template <bool normals>
+static void skinDualQuaternion(DualQuaternion const* palette, int const* joints,
+                               scalar const* weights, Vector3SoA const& p,
+                               Vector3SoA const& n, Vector3SoA const& op,
+                               Vector3SoA const& on, int begin, int end) {
+   for (int i = begin ; i < end ; i++) {
+      scalar b[8] = { 0 } ;
+      Quaternion const& q0 = palette[joints[SKIN_INFLUENCES*i]].real ;
+      for (int k = 0 ; k < SKIN_INFLUENCES ; k++) {
+         DualQuaternion const& q = palette[joints[SKIN_INFLUENCES*i + k]] ;
+         const scalar d = q.real.w*q0.w + q.real.x*q0.x + q.real.y*q0.y + q.real.z*q0.z ;
+         const scalar w = (d < 0) ? -weights[SKIN_INFLUENCES*i + k] : weights[SKIN_INFLUENCES*i + k] ;
+         b[0] += w*q.real.w ; b[1] += w*q.real.x ; b[2] += w*q.real.y ; b[3] += w*q.real.z ;
+         b[4] += w*q.dual.w ; b[5] += w*q.dual.x ; b[6] += w*q.dual.y ; b[7] += w*q.dual.z ;
+         }
+
+      const scalar l = sqrt(b[0]*b[0] + b[1]*b[1] + b[2]*b[2] + b[3]*b[3]) ;
+      const scalar s = (l != 0) ? 1/l : 0 ;
+      const scalar rw = b[0]*s, rx = b[1]*s, ry = b[2]*s, rz = b[3]*s ;
+      const scalar dw = b[4]*s, dx = b[5]*s, dy = b[6]*s, dz = b[7]*s ;
+
+      // translation: 2 (rw d - dw r + r x d), vector parts
+      const scalar tx = 2*(rw*dx - dw*rx + ry*dz - rz*dy) ;
+      const scalar ty = 2*(rw*dy - dw*ry + rz*dx - rx*dz) ;
+      const scalar tz = 2*(rw*dz - dw*rz + rx*dy - ry*dx) ;
+
+      // rotation: v + 2w (r x v) + r x 2(r x v), as Quaternion::rotate()
+      scalar x = p.x[i], y = p.y[i], z = p.z[i] ;
+      scalar cx = 2*(ry*z - rz*y), cy = 2*(rz*x - rx*z), cz = 2*(rx*y - ry*x) ;
+      op.x[i] = x + rw*cx + (ry*cz - rz*cy) + tx ;
+      op.y[i] = y + rw*cy + (rz*cx - rx*cz) + ty ;
+      op.z[i] = z + rw*cz + (rx*cy - ry*cx) + tz ;
+
+      if (normals) {
+         x = n.x[i] ; y = n.y[i] ; z = n.z[i] ;
+         cx = 2*(ry*z - rz*y) ; cy = 2*(rz*x - rx*z) ; cz = 2*(rx*y - ry*x) ;
+         on.x[i] = x + rw*cx + (ry*cz - rz*cy) ;
+         on.y[i] = y + rw*cy + (rz*cx - rx*cz) ;
+         on.z[i] = z + rw*cz + (rx*cy - ry*cx) ;
+         }
+      }
+   }
+
+void skinDualQuaternion(DualQuaternion const* palette, int const* joints,
+                        scalar const* weights,
+                        Vector3SoA const& positions, Vector3SoA const& normals,
+                        Vector3SoA const& outPositions, Vector3SoA const& outNormals,
+                        int n) {
+   const bool both = normals.x && outNormals.x ;
+   parallelFor(n, GRAIN, [&](int begin, int end) {
+      if (both)
+         skinDualQuaternion<true>(palette, joints, weights, positions, normals,
+                                  outPositions, outNormals, begin, end) ;
+      else
+         skinDualQuaternion<false>(palette, joints, weights, positions, normals,
+                                   outPositions, outNormals, begin, end) ;
+      }) ;
+   }
@@ -0,0 +1,319 @@
+/* -------- VMath.cpp -----------
+
+   Vector Math (Bulk Elementary Functions)
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+   The polynomials are those of the Cephes Math Library
+   (S. L. Moshier): sin.c, sinf.c, atan.c and atanf.c. Cephes picks
+   the polynomial with a branch on the octant; here both are
+   evaluated and the quadrant selects between them, which is cheaper
+   than a branch once the loop runs several lanes at a time.
+
+   Arrays are processed in chunks: the arguments of a chunk are
+   copied aside first so that out may overwrite in and the few
+   out-of-range arguments can still be handed to libm afterwards.
+
+*/
+
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __AVX__
+#include <immintrin.h>
+#endif
+#include <Vector.h>
+#include <Simd.h>
+#include <VMath.h>
+
+static const int CHUNK = 256 ;
+
+/*------------------------------------------------------------
+ * Double precision.
+ */
+			// Arguments of at least this size are reduced by libm.
+static const double SINCOS_LIMIT = 1e8 ;
+			// Adding and subtracting 1.5 * 2^52 rounds to an integer.
+static const double ROUND_MAGIC = 6755399441055744.0 ;
+
+static const double TWO_OVER_PI = 6.36619772367581343076E-1 ;
+			// PI/2 in three parts (Cody & Waite)
+static const double DP1 = 1.57079625129699707031E0 ;
+static const double DP2 = 7.54978941586159635335E-8 ;
+static const double DP3 = 5.39030285815811905290E-15 ;
+
+			// The integer q mod 4, from the low bits of sum = q + ROUND_MAGIC. Unlike
+			// (int)q it is defined for the huge, infinite and NaN lanes libm redoes.
+static inline int quadrantOf(double sum) {
+   unsigned long long bits ;
+   memcpy(&bits, &sum, sizeof(bits)) ;
+   return (int)(bits & 3) ;
+   }
+
+static inline void sincosKernel(double x, double& s, double& c) {
+   const double sum = x*TWO_OVER_PI + ROUND_MAGIC ;
+   const double q = sum - ROUND_MAGIC ;
+   const int quadrant = quadrantOf(sum) ;
+   const double r = ((x - q*DP1) - q*DP2) - q*DP3 ;   // |r| <= PI/4
+   const double z = r*r ;
+
+   double ps = r + r*z*((((( 1.58962301576546568060E-10 *z
+                                 - 2.50507477628578072866E-8) *z
+                                 + 2.75573136213857245213E-6) *z
+                                 - 1.98412698295895385996E-4) *z
+                                 + 8.33333333332211858878E-3) *z
+                                 - 1.66666666666666307295E-1) ;
+   ps = (r != 0) ? ps : r ;                         // sin(-0) = -0
+   const double pc = 1 - 0.5*z + z*z*(((((-1.13585365213876817300E-11 *z
+                                        + 2.08757008419747316778E-9) *z
+                                        - 2.75573141792967388112E-7) *z
+                                        + 2.48015872888517045348E-5) *z
+                                        - 1.38888888888730564116E-3) *z
+                                        + 4.16666666666665929218E-2) ;
+
+   // Quadrant 0: ( sin,  cos)   1: ( cos, -sin)
+   //          2: (-sin, -cos)   3: (-cos,  sin)
+   const bool swap = (quadrant & 1) != 0 ;
+   s = (swap ? pc : ps) * ((quadrant & 2) ? -1. : 1.) ;
+   c = (swap ? ps : pc) * (((quadrant + 1) & 2) ? -1. : 1.) ;
+   }
+
+static inline double atanKernel(double a) {        // 0 <= a <= 1
+   const double PIO4 = 7.85398163397448309616E-1 ;
+   const double MOREBITS = 6.123233995736765886130E-17 ;
+
+   const bool reduce = a > 0.66 ;
+   const double x = reduce ? (a - 1)/(a + 1) : a ;
+   const double z = x*x ;
+   const double p = ((((-8.750608600031904122785E-1 *z
+                        - 1.615753718733365076637E1) *z
+                        - 7.500855792314704667340E1) *z
+                        - 1.228866684490136173410E2) *z
+                        - 6.485021904942025371773E1) ;
+   const double q = (((((z + 2.485846490142306297962E1) *z
+                           + 1.650270098316988542046E2) *z
+                           + 4.328810604912902668951E2) *z
+                           + 4.853903996359136964868E2) *z
+                           + 1.945506571482613964425E2) ;
+   const double y = x*z*p/q + x ;
+   return reduce ? PIO4 + (y + 0.5*MOREBITS) : y ;
+   }
+
+static inline double atan2Kernel(double y, double x) {
+   const double PIO2 = 1.57079632679489661923E0 ;
+   const double MOREBITS = 6.123233995736765886130E-17 ;
+
+   const double ax = fabs(x), ay = fabs(y) ;
+   const double hi = MAX(ax, ay), lo = MIN(ax, ay) ;
+   double r = atanKernel(lo / (hi != 0 ? hi : 1)) ;
+   r = (ay > ax) ? PIO2 - (r - MOREBITS) : r ;
+   r = (copysign(1., x) < 0) ? 2*PIO2 - (r - 2*MOREBITS) : r ;
+   return copysign(r, y) ;
+   }
+
+void vsincos(double const* in, double* s, double* c, int n) {
+   double x[CHUNK] ;
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      double* RESTRICT so = s + i0 ;
+      double* RESTRICT co = c + i0 ;
+      for (int i = 0 ; i < m ; i++)
+         x[i] = in[i0 + i] ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++)
+         sincosKernel(x[i], so[i], co[i]) ;
+      for (int i = 0 ; i < m ; i++)
+         if (!(fabs(x[i]) < SINCOS_LIMIT)) {
+            so[i] = sin(x[i]) ;
+            co[i] = cos(x[i]) ;
+            }
+      }
+   }
+
+void vsin(double const* in, double* out, int n) {
+   double x[CHUNK] ;
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      double* o = out + i0 ;
+      for (int i = 0 ; i < m ; i++)
+         x[i] = in[i0 + i] ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++) {
+         double c ;
+         sincosKernel(x[i], o[i], c) ;
+         }
+      for (int i = 0 ; i < m ; i++)
+         if (!(fabs(x[i]) < SINCOS_LIMIT))
+            o[i] = sin(x[i]) ;
+      }
+   }
+
+void vcos(double const* in, double* out, int n) {
+   double x[CHUNK] ;
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      double* o = out + i0 ;
+      for (int i = 0 ; i < m ; i++)
+         x[i] = in[i0 + i] ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++) {
+         double s ;
+         sincosKernel(x[i], s, o[i]) ;
+         }
+      for (int i = 0 ; i < m ; i++)
+         if (!(fabs(x[i]) < SINCOS_LIMIT))
+            o[i] = cos(x[i]) ;
+      }
+   }
+
+void vatan2(double const* y, double const* x, double* out, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++)
+      out[i] = atan2Kernel(y[i], x[i]) ;
+   }
+
+void vsqrt(double const* in, double* out, int n) {
+   int i = 0 ;
+#if defined(__AVX__)
+   for ( ; i + 4 <= n ; i += 4)
+      _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_loadu_pd(in + i))) ;
+#elif defined(__SSE2__)
+   for ( ; i + 2 <= n ; i += 2)
+      _mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_loadu_pd(in + i))) ;
+#endif
+   for ( ; i < n ; i++)
+      out[i] = sqrt(in[i]) ;
+   }
+
+/*------------------------------------------------------------
+ * Single precision.
+ */
+static const float SINCOS_LIMITF = 8192 ;
+
+			// The argument is reduced in double: a float reduction loses
+			// all relative accuracy near the zeros of sin and cos.
+static inline void sincosKernel(float x, float& s, float& c) {
+   const double xd = x ;
+   const double sum = xd*TWO_OVER_PI + ROUND_MAGIC ;
+   const double q = sum - ROUND_MAGIC ;
+   const int quadrant = quadrantOf(sum) ;
+   const float r = (float)(((xd - q*DP1) - q*DP2) - q*DP3) ;
+   const float z = r*r ;
+
+   float ps = ((-1.9515295891E-4f *z
+               + 8.3321608736E-3f) *z
+               - 1.6666654611E-1f) *z*r + r ;
+   ps = (r != 0) ? ps : r ;
+   const float pc = (( 2.443315711809948E-5f *z
+                     - 1.388731625493765E-3f) *z
+                     + 4.166664568298827E-2f) *z*z - 0.5f*z + 1 ;
+
+   const bool swap = (quadrant & 1) != 0 ;
+   s = (swap ? pc : ps) * ((quadrant & 2) ? -1.f : 1.f) ;
+   c = (swap ? ps : pc) * (((quadrant + 1) & 2) ? -1.f : 1.f) ;
+   }
+
+static inline float atanKernel(float a) {           // 0 <= a <= 1
+   const float PIO4 = 7.853981633974483096E-1f ;
+
+   const bool reduce = a > 0.4142135623730950f ;
+   const float x = reduce ? (a - 1)/(a + 1) : a ;
+   const float z = x*x ;
+   const float y = ((( 8.05374449538E-2f *z
+                     - 1.38776856032E-1f) *z
+                     + 1.99777106478E-1f) *z
+                     - 3.33329491539E-1f) *z*x + x ;
+   return reduce ? PIO4 + y : y ;
+   }
+
+static inline float atan2Kernel(float y, float x) {
+   const float PIO2 = 1.5707963267948966192E0f ;
+
+   const float ax = fabsf(x), ay = fabsf(y) ;
+   const float hi = MAX(ax, ay), lo = MIN(ax, ay) ;
+   float r = atanKernel(lo / (hi != 0 ? hi : 1)) ;
+   r = (ay > ax) ? PIO2 - r : r ;
+   r = (copysignf(1.f, x) < 0) ? 2*PIO2 - r : r ;
+   return copysignf(r, y) ;
+   }
+
+void vsincos(float const* in, float* s, float* c, int n) {
+   float x[CHUNK] ;
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      float* RESTRICT so = s + i0 ;
+      float* RESTRICT co = c + i0 ;
+      for (int i = 0 ; i < m ; i++)
+         x[i] = in[i0 + i] ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++)
+         sincosKernel(x[i], so[i], co[i]) ;
+      for (int i = 0 ; i < m ; i++)
+         if (!(fabsf(x[i]) < SINCOS_LIMITF)) {
+            so[i] = sinf(x[i]) ;
+            co[i] = cosf(x[i]) ;
+            }
+      }
+   }
+
+void vsin(float const* in, float* out, int n) {
+   float x[CHUNK] ;
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      float* o = out + i0 ;
+      for (int i = 0 ; i < m ; i++)
+         x[i] = in[i0 + i] ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++) {
+         float c ;
+         sincosKernel(x[i], o[i], c) ;
+         }
+      for (int i = 0 ; i < m ; i++)
+         if (!(fabsf(x[i]) < SINCOS_LIMITF))
+            o[i] = sinf(x[i]) ;
+      }
+   }
+
+void vcos(float const* in, float* out, int n) {
+   float x[CHUNK] ;
+   for (int i0 = 0 ; i0 < n ; i0 += CHUNK) {
+      const int m = MIN(CHUNK, n - i0) ;
+      float* o = out + i0 ;
+      for (int i = 0 ; i < m ; i++)
+         x[i] = in[i0 + i] ;
+      SIMD_LOOP
+      for (int i = 0 ; i < m ; i++) {
+         float s ;
+         sincosKernel(x[i], s, o[i]) ;
+         }
+      for (int i = 0 ; i < m ; i++)
+         if (!(fabsf(x[i]) < SINCOS_LIMITF))
+            o[i] = cosf(x[i]) ;
+      }
+   }
+
+void vatan2(float const* y, float const* x, float* out, int n) {
+   SIMD_LOOP
+   for (int i = 0 ; i < n ; i++)
+      out[i] = atan2Kernel(y[i], x[i]) ;
+   }
+
+void vsqrt(float const* in, float* out, int n) {
+   int i = 0 ;
+#if defined(__AVX__)
+   for ( ; i + 8 <= n ; i += 8)
+      _mm256_storeu_ps(out + i, _mm256_sqrt_ps(_mm256_loadu_ps(in + i))) ;
+#elif defined(__SSE2__)
+   for ( ; i + 4 <= n ; i += 4)
+      _mm_storeu_ps(out + i, _mm_sqrt_ps(_mm_loadu_ps(in + i))) ;
+#endif
+   for ( ; i < n ; i++)
+      out[i] = sqrtf(in[i]) ;
+   }
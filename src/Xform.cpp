@@ -12,237 +12,12 @@
 
 */
 
-#include "vector.h"
-
-Vector4::Vector4() {
-   x = y = z = w = 0 ;
-   }
-
-Vector4::Vector4(scalar a, scalar b, scalar c, scalar d) {
-   x = a ;
-   y = b ;
-   z = c ;
-   w = d ;
-   }
-
-Vector4::operator Vector3() const {
-   return Vector3(x,y,z) ;
-   }
-
-Vector4::operator Position() const {
-   if (w != 0)
-      return Position(x/w,y/w,z/w) ;
-   else
-      return Position(x,y,z) ;
-   }
+#include <Vector.h>
 
 Vector4::operator Direction() const {
    return Direction(x,y,z) ;
    }
 
-Vector4& Vector4::set(scalar a, scalar b,
-                  scalar c, scalar d) {
-   x = a ;
-   y = b ;
-   z = c ;
-   w = d ;
-   return *this ;
-   }
-
-scalar Vector4::dot(Vector4 const& v) const {
-   return x*v.x + y*v.y + z*v.z + w*v.w ;
-   }
-
-Vector4 Vector4::stdz() {
-   if (w != 0) {
-      x /= w ;
-      y /= w ;
-      z /= w ;
-      }
-   w = 1 ;
-   return *this ;
-   }
-
-Vector4 VectorH(Vector3 const& v) {
-   return Vector4(v.x,v.y,v.z,0) ;
-   }
-Vector4 VectorH(Position const& p) {
-   return Vector4(p.x,p.y,p.z,1) ;
-   }
-Vector4 VectorH(Direction const& d) {
-   return Vector4(d.x, d.y,d.z,0) ;
-   }
-
-
-/* -----------------------------------------------------------
- *  Create an identity transform matrix.
- */
-Transform::Transform() {
-   Identity() ;
-   }
-
-/* -----------------------------------------------------------
- *  Create a transform matrix from another
- */
-Transform::Transform(Transform const& mx) {
-   for (int i = 0 ; i < 4 ; i++)
-      for (int j = 0 ; j < 4 ; j++ )
-         xform[i][j] = mx.xform[i][j] ;
-   }
-
-
-/* -----------------------------------------------------------
- *  Create a transform matrix from 4 row vectors.
- */
-Transform::Transform(Vector4 const& r0, Vector4 const& r1,
-                     Vector4 const& r2, Vector4 const& r3) {
-   xform[0][0] = r0.x ;
-   xform[0][1] = r0.y ;
-   xform[0][2] = r0.z ;
-   xform[0][3] = r0.w ;
-
-   xform[1][0] = r1.x ;
-   xform[1][1] = r1.y ;
-   xform[1][2] = r1.z ;
-   xform[1][3] = r1.w ;
-
-   xform[2][0] = r2.x ;
-   xform[2][1] = r2.y ;
-   xform[2][2] = r2.z ;
-   xform[2][3] = r2.w ;
-
-   xform[3][0] = r3.x ;
-   xform[3][1] = r3.y ;
-   xform[3][2] = r3.z ;
-   xform[3][3] = r3.w ;
-
-   }
-
-/* -----------------------------------------------------------
- *  Create a transform matrix from 4 row vectors.
- */
-Transform::Transform(Vector3 const& r0, Vector3 const& r1,
-                     Vector3 const& r2, Vector3 const& r3) {
-   xform[0][0] = r0.x ;
-   xform[0][1] = r0.y ;
-   xform[0][2] = r0.z ;
-   xform[0][3] = 0 ;
-
-   xform[1][0] = r1.x ;
-   xform[1][1] = r1.y ;
-   xform[1][2] = r1.z ;
-   xform[1][3] = 0 ;
-
-   xform[2][0] = r2.x ;
-   xform[2][1] = r2.y ;
-   xform[2][2] = r2.z ;
-   xform[2][3] = 0 ;
-
-   xform[3][0] = r3.x ;
-   xform[3][1] = r3.y ;
-   xform[3][2] = r3.z ;
-   xform[3][3] = 1 ;
-
-   }
-
-/* -----------------------------------------------------------
- *  Set a transform to an identity matrix.
- */
-void Transform::Identity() {
-     for (int i = 0 ; i < 4 ; i++ ) {
-         for (int j = 0 ; j < 4 ; j++ )
-            xform[i][j] = 0 ;
-         xform[i][i] = 1 ;
-         }
-     }
-
-/* -----------------------------------------------------------
- * Extract a column vector.
- */
-Vector4 Transform::col(int c) const {
-   Vector4 v(xform[0][c], xform[1][c], xform[2][c], xform[3][c]) ;
-   return v ;
-   }
-
-/* -----------------------------------------------------------
- * Extract a row vector.
- */
-Vector4 Transform::row(int r) const {
-   return Vector4(xform[r][0],xform[r][1],xform[r][2],xform[r][3]) ;
-   }
-
-
-/* -----------------------------------------------------------
- * Set a row vector.
- */
-Transform Transform::setRow(int r, Vector4 const& v) {
-	xform[r][0] = v.x ;
-	xform[r][1] = v.y ;
-	xform[r][2] = v.z ;
-	xform[r][3] = v.w ;
-	return *this ;
-}
-Transform Transform::setRow(int r, Vector3 const& v) {
-	xform[r][0] = v.x ;
-	xform[r][1] = v.y ;
-	xform[r][2] = v.z ;
-	xform[r][3] = 0. ;
-	return *this ;
-}
-/* -----------------------------------------------------------
- * Set a column vector.
- */
-Transform Transform::setCol(int c, Vector4 const& v) {
-	xform[0][c] = v.x ;
-	xform[1][c] = v.y ;
-	xform[2][c] = v.z ;
-	xform[3][c] = v.z ;
-	return *this ;
-}
-Transform Transform::setCol(int c, Vector3 const& v) {
-	xform[0][c] = v.x ;
-	xform[1][c] = v.y ;
-	xform[2][c] = v.z ;
-	xform[3][c] = 0. ;
-	return *this ;
-}
-
-/** -----------------------------------------------------------
- * Multiply a transform matrix times a (column) vector.
- **/
-Vector4 Transform::operator*(Vector4 const& v) const {
-   Vector4 vrow[4] ;
-   for (int i=0 ; i < 4 ; i++)
-      vrow[i].set(xform[i][0],
-                  xform[i][1],
-                  xform[i][2],
-                  xform[i][3]) ;
-   Vector4 vres(vrow[0].dot(v),vrow[1].dot(v),vrow[2].dot(v),vrow[3].dot(v)) ;
-   return vres ;
-   }
-
-/** -----------------------------------------------------------
- * Transform a vector. (Multiply a row vector times
- * a transform matrix.)
- **/
-Vector4 operator*(Vector4 const& v, Transform const& mx) {
-   Vector4 vr(v.dot(mx.col(0)),
-               v.dot(mx.col(1)),
-               v.dot(mx.col(2)),
-               v.dot(mx.col(3))) ;
-   return vr ;
-   }
-
-/** -----------------------------------------------------------
- * Post transform a position vector. (Multiply a transform
- * matrix times a column vector.) We create a temporary
- * Vector4 from the position vector where the homogeneous
- * coordinate is 1.
- **/
-Position Transform::operator*(Position const& p) const {
-   return (*this * (VectorH(p))) ;
-   }
-
 /** -----------------------------------------------------------
  * Post transform a direction vector. (Multiply a transform
  * matrix times a column vector.) We create a temporary
@@ -253,16 +28,6 @@ Direction Transform::operator*(Direction const& d) const {
    return (*this * (VectorH(d))) ;
    }
 
-/** -----------------------------------------------------------
- * Transform a position vector. (Multiply a row vector
- * times a transform matrix.) We create a temporary
- * Vector4 from the position vector where the homogenous
- * coordinate is 1.
- **/
-Position operator*(Position const& p, Transform const& mx) {
-   return (VectorH(p)*mx) ;
-   }
-
 /** -----------------------------------------------------------
  * Transform a direction vector. (Multiply a row vector
  * times a transform matrix.) We create a temporary
@@ -280,27 +45,6 @@ Direction operator*(Direction const& d, Transform const& mx) {
 
  */
 
-// From Graphics Gems I, p478
-Transform& Transform::translate(Vector3 const& v) {
-   for (int i = 0 ; i < 4 ; i++) {
-       xform[i][0] += xform[i][3] * v.x ;	// 
-       xform[i][1] += xform[i][3] * v.y ;
-       xform[i][2] += xform[i][3] * v.z ;
-       }
-   return *this ;
-   }
-
-// From Graphics Gems I, p478
-Transform& Transform::scale(Vector4 const& s) {
-   Vector3 s1(s.x*s.w, s.y*s.w, s.z*s.w) ;
-   for (int i = 0 ; i < 4 ; i++) {
-      xform[i][0] *= s1.x ;
-      xform[i][1] *= s1.y ;
-      xform[i][2] *= s1.z ;
-      }
-   return *this ;
-   }
-
 // From Graphics Gems I, p478
 Transform& Transform::rotateX(scalar radians) {
 	if (radians == 0.)
@@ -346,57 +90,6 @@ Transform& Transform::rotateZ(scalar radians) {
    return *this ;
    }
 
-/** -----------------------------------------------------------
- *   Set a transform matrix given rotation vectors, scale vector,
- *   and a translation vector.
- *   Use this routine to transform a figure from canonical form
- *   to an arbitrary position and orientation. The canonical figure
- *   is scaled and rotated then translated to the desired position.
- *   The scale multiplies the "size" of the figure (usually unity) to
- *   the desired size (independently in x, y, z, plus a "global" scale).
- *   Rotation turns the axes of the figure away from the world axes.
- *   Translation moves the figure away from the origin.
- *   rx, ry, and rz should be mutually perpendicular else ????
- *   (ref: Foley & Van Dam)
- **/
-Transform& Transform::set(Direction const& rx,
-                          Direction const& ry,
-                          Direction const& rz,
-                          Vector4 const& s,
-                          Position const& t) {
-   scalar a, b, c, d ;
-   Position lastRow ;
-
-   a = s.x ; b = s.y ; c = s.z ;
-
-   // The following is equivalent to (S x R) x T
-   // where each is a sparse 4x4 matrix.
-   xform[0][0] = rx.x * a ;
-   xform[1][0] = rx.y * b ;
-   xform[2][0] = rx.z * c ;
-
-   xform[0][1] = ry.x * a ;
-   xform[1][1] = ry.y * b ;
-   xform[2][1] = ry.z * c ;
-
-   xform[0][2] = rz.x * a ;
-   xform[1][2] = rz.y * b ;
-   xform[2][2] = rz.z * c ;
-
-   d = s.w ;
-   if (d != 0)
-      d = 1/d ;
-
-   xform[3][0] = t.x * d ;
-   xform[3][1] = t.y * d ;
-   xform[3][2] = t.z * d ;
-
-   xform[0][3] = xform[1][3] = xform[2][3] = 0 ;
-   xform[3][3] = d ;
-
-   return *this ;
-   }
-
 /*------------------------------------------------------------
  * Set the elements of transform matrix from an axis of rotation
  * and the sin and cosine of the rotation angle.
@@ -437,7 +130,6 @@ void setElements(Transform& mx, Direction const& axis,
    mx.xform[3][3] = 1 ;
    }
 
-
 /** -----------------------------------------------------------
  * Set a rotation transform matrix from an axis of rotation and
  * an angle of rotation.
@@ -540,64 +232,6 @@ Transform& Transform::setRotateGimbal(Direction const& d1, Direction const& d2)
    return *this ;
    }
 
-/*--------------------------------------------------------
- * Multiply two transform matrices.
- */
-
-Transform Transform::operator*(Transform const& mx) const {
-   Transform mr ;
-   for (int i = 0 ; i < 4 ; i++)
-      for (int j = 0 ; j < 4 ; j++ )
-         mr.xform[i][j] = row(i).dot(mx.col(j)) ;
-   return mr ;
-   }
-
-Transform& Transform::operator*=(Transform const& mx) {
-   *this = *this * mx ;
-   return *this ;
-   }
-
-/*--------------------------------------------------------
- * Add two transform matrices.
- */
-
-Transform Transform::operator+(Transform const& mx) const {
-   Transform mr ;
-   for (int i = 0 ; i < 4 ; i++)
-      for (int j = 0 ; j < 4 ; j++ )
-         mr.xform[i][j] = xform[i][j] + mx.xform[i][j] ;
-   return mr ;
-   }
-
-Transform& Transform::operator+=(Transform const& mx) {
-   *this = *this + mx ;
-   return *this ;
-   }
-
-Transform Transform::operator*(scalar const& s) const {
-   Transform mr ;
-   for (int i = 0 ; i < 4 ; i++)
-      for (int j = 0 ; j < 4 ; j++ )
-         mr.xform[i][j] = s * xform[i][j] ;
-   return mr ;
-   }
-
-Transform& Transform::operator*=(scalar const& s) {
-   *this = *this * s ;
-   return *this ;
-   }
-
-Transform operator*(scalar const& s, Transform const& mx) {
-   return mx * s;
-   }
-
-
-Transform Transform::transpose() const {
-   return (Transform(col(0), col(1), col(2), col(3))) ;
-   }
-
-
-
 /*--------------------------------------------------------
    Matrix Inversion
 
@@ -678,4 +312,3 @@ Transform Transform::inverse() const {
    return inv ;
    }
 
-
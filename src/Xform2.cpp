@@ -0,0 +1,30 @@
+/* -------- Xform2.cpp -----------
+
+   2D Transform Class Library
+   Copyright 1994-2008,2021 Bill Leonard
+
+   The author will not be liable for any bug, error, omission,
+   defect, deficiency, or nonconformity in this software. The author
+   also disclaims all implied warranties, including without limitation
+   warranties of merchantability, performance, and fitness for a
+   particular purpose. This software is provided "as is" and the user
+   assumes the entire risk as to its quality and performance.
+
+*/
+
+#include <Vector.h>
+
+// As Transform::rotateZ(), from Graphics Gems I, p478
+Transform2& Transform2::rotate(scalar radians) {
+	if (radians == 0.)
+		return *this ;
+   const scalar c = cos(radians) ;
+   const scalar s = sin(radians) ;
+   scalar t ;
+   for (int i = 0 ; i < 3 ; i++) {
+	   t = xform[i][0] ;
+	   xform[i][0] = t*c - xform[i][1] * s ;
+	   xform[i][1] = t*s + xform[i][1] * c ;
+	   }
+   return *this ;
+   }